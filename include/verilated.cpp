@@ -26,23 +26,42 @@
 #define _VERILATED_CPP_
 #include "verilated_imp.h"
 #include <cctype>
+#include <algorithm>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# define VL_READMEM_NO_MMAP	///< Read $readmem files with stdio, not mmap()
+#else
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
 
 #define VL_VALUE_STRING_MAX_WIDTH 8192	///< Max static char array for VL_VALUE_STRING
+#ifndef VL_READMEM_CHUNK_BYTES	// Define this to override the default
+# define VL_READMEM_CHUNK_BYTES (4*1024*1024)	///< Min $readmem bytes per parsing thread
+#endif
+#ifndef VL_READMEM_CHUNKS_MAX	// Define this to override the default
+# define VL_READMEM_CHUNKS_MAX sysconf(_SC_NPROCESSORS_ONLN)	///< Max $readmem parsing threads
+#endif
 
 //===========================================================================
 // Global variables
 
 // Slow path variables
 VerilatedVoidCb Verilated::s_flushCb = NULL;
+VerilatedMutex Verilated::s_flushMutex;
+
+// Constructed before, so destroyed after, the default context, whose
+// destructor flushes buffered $display output under s_s.m_displayMutex
+VerilatedImp  VerilatedImp::s_s;
 
 // Keep below together in one cache line
-Verilated::Serialized Verilated::s_s;
+VerilatedContext Verilated::s_defaultContext;
+VL_THREAD VerilatedContext* Verilated::t_contextp = &Verilated::s_defaultContext;
 VL_THREAD const VerilatedScope* Verilated::t_dpiScopep = NULL;
 VL_THREAD const char* Verilated::t_dpiFilename = "";
 VL_THREAD int Verilated::t_dpiLineno = 0;
-struct Verilated::CommandArgValues Verilated::s_args = {0, NULL};
-
-VerilatedImp  VerilatedImp::s_s;
 
 //===========================================================================
 // User definable functions
@@ -50,6 +69,7 @@ VerilatedImp  VerilatedImp::s_s;
 #ifndef VL_USER_FINISH		// Define this to override this function
 void vl_finish (const char* filename, int linenum, const char* hier) {
     if (0 && hier) {}
+    Verilated::displayFlush();
     VL_PRINTF("- %s:%d: Verilog $finish\n", filename, linenum);
     if (Verilated::gotFinish()) {
 	VL_PRINTF("- %s:%d: Second verilog $finish, exiting\n", filename, linenum);
@@ -72,17 +92,63 @@ void vl_stop (const char* filename, int linenum, const char* hier) {
 void vl_fatal (const char* filename, int linenum, const char* hier, const char* msg) {
     if (0 && hier) {}
     Verilated::gotFinish(true);
+    Verilated::displayFlush();
     VL_PRINTF("%%Error: %s:%d: %s\n", filename, linenum, msg);
     Verilated::flushCall();
     abort();
 }
 #endif
 
+//===========================================================================
+// Random generator -- xoshiro256**, state held in each VerilatedContext
+
+static void vl_rand_seed(vluint64_t* statep, vluint64_t seed) {
+    // Expand the seed with splitmix64, which never produces an all-zero state
+    for (int i=0; i<4; ++i) {
+	seed += VL_ULL(0x9e3779b97f4a7c15);
+	vluint64_t z = seed;
+	z = (z ^ (z >> 30)) * VL_ULL(0xbf58476d1ce4e5b9);
+	z = (z ^ (z >> 27)) * VL_ULL(0x94d049bb133111eb);
+	statep[i] = z ^ (z >> 31);
+    }
+}
+
+static inline vluint64_t vl_rotl64(vluint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline vluint64_t vl_rand64(vluint64_t* statep) {
+    vluint64_t result = vl_rotl64(statep[1] * 5, 7) * 9;
+    vluint64_t t = statep[1] << 17;
+    statep[2] ^= statep[0];
+    statep[3] ^= statep[1];
+    statep[1] ^= statep[2];
+    statep[0] ^= statep[3];
+    statep[2] ^= t;
+    statep[3] = vl_rotl64(statep[3], 45);
+    return result;
+}
+
+static void vl_rand_fill(IData* outp, size_t words) {
+    // Two words per draw, with the generator state kept in registers
+    vluint64_t* statep = Verilated::randStatep();
+    vluint64_t s[4] = { statep[0], statep[1], statep[2], statep[3] };
+    size_t i=0;
+    for (; i+1<words; i+=2) {
+	vluint64_t r = vl_rand64(s);
+	outp[i] = (IData)r;
+	outp[i+1] = (IData)(r >> VL_ULL(32));
+    }
+    if (i<words) outp[i] = (IData)(vl_rand64(s) >> VL_ULL(32));
+    statep[0] = s[0]; statep[1] = s[1]; statep[2] = s[2]; statep[3] = s[3];
+}
+
 //===========================================================================
 // Overall class init
 
-Verilated::Serialized::Serialized() {
+VerilatedContext::Serialized::Serialized() {
     s_randReset = 0;
+    vl_rand_seed(s_randState, 0);
     s_debug = 0;
     s_calcUnusedSigs = false;
     s_gotFinish = false;
@@ -90,16 +156,33 @@ Verilated::Serialized::Serialized() {
     s_fatalOnVpiError = true; // retains old default behaviour
 }
 
+//===========================================================================
+// VerilatedContext:: Methods
+
+VerilatedContext::VerilatedContext()
+    : m_time(0), m_impp(NULL), m_vpip(NULL), m_threadUses(0), m_displayBufferSize(64*1024)
+    , m_displayBuffering(VL_DISPLAY_BUFFERING), m_displayEvalPending(false) {
+}
+
+VerilatedContext::~VerilatedContext() {
+    VerilatedImp::displayFlush(this);
+    if (Verilated::threadContextp() == this) Verilated::threadContextp(NULL);
+    VerilatedImp::contextDestroy(this);
+    if (m_vpip) { delete m_vpip; m_vpip=NULL; }
+    if (m_impp) { delete m_impp; m_impp=NULL; }
+}
+
+void Verilated::threadContextSwitch(VerilatedContext* contextp) {
+    // Count the threads using each context, so ~VerilatedContext can check none still are
+    VerilatedImp::threadContextUse(t_contextp, contextp);
+    t_contextp = contextp;
+}
+
 //===========================================================================
 // Random reset -- Only called at init time, so don't inline.
 
 IData VL_RAND32() {
-#if defined(_WIN32) && !defined(__CYGWIN__)
-    // Windows doesn't have lrand48(), although Cygwin does.
-    return (rand()<<16) ^ rand();
-#else
-    return (lrand48()<<16) ^ lrand48();
-#endif
+    return (IData)(vl_rand64(Verilated::randStatep()) >> VL_ULL(32));
 }
 
 IData VL_RANDOM_I(int obits) {
@@ -107,18 +190,12 @@ IData VL_RANDOM_I(int obits) {
 }
 
 QData VL_RANDOM_Q(int obits) {
-    QData data = ((QData)VL_RAND32()<<VL_ULL(32)) | (QData)VL_RAND32();
-    return data & VL_MASK_Q(obits);
+    return vl_rand64(Verilated::randStatep()) & VL_MASK_Q(obits);
 }
 
 WDataOutP VL_RANDOM_W(int obits, WDataOutP outwp) {
-    for (int i=0; i<VL_WORDS_I(obits); i++) {
-	if (i<(VL_WORDS_I(obits)-1)) {
-	    outwp[i] = VL_RAND32();
-	} else {
-	    outwp[i] = VL_RAND32() & VL_MASK_I(obits);
-	}
-    }
+    vl_rand_fill(outwp, VL_WORDS_I(obits));
+    outwp[VL_WORDS_I(obits)-1] &= VL_MASK_I(obits);
     return outwp;
 }
 
@@ -143,13 +220,16 @@ QData VL_RAND_RESET_Q(int obits) {
 }
 
 WDataOutP VL_RAND_RESET_W(int obits, WDataOutP outwp) {
-    for (int i=0; i<VL_WORDS_I(obits); i++) {
-	if (i<(VL_WORDS_I(obits)-1)) {
-	    outwp[i] = VL_RAND_RESET_I(32);
-	} else {
-	    outwp[i] = VL_RAND_RESET_I(32) & VL_MASK_I(obits);
-	}
+    int words = VL_WORDS_I(obits);
+    int mode = Verilated::randReset();
+    if (mode==0) {
+	for (int i=0; i<words; i++) outwp[i] = 0;
+    } else if (mode==1) {
+	for (int i=0; i<words; i++) outwp[i] = ~0;
+    } else {
+	vl_rand_fill(outwp, words);
     }
+    outwp[words-1] &= VL_MASK_I(obits);
     return outwp;
 }
 
@@ -158,6 +238,80 @@ WDataOutP VL_ZERO_RESET_W(int obits, WDataOutP outwp) {
     return outwp;
 }
 
+// Array resets look at randReset once, rather than once per entry;
+// the all-zeros and all-ones cases become simple fills.
+template <class T> static void _vl_rand_reset_array(int obits, T* outp, size_t entries) {
+    int mode = Verilated::randReset();
+    if (mode==0) {
+	memset(outp, 0, entries*sizeof(T));
+    } else if (mode==1) {
+	T ones = (T)VL_MASK_Q(obits);
+	for (size_t i=0; i<entries; ++i) outp[i] = ones;
+    } else {
+	vluint64_t* statep = Verilated::randStatep();
+	vluint64_t s[4] = { statep[0], statep[1], statep[2], statep[3] };
+	T mask = (T)VL_MASK_Q(obits);
+	for (size_t i=0; i<entries; ++i) outp[i] = (T)vl_rand64(s) & mask;
+	statep[0] = s[0]; statep[1] = s[1]; statep[2] = s[2]; statep[3] = s[3];
+    }
+}
+
+void VL_RAND_RESET_ARRAY(int obits, CData* outp, size_t entries) {
+    _vl_rand_reset_array(obits, outp, entries);
+}
+void VL_RAND_RESET_ARRAY(int obits, SData* outp, size_t entries) {
+    _vl_rand_reset_array(obits, outp, entries);
+}
+void VL_RAND_RESET_ARRAY(int obits, IData* outp, size_t entries) {
+    _vl_rand_reset_array(obits, outp, entries);
+}
+void VL_RAND_RESET_ARRAY(int obits, QData* outp, size_t entries) {
+    _vl_rand_reset_array(obits, outp, entries);
+}
+
+template <class T> static void _vl_rand_reset_run(int obits, T* const* outpp, size_t count) {
+    int mode = Verilated::randReset();
+    if (mode==0) {
+	for (size_t i=0; i<count; ++i) *(outpp[i]) = 0;
+    } else if (mode==1) {
+	T ones = (T)VL_MASK_Q(obits);
+	for (size_t i=0; i<count; ++i) *(outpp[i]) = ones;
+    } else if (obits>32) {
+	for (size_t i=0; i<count; ++i) *(outpp[i]) = (T)VL_RANDOM_Q(obits);
+    } else {
+	for (size_t i=0; i<count; ++i) *(outpp[i]) = (T)VL_RANDOM_I(obits);
+    }
+}
+
+void VL_RAND_RESET_RUN(int obits, CData* const* outpp, size_t count) {
+    _vl_rand_reset_run(obits, outpp, count);
+}
+void VL_RAND_RESET_RUN(int obits, SData* const* outpp, size_t count) {
+    _vl_rand_reset_run(obits, outpp, count);
+}
+void VL_RAND_RESET_RUN(int obits, IData* const* outpp, size_t count) {
+    _vl_rand_reset_run(obits, outpp, count);
+}
+void VL_RAND_RESET_RUN(int obits, QData* const* outpp, size_t count) {
+    _vl_rand_reset_run(obits, outpp, count);
+}
+
+void VL_RAND_RESET_ARRAY_W(int obits, WDataOutP outwp, size_t entries) {
+    int words = VL_WORDS_I(obits);
+    int mode = Verilated::randReset();
+    if (mode==0) {
+	memset(outwp, 0, entries*words*sizeof(WData));
+    } else {
+	if (mode==1) {
+	    for (size_t i=0; i<entries*words; ++i) outwp[i] = ~0;
+	} else {
+	    vl_rand_fill(outwp, entries*words);
+	}
+	IData mask = VL_MASK_I(obits);
+	for (size_t i=0; i<entries; ++i) outwp[i*words + words-1] &= mask;
+    }
+}
+
 //===========================================================================
 // Debug
 
@@ -284,6 +438,98 @@ WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp, boo
 // Do a va_arg returning a quad, assuming input argument is anything less than wide
 #define _VL_VA_ARG_Q(ap, bits) (((bits) <= VL_WORDSIZE) ? va_arg(ap,IData) : va_arg(ap,QData))
 
+static void _vl_vsformat_value(string& output, char fmt, bool widthSet, int width, bool zeroPad,
+			       int lbits, QData ld, WDataInP lwp) {
+    // Format one integral value; shared by string and precompiled formats
+    static VL_THREAD char tmp[VL_VALUE_STRING_MAX_WIDTH];
+    int lsb=lbits-1;
+    if (widthSet && width==0) while (lsb && !VL_BITISSET_W(lwp,lsb)) lsb--;
+    switch (fmt) {
+    case 'c': {
+	IData charval = ld & 0xff;
+	output += charval;
+	break;
+    }
+    case 's':
+	for (; lsb>=0; lsb--) {
+	    lsb = (lsb / 8) * 8; // Next digit
+	    IData charval = (lwp[VL_BITWORD_I(lsb)]>>VL_BITBIT_I(lsb)) & 0xff;
+	    output += (charval==0)?' ':charval;
+	}
+	break;
+    case 'd': { // Signed decimal
+	int digits=sprintf(tmp,"%" VL_PRI64 "d",(vlsint64_t)(VL_EXTENDS_QQ(lbits,lbits,ld)));
+	int needmore = width-digits;
+	if (needmore>0) {
+	    if (zeroPad) { //%0
+		output.append(needmore,'0'); // Pre-pad zero
+	    } else {
+		output.append(needmore,' '); // Pre-pad spaces
+	    }
+	}
+	output += tmp;
+	break;
+    }
+    case 'u': { // Unsigned decimal
+	int digits=sprintf(tmp,"%" VL_PRI64 "u",ld);
+	int needmore = width-digits;
+	if (needmore>0) {
+	    if (zeroPad) { //%0
+		output.append(needmore,'0'); // Pre-pad zero
+	    } else {
+		output.append(needmore,' '); // Pre-pad spaces
+	    }
+	}
+	output += tmp;
+	break;
+    }
+    case 't': { // Time
+	int digits;
+	if (VL_TIME_MULTIPLIER==1) {
+	    digits=sprintf(tmp,"%" VL_PRI64 "u",ld);
+	} else if (VL_TIME_MULTIPLIER==1000) {
+	    digits=sprintf(tmp,"%" VL_PRI64 "u.%03" VL_PRI64 "u",
+			   (QData)(ld/VL_TIME_MULTIPLIER),
+			   (QData)(ld%VL_TIME_MULTIPLIER));
+	} else {
+	    vl_fatal(__FILE__,__LINE__,"","Unsupported VL_TIME_MULTIPLIER");
+	}
+	int needmore = width-digits;
+	if (needmore>0) output.append(needmore,' '); // Pre-pad spaces
+	output += tmp;
+	break;
+    }
+    case 'b':
+	for (; lsb>=0; lsb--) {
+	    output += ((lwp[VL_BITWORD_I(lsb)]>>VL_BITBIT_I(lsb)) & 1) + '0';
+	}
+	break;
+    case 'o':
+	for (; lsb>=0; lsb--) {
+	    lsb = (lsb / 3) * 3; // Next digit
+	    // Octal numbers may span more than one wide word,
+	    // so we need to grab each bit separately and check for overrun
+	    // Octal is rare, so we'll do it a slow simple way
+	    output += ('0'
+		       + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+0)) ? 1 : 0)
+		       + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+1)) ? 2 : 0)
+		       + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+2)) ? 4 : 0));
+	}
+	break;
+    case 'x':
+	for (; lsb>=0; lsb--) {
+	    lsb = (lsb / 4) * 4; // Next digit
+	    IData charval = (lwp[VL_BITWORD_I(lsb)]>>VL_BITBIT_I(lsb)) & 0xf;
+	    output += "0123456789abcdef"[charval];
+	}
+	break;
+    default:
+	string msg = string("Unknown _vl_vsformat code: ")+fmt;
+	vl_fatal(__FILE__,__LINE__,"",msg.c_str());
+	break;
+    } // switch
+}
+
 void _vl_vsformat(string& output, const char* formatp, va_list ap) {
     // Format a Verilog $write style format into the output list
     // The format must be pre-processed (and lower cased) by Verilator
@@ -366,98 +612,66 @@ void _vl_vsformat(string& output, const char* formatp, va_list ap) {
 		    ld = lwp[0];
 		    if (fmt == 'u' || fmt == 'd') fmt = 'x';  // Not supported, but show something
 		}
-		int lsb=lbits-1;
-		if (widthSet && width==0) while (lsb && !VL_BITISSET_W(lwp,lsb)) lsb--;
-		switch (fmt) {
-		case 'c': {
-		    IData charval = ld & 0xff;
-		    output += charval;
-		    break;
-		}
-		case 's':
-		    for (; lsb>=0; lsb--) {
-			lsb = (lsb / 8) * 8; // Next digit
-			IData charval = (lwp[VL_BITWORD_I(lsb)]>>VL_BITBIT_I(lsb)) & 0xff;
-			output += (charval==0)?' ':charval;
-		    }
-		    break;
-		case 'd': { // Signed decimal
-		    int digits=sprintf(tmp,"%" VL_PRI64 "d",(vlsint64_t)(VL_EXTENDS_QQ(lbits,lbits,ld)));
-		    int needmore = width-digits;
-		    if (needmore>0) {
-			if (pctp && pctp[0] && pctp[1]=='0') { //%0
-			    output.append(needmore,'0'); // Pre-pad zero
-			} else {
-			    output.append(needmore,' '); // Pre-pad spaces
-			}
-		    }
-		    output += tmp;
-		    break;
-		}
-		case 'u': { // Unsigned decimal
-		    int digits=sprintf(tmp,"%" VL_PRI64 "u",ld);
-		    int needmore = width-digits;
-		    if (needmore>0) {
-			if (pctp && pctp[0] && pctp[1]=='0') { //%0
-			    output.append(needmore,'0'); // Pre-pad zero
-			} else {
-			    output.append(needmore,' '); // Pre-pad spaces
-			}
-		    }
-		    output += tmp;
-		    break;
-		}
-		case 't': { // Time
-		    int digits;
-		    if (VL_TIME_MULTIPLIER==1) {
-			digits=sprintf(tmp,"%" VL_PRI64 "u",ld);
-		    } else if (VL_TIME_MULTIPLIER==1000) {
-			digits=sprintf(tmp,"%" VL_PRI64 "u.%03" VL_PRI64 "u",
-				       (QData)(ld/VL_TIME_MULTIPLIER),
-				       (QData)(ld%VL_TIME_MULTIPLIER));
-		    } else {
-			vl_fatal(__FILE__,__LINE__,"","Unsupported VL_TIME_MULTIPLIER");
-		    }
-		    int needmore = width-digits;
-		    if (needmore>0) output.append(needmore,' '); // Pre-pad spaces
-		    output += tmp;
-		    break;
-		}
-		case 'b':
-		    for (; lsb>=0; lsb--) {
-			output += ((lwp[VL_BITWORD_I(lsb)]>>VL_BITBIT_I(lsb)) & 1) + '0';
-		    }
-		    break;
-		case 'o':
-		    for (; lsb>=0; lsb--) {
-			lsb = (lsb / 3) * 3; // Next digit
-			// Octal numbers may span more than one wide word,
-			// so we need to grab each bit separately and check for overrun
-			// Octal is rare, so we'll do it a slow simple way
-			output += ('0'
-				   + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+0)) ? 1 : 0)
-				   + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+1)) ? 2 : 0)
-				   + ((VL_BITISSETLIMIT_W(lwp, lbits, lsb+2)) ? 4 : 0));
-		    }
-		    break;
-		case 'x':
-		    for (; lsb>=0; lsb--) {
-			lsb = (lsb / 4) * 4; // Next digit
-			IData charval = (lwp[VL_BITWORD_I(lsb)]>>VL_BITBIT_I(lsb)) & 0xf;
-			output += "0123456789abcdef"[charval];
-		    }
-		    break;
-		default:
-		    string msg = string("Unknown _vl_vsformat code: ")+pos[0];
-		    vl_fatal(__FILE__,__LINE__,"",msg.c_str());
-		    break;
-		} // switch
+		_vl_vsformat_value(output, fmt, widthSet, width,
+				   (pctp && pctp[0] && pctp[1]=='0'), lbits, ld, lwp);
 	    }
 	    } // switch
 	}
     }
 }
 
+static void _vl_vsformat_ops(string& output, const VerilatedFormatOp* opsp, va_list ap) {
+    // Format a $write style format precompiled by Verilator into operations
+    // Arguments are as with _vl_vsformat, but no parsing of the format is needed
+    static VL_THREAD char tmp[VL_VALUE_STRING_MAX_WIDTH];
+    for (const VerilatedFormatOp* opp = opsp; ; ++opp) {
+	if (opp->m_textLen) output.append(opp->m_textp, opp->m_textLen);
+	char fmt = opp->m_fmt;
+	switch (fmt) {
+	case '\0':
+	    return;
+	case 'N': { // "C" string with name of module, add . if needed
+	    const char* cstrp = va_arg(ap, const char*);
+	    if (VL_LIKELY(*cstrp)) { output += cstrp; output += '.'; }
+	    break;
+	}
+	case 'S': { // "C" string
+	    const char* cstrp = va_arg(ap, const char*);
+	    output += cstrp;
+	    break;
+	}
+	case 'e':
+	case 'f':
+	case 'g': {
+	    const int lbits = va_arg(ap, int);
+	    double d = va_arg(ap, double);
+	    if (lbits) {}  // UNUSED - always 64
+	    sprintf(tmp, opp->m_cfmtp, d);
+	    output += tmp;
+	    break;
+	}
+	default: {
+	    const int lbits = va_arg(ap, int);
+	    QData ld = 0;
+	    WData qlwp[2];
+	    WDataInP lwp;
+	    if (lbits <= VL_QUADSIZE) {
+		ld = _VL_VA_ARG_Q(ap, lbits);
+		VL_SET_WQ(qlwp,ld);
+		lwp = qlwp;
+	    } else {
+		lwp = va_arg(ap,WDataInP);
+		ld = lwp[0];
+		if (fmt == 'u' || fmt == 'd') fmt = 'x';  // Not supported, but show something
+	    }
+	    _vl_vsformat_value(output, fmt, opp->m_width>=0, opp->m_width>=0 ? opp->m_width : 0,
+			       opp->m_zeroPad, lbits, ld, lwp);
+	    break;
+	}
+	} // switch
+    }
+}
+
 static inline bool _vl_vsss_eof(FILE* fp, int& floc) {
     if (fp) return feof(fp) ? 1 : 0;  // 1:0 to prevent MSVC++ warning
     else return (floc<0);
@@ -778,6 +992,26 @@ void VL_SFORMAT_X(int obits_ignored, string &output, const char* formatp, ...) {
     va_end(ap);
 }
 
+void VL_SFORMAT_X(int obits, void* destp, const VerilatedFormatOp* opsp, ...) {
+    VL_STATIC_OR_THREAD string output;  // static only for speed
+    output = "";
+    va_list ap;
+    va_start(ap,opsp);
+    _vl_vsformat_ops(output, opsp, ap);
+    va_end(ap);
+
+    _VL_STRING_TO_VINT(obits, destp, (int)output.length(), output.c_str());
+}
+
+void VL_SFORMAT_X(int obits_ignored, string &output, const VerilatedFormatOp* opsp, ...) {
+    if (obits_ignored) {}
+    output = "";
+    va_list ap;
+    va_start(ap,opsp);
+    _vl_vsformat_ops(output, opsp, ap);
+    va_end(ap);
+}
+
 string VL_SFORMATF_NX(const char* formatp, ...) {
     VL_STATIC_OR_THREAD string output;  // static only for speed
     output = "";
@@ -789,11 +1023,69 @@ string VL_SFORMATF_NX(const char* formatp, ...) {
     return output;
 }
 
+void VerilatedImp::displayWrite(string& bufr, size_t len) {
+    // Write the leading len bytes as one chunk
+    if (!len) return;
+    {
+	VerilatedLockGuard guard (s_s.m_displayMutex);
+	// Not VL_PRINTF, as "%.*s" would stop at a $write of a NUL
+	fwrite(bufr.data(), 1, len, stdout);
+    }
+    bufr.erase(0, len);
+}
+
+void VerilatedImp::displayFormat(const char* formatp, va_list ap) {
+    // Format directly onto the end of the context's buffer
+    string& bufr = contextImp()->m_displayBuf;
+    _vl_vsformat(bufr, formatp, ap);
+    displayAppended(bufr);
+}
+
+void VerilatedImp::displayFormat(const VerilatedFormatOp* opsp, va_list ap) {
+    string& bufr = contextImp()->m_displayBuf;
+    _vl_vsformat_ops(bufr, opsp, ap);
+    displayAppended(bufr);
+}
+
+void VerilatedImp::displayAppended(string& bufr) {
+    // Write out whatever the buffering policy no longer holds
+    VerilatedContext* contextp = Verilated::threadContextp();
+    switch (contextp->m_displayBuffering) {
+    case VL_DISPLAY_EVAL:
+	contextp->m_displayEvalPending = true;
+	if (VL_LIKELY(bufr.length() < contextp->m_displayBufferSize)) break;
+	// Otherwise a long eval would grow the buffer without bound
+	// FALLTHRU
+    case VL_DISPLAY_SIZE:
+	if (VL_LIKELY(bufr.length() < contextp->m_displayBufferSize)) break;
+	// FALLTHRU
+    default: {  // VL_DISPLAY_LINE
+	size_t pos = bufr.rfind('\n');
+	if (pos != string::npos) displayWrite(bufr, pos+1);
+	break;
+    }
+    }
+}
+
+void VerilatedImp::displayFlush(VerilatedContext* contextp) {
+    contextp->m_displayEvalPending = false;
+    if (contextp->m_impp) displayWrite(contextp->m_impp->m_displayBuf, contextp->m_impp->m_displayBuf.length());
+}
+
+void Verilated::displayFlush() {
+    VerilatedImp::displayFlush(t_contextp);
+}
+
 void VL_WRITEF(const char* formatp, ...) {
-    VL_STATIC_OR_THREAD string output;  // static only for speed
-    output = "";
     va_list ap;
     va_start(ap,formatp);
+    if (VL_UNLIKELY(VerilatedImp::displayBuffered())) {
+	VerilatedImp::displayFormat(formatp, ap);
+	va_end(ap);
+	return;
+    }
+    VL_STATIC_OR_THREAD string output;  // static only for speed
+    output = "";
     _vl_vsformat(output, formatp, ap);
     va_end(ap);
 
@@ -809,12 +1101,55 @@ void VL_FWRITEF(IData fpi, const char* formatp, ...) {
 
     va_list ap;
     va_start(ap,formatp);
+    if (VL_UNLIKELY(fp == stdout && VerilatedImp::displayBuffered())) {
+	// Keep in order with $display
+	VerilatedImp::displayFormat(formatp, ap);
+	va_end(ap);
+	return;
+    }
     _vl_vsformat(output, formatp, ap);
     va_end(ap);
 
     fputs(output.c_str(), fp);
 }
 
+void VL_WRITEF(const VerilatedFormatOp* opsp, ...) {
+    va_list ap;
+    va_start(ap,opsp);
+    if (VL_UNLIKELY(VerilatedImp::displayBuffered())) {
+	VerilatedImp::displayFormat(opsp, ap);
+	va_end(ap);
+	return;
+    }
+    VL_STATIC_OR_THREAD string output;  // static only for speed
+    output = "";
+    _vl_vsformat_ops(output, opsp, ap);
+    va_end(ap);
+
+    // Users can redefine VL_PRINTF if they wish.
+    VL_PRINTF("%s", output.c_str());
+}
+
+void VL_FWRITEF(IData fpi, const VerilatedFormatOp* opsp, ...) {
+    VL_STATIC_OR_THREAD string output;  // static only for speed
+    output = "";
+    FILE* fp = VL_CVT_I_FP(fpi);
+    if (VL_UNLIKELY(!fp)) return;
+
+    va_list ap;
+    va_start(ap,opsp);
+    if (VL_UNLIKELY(fp == stdout && VerilatedImp::displayBuffered())) {
+	// Keep in order with $display
+	VerilatedImp::displayFormat(opsp, ap);
+	va_end(ap);
+	return;
+    }
+    _vl_vsformat_ops(output, opsp, ap);
+    va_end(ap);
+
+    fputs(output.c_str(), fp);
+}
+
 IData VL_FSCANF_IX(IData fpi, const char* formatp, ...) {
     FILE* fp = VL_CVT_I_FP(fpi);
     if (VL_UNLIKELY(!fp)) return 0;
@@ -853,107 +1188,294 @@ IData VL_SSCANF_IWX(int lbits, WDataInP lwp, const char* formatp, ...) {
 }
 
 void VL_READMEM_Q(bool hex, int width, int depth, int array_lsb, int,
-		  QData ofilename, void* memp, IData start, IData end) {
+		  QData ofilename, void* memp, IData start, IData end,
+		  VerilatedEntryCb entrycb) {
     IData fnw[2];  VL_SET_WQ(fnw, ofilename);
-    return VL_READMEM_W(hex,width,depth,array_lsb,2, fnw,memp,start,end);
-}
-
-void VL_READMEM_W(bool hex, int width, int depth, int array_lsb, int fnwords,
-		  WDataInP ofilenamep, void* memp, IData start, IData end) {
-    char ofilenamez[VL_TO_STRING_MAX_WORDS*VL_WORDSIZE+1];
-    _VL_VINT_TO_STRING(fnwords*VL_WORDSIZE, ofilenamez, ofilenamep);
-    FILE* fp = fopen(ofilenamez, "r");
-    if (VL_UNLIKELY(!fp)) {
-	// We don't report the Verilog source filename as it slow to have to pass it down
-	vl_fatal (ofilenamez, 0, "", "$readmem file not found");
-	return;
+    return VL_READMEM_W(hex,width,depth,array_lsb,2, fnw,memp,start,end,entrycb);
+}
+
+// Value of each hex digit character, else -1
+#define VL_HEX_NONE16_ -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1
+static const signed char vl_readmem_hexval[256] = {
+    VL_HEX_NONE16_, VL_HEX_NONE16_, VL_HEX_NONE16_,
+    0,1,2,3,4,5,6,7,8,9,-1,-1,-1,-1,-1,-1,
+    -1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1, VL_HEX_NONE16_,
+    -1,10,11,12,13,14,15,-1,-1,-1,-1,-1,-1,-1,-1,-1, VL_HEX_NONE16_,
+    VL_HEX_NONE16_, VL_HEX_NONE16_, VL_HEX_NONE16_, VL_HEX_NONE16_,
+    VL_HEX_NONE16_, VL_HEX_NONE16_, VL_HEX_NONE16_, VL_HEX_NONE16_
+};
+#undef VL_HEX_NONE16_
+
+class VlReadMem {
+    // Parser for the text of a $readmem file, or a range of it starting a line
+    // MEMBERS
+    bool	m_hex;		// Hex, else binary
+    int		m_width;	// Width of each entry
+    int		m_depth;	// Number of entries
+    int		m_array_lsb;	// Address of first entry
+    void*	m_memp;		// Memory to load, or NULL to only count entries
+    VerilatedEntryCb m_entrycb;	// Finds entries of m_memp, or NULL if a C array
+    const char*	m_bp;		// Text to parse
+    const char*	m_ep;		// End of text to parse
+public:
+    IData	m_addr;		// Address of next entry
+    int		m_linenum;	// Line number
+    bool	m_sawAddr;	// Saw an @address, so m_addr no longer depends on starting m_addr
+    QData	m_relEnd;	// Entries before any @address are from starting m_addr to this plus it
+    bool	m_absAny;	// Saw an entry after an @address
+    IData	m_absLo;	// Lowest address of an entry after an @address
+    IData	m_absHi;	// Highest address of an entry after an @address
+    bool	m_sawCmt;	// Saw a /* comment, which may continue into following text
+    bool	m_addrPending;	// Ended after an @ without its address
+    const char*	m_errorp;	// First error message, or NULL
+    int		m_errorLine;	// Line number of m_errorp
+    // CONSTRUCTORS
+    VlReadMem(bool hex, int width, int depth, int array_lsb, void* memp, VerilatedEntryCb entrycb,
+	      const char* bp, const char* ep, IData addr, int linenum)
+	: m_hex(hex), m_width(width), m_depth(depth), m_array_lsb(array_lsb)
+	, m_memp(memp), m_entrycb(entrycb)
+	, m_bp(bp), m_ep(ep), m_addr(addr), m_linenum(linenum)
+	, m_sawAddr(false), m_relEnd(0), m_absAny(false), m_absLo(0), m_absHi(0)
+	, m_sawCmt(false), m_addrPending(false)
+	, m_errorp(NULL), m_errorLine(0) {}
+    // METHODS
+    static void* parseThread(void* selfp) { ((VlReadMem*)selfp)->parse(); return NULL; }
+private:
+    void error(const char* msgp) {
+	if (!m_errorp) { m_errorp = msgp; m_errorLine = m_linenum; }
     }
-    // Prep for reading
-    IData addr = start;
-    int linenum = 1;
-    bool innum = false;
-    bool ignore_to_eol = false;
-    bool ignore_to_cmt = false;
-    bool needinc = false;
-    bool reading_addr = false;
-    int lastc = ' ';
-    // Read the data
-    // We process a character at a time, as then we don't need to deal
-    // with changing buffer sizes dynamically, etc.
-    while (1) {
-	int c = fgetc(fp);
-	if (VL_UNLIKELY(c==EOF)) break;
-	//printf("%d: Got '%c' Addr%x IN%d IgE%d IgC%d ninc%d\n", linenum, c, addr, innum, ignore_to_eol, ignore_to_cmt, needinc);
-	if (c=='\n') { linenum++; ignore_to_eol=false; if (innum) reading_addr=false; innum=false; }
-	else if (c=='\t' || c==' ' || c=='\r' || c=='\f') { if (innum) reading_addr=false; innum=false; }
-	// Skip // comments and detect /* comments
-	else if (ignore_to_cmt && lastc=='*' && c=='/') {
-	    ignore_to_cmt = false; if (innum) reading_addr=false; innum=false;
-	} else if (!ignore_to_eol && !ignore_to_cmt) {
-	    if (lastc=='/' && c=='*') { ignore_to_cmt = true; }
-	    else if (lastc=='/' && c=='/') { ignore_to_eol = true; }
-	    else if (c=='/') {}  // Part of /* or //
-	    else if (c=='_') {}
-	    else if (c=='@') { reading_addr = true; innum=false; needinc=false; }
-	    // Check for hex or binary digits as file format requests
-	    else if (isxdigit(c)) {
-		c = tolower(c);
-		int value = (c >= 'a' ? (c-'a'+10) : (c-'0'));
+    void store(int entry, QData value) {
+	// Narrow entries are built up in a local, then stored once
+	if (VL_UNLIKELY(m_entrycb)) {
+	    void* datap = m_entrycb(m_memp, entry);
+	    if (m_width<=8) *(CData*)(datap) = value & VL_MASK_I(m_width);
+	    else if (m_width<=16) *(SData*)(datap) = value & VL_MASK_I(m_width);
+	    else if (m_width<=VL_WORDSIZE) *(IData*)(datap) = value & VL_MASK_I(m_width);
+	    else *(QData*)(datap) = value & VL_MASK_Q(m_width);
+	}
+	else if (m_width<=8) ((CData*)(m_memp))[entry] = value & VL_MASK_I(m_width);
+	else if (m_width<=16) ((SData*)(m_memp))[entry] = value & VL_MASK_I(m_width);
+	else if (m_width<=VL_WORDSIZE) ((IData*)(m_memp))[entry] = value & VL_MASK_I(m_width);
+	else ((QData*)(m_memp))[entry] = value & VL_MASK_Q(m_width);
+    }
+public:
+    void parse() {
+	IData addr = m_addr;
+	bool innum = false;
+	bool ignore_to_eol = false;
+	bool ignore_to_cmt = false;
+	bool needinc = false;
+	bool reading_addr = false;
+	int lastc = ' ';
+	const int shift = m_hex ? 4 : 1;
+	const bool wide = m_width > VL_QUADSIZE;
+	int entry = -1;  // Narrow entry being built in value, or -1
+	QData value = 0;
+	WDataOutP wdatap = NULL;  // Wide entry being built
+	bool skip = true;  // Not storing the current entry
+	const char* cp = m_bp;
+	while (cp < m_ep && VL_LIKELY(!m_errorp)) {  // Stop at the first error
+	    int c = (unsigned char)(*cp++);
+	    int digit = vl_readmem_hexval[c];
+	    if (digit>=0 && !ignore_to_eol && !ignore_to_cmt) {
 		if (!innum) {  // Prep for next number
 		    if (needinc) { addr++; needinc=false; }
 		}
 		if (reading_addr) {
 		    // Decode @ addresses
 		    if (!innum) addr=0;
-		    addr = (addr<<4) + value;
+		    addr = (addr<<4) + digit;
 		} else {
 		    needinc = true;
-		    //printf(" Value width=%d  @%x = %c\n", width, addr, c);
-		    if (VL_UNLIKELY(addr >= (IData)(depth+array_lsb) || addr < (IData)(array_lsb))) {
-			vl_fatal (ofilenamez, linenum, "", "$readmem file address beyond bounds of array");
-		    } else {
-			int entry = addr - array_lsb;
-			QData shift = hex ? VL_ULL(4) : VL_ULL(1);
-			// Shift value in
-			if (width<=8) {
-			    CData* datap = &((CData*)(memp))[entry];
-			    if (!innum) { *datap = 0; }
-			    *datap = ((*datap << shift) + value) & VL_MASK_I(width);
-			} else if (width<=16) {
-			    SData* datap = &((SData*)(memp))[entry];
-			    if (!innum) { *datap = 0; }
-			    *datap = ((*datap << shift) + value) & VL_MASK_I(width);
-			} else if (width<=VL_WORDSIZE) {
-			    IData* datap = &((IData*)(memp))[entry];
-			    if (!innum) { *datap = 0; }
-			    *datap = ((*datap << shift) + value) & VL_MASK_I(width);
-			} else if (width<=VL_QUADSIZE) {
-			    QData* datap = &((QData*)(memp))[entry];
-			    if (!innum) { *datap = 0; }
-			    *datap = ((*datap << (QData)(shift)) + (QData)(value)) & VL_MASK_Q(width);
+		    if (!innum) {
+			if (entry>=0) { store(entry, value); entry=-1; }
+			// Addresses written, so loads of each range can check they don't overlap
+			if (!m_sawAddr) m_relEnd = (QData)addr+1;
+			else if (!m_absAny) { m_absAny = true; m_absLo = m_absHi = addr; }
+			else if (addr < m_absLo) m_absLo = addr;
+			else if (addr > m_absHi) m_absHi = addr;
+			wdatap = NULL;
+			skip = !m_memp;  // Only counting
+			if (skip) {
+			} else if (VL_UNLIKELY(addr >= (IData)(m_depth+m_array_lsb)
+					       || addr < (IData)(m_array_lsb))) {
+			    error("$readmem file address beyond bounds of array");
+			    skip = true;
+			} else if (wide) {
+			    if (m_entrycb) wdatap = (WDataOutP)(m_entrycb(m_memp, addr-m_array_lsb));
+			    else wdatap = &((WDataOutP)(m_memp))[ (addr-m_array_lsb)*VL_WORDS_I(m_width) ];
+			    VL_ZERO_RESET_W(m_width, wdatap);
+			} else {
+			    entry = addr - m_array_lsb;
+			    value = 0;
+			}
+		    }
+		    // Shift in this digit and any directly following
+		    while (1) {
+			if (skip) {
+			} else if (wide) {
+			    _VL_SHIFTL_INPLACE_W(m_width, wdatap, (IData)shift);
+			    wdatap[0] |= digit;
 			} else {
-			    WDataOutP datap = &((WDataOutP)(memp))[ entry*VL_WORDS_I(width) ];
-			    if (!innum) { VL_ZERO_RESET_W(width, datap); }
-			    _VL_SHIFTL_INPLACE_W(width, datap, (IData)shift);
-			    datap[0] |= value;
+			    value = (value << shift) + digit;
 			}
-			if (VL_UNLIKELY(value>=(1<<shift))) {
-			    vl_fatal (ofilenamez, linenum, "", "$readmemb (binary) file contains hex characters");
+			if (VL_UNLIKELY(digit>=(1<<shift))) {
+			    error("$readmemb (binary) file contains hex characters");
+			    break;
 			}
+			if (cp>=m_ep || (digit = vl_readmem_hexval[(unsigned char)(*cp)]) < 0) break;
+			c = (unsigned char)(*cp++);
 		    }
 		}
 		innum = true;
 	    }
-	    else {
-		vl_fatal (ofilenamez, linenum, "", "$readmem file syntax error");
+	    else if (c=='\n') { m_linenum++; ignore_to_eol=false; if (innum) reading_addr=false; innum=false; }
+	    else if (c=='\t' || c==' ' || c=='\r' || c=='\f') { if (innum) reading_addr=false; innum=false; }
+	    // Skip // comments and detect /* comments
+	    else if (ignore_to_cmt && lastc=='*' && c=='/') {
+		ignore_to_cmt = false; if (innum) reading_addr=false; innum=false;
+	    } else if (!ignore_to_eol && !ignore_to_cmt) {
+		if (lastc=='/' && c=='*') { ignore_to_cmt = true; m_sawCmt = true; }
+		else if (lastc=='/' && c=='/') { ignore_to_eol = true; }
+		else if (c=='/') {}  // Part of /* or //
+		else if (c=='_') {}
+		else if (c=='@') { reading_addr = true; m_sawAddr = true; innum=false; needinc=false; }
+		else {
+		    error("$readmem file syntax error");
+		}
+	    }
+	    lastc = c;
+	}
+	if (entry>=0) store(entry, value);
+	if (needinc) { addr++; needinc=false; }
+	m_addr = addr;
+	m_addrPending = reading_addr;
+    }
+};
+
+void VL_READMEM_W(bool hex, int width, int depth, int array_lsb, int fnwords,
+		  WDataInP ofilenamep, void* memp, IData start, IData end,
+		  VerilatedEntryCb entrycb) {
+    char ofilenamez[VL_TO_STRING_MAX_WORDS*VL_WORDSIZE+1];
+    _VL_VINT_TO_STRING(fnwords*VL_WORDSIZE, ofilenamez, ofilenamep);
+    // Map the whole file, as preload images may be large;
+    // reading a character at a time is far slower
+    const char* bp = NULL;
+    size_t size = 0;
+    void* mapp = NULL;
+    string text;  // Contents when can't map
+#ifndef VL_READMEM_NO_MMAP
+    int fd = open(ofilenamez, O_RDONLY);
+    struct stat st;
+    if (fd>=0 && fstat(fd, &st)==0 && S_ISREG(st.st_mode) && st.st_size>0) {
+	mapp = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	if (mapp == MAP_FAILED) mapp = NULL;
+	else { bp = (const char*)mapp; size = (size_t)st.st_size; }
+    }
+    if (fd>=0) close(fd);
+#endif
+    if (!mapp) {
+	FILE* fp = fopen(ofilenamez, "r");
+	if (VL_UNLIKELY(!fp)) {
+	    // We don't report the Verilog source filename as it slow to have to pass it down
+	    vl_fatal (ofilenamez, 0, "", "$readmem file not found");
+	    return;
+	}
+	char buf[64*1024];
+	size_t got;
+	while ((got = fread(buf, 1, sizeof(buf), fp)) > 0) text.append(buf, got);
+	fclose(fp);
+	bp = text.data();
+	size = text.length();
+    }
+    const char* ep = bp + size;
+
+    // Parse; each entry's address depends on all text before it, so
+    // first count entries of each range of lines in parallel, then load
+    IData addr = start;
+    int linenum = 1;
+    const char* errorp = NULL;
+    int errorLine = 0;
+    bool parsed = false;
+#ifdef VL_THREADED
+    long cpus = VL_READMEM_CHUNKS_MAX;
+    size_t nchunks = size / VL_READMEM_CHUNK_BYTES;
+    if (nchunks > (size_t)cpus) nchunks = cpus;
+    if (entrycb) nchunks = 0;  // Callback may allocate, so isn't thread safe
+    if (nchunks > 1) {
+	vector<const char*> splits;  // Start of each range, at a line start
+	splits.push_back(bp);
+	for (size_t i=1; i<nchunks; ++i) {
+	    const char* sp = bp + size*i/nchunks;
+	    if (sp < splits.back()) sp = splits.back();
+	    const char* nlp = (const char*)memchr(sp, '\n', ep-sp);
+	    splits.push_back(nlp ? nlp+1 : ep);
+	}
+	splits.push_back(ep);
+	vector<VlReadMem> counts;
+	for (size_t i=0; i<nchunks; ++i) {
+	    counts.push_back(VlReadMem(hex,width,depth,array_lsb,NULL,NULL, splits[i],splits[i+1], 0,0));
+	}
+	vector<pthread_t> threads (nchunks);
+	for (size_t i=0; i<nchunks; ++i) pthread_create(&threads[i], NULL, VlReadMem::parseThread, &counts[i]);
+	for (size_t i=0; i<nchunks; ++i) pthread_join(threads[i], NULL);
+	// Comments or @'s spanning ranges, or errors, need the serial parse
+	bool ok = true;
+	for (size_t i=0; i<nchunks; ++i) {
+	    if (counts[i].m_errorp) ok = false;
+	    if (i+1<nchunks && (counts[i].m_sawCmt || counts[i].m_addrPending)) ok = false;
+	}
+	// Ranges writing the same address would race, and the serial parse
+	// reports out of bounds addresses at the right line
+	vector<pair<QData,QData> > spans;  // Addresses each range writes, [first,last)
+	IData chunkAddr = addr;
+	for (size_t i=0; ok && i<nchunks; ++i) {
+	    if (counts[i].m_relEnd) spans.push_back(make_pair((QData)chunkAddr, chunkAddr + counts[i].m_relEnd));
+	    if (counts[i].m_absAny) spans.push_back(make_pair((QData)counts[i].m_absLo, (QData)counts[i].m_absHi+1));
+	    chunkAddr = counts[i].m_sawAddr ? counts[i].m_addr : chunkAddr + counts[i].m_addr;
+	}
+	sort(spans.begin(), spans.end());
+	for (size_t i=0; ok && i<spans.size(); ++i) {
+	    if (spans[i].first < (QData)array_lsb
+		|| spans[i].second > (QData)array_lsb + depth) ok = false;
+	    if (i && spans[i].first < spans[i-1].second) ok = false;
+	}
+	if (ok) {
+	    vector<VlReadMem> loads;
+	    for (size_t i=0; i<nchunks; ++i) {
+		loads.push_back(VlReadMem(hex,width,depth,array_lsb,memp,NULL, splits[i],splits[i+1], addr,linenum));
+		addr = counts[i].m_sawAddr ? counts[i].m_addr : addr + counts[i].m_addr;
+		linenum += counts[i].m_linenum;
+	    }
+	    for (size_t i=0; i<nchunks; ++i) pthread_create(&threads[i], NULL, VlReadMem::parseThread, &loads[i]);
+	    for (size_t i=0; i<nchunks; ++i) pthread_join(threads[i], NULL);
+	    for (size_t i=0; i<nchunks; ++i) {
+		if (loads[i].m_errorp) { errorp = loads[i].m_errorp; errorLine = loads[i].m_errorLine; break; }
 	    }
+	    addr = loads.back().m_addr;
+	    linenum = loads.back().m_linenum;
+	    parsed = true;
+	    VL_DEBUG_IF(VL_PRINTF("-vltReadmem: %s loaded as %d ranges\n", ofilenamez, (int)nchunks););
 	}
-	lastc = c;
     }
-    if (needinc) { addr++; needinc=false; }
+#endif
+    if (!parsed) {
+	VlReadMem loader (hex,width,depth,array_lsb,memp,entrycb, bp,ep, start,1);
+	loader.parse();
+	errorp = loader.m_errorp;
+	errorLine = loader.m_errorLine;
+	addr = loader.m_addr;
+	linenum = loader.m_linenum;
+    }
+#ifndef VL_READMEM_NO_MMAP
+    if (mapp) munmap(mapp, size);
+#endif
 
     // Final checks
-    fclose(fp);
+    if (VL_UNLIKELY(errorp)) {
+	vl_fatal (ofilenamez, errorLine, "", errorp);
+	return;
+    }
     if (VL_UNLIKELY(end != VL_UL(0xffffffff) && addr != (end+1))) {
 	vl_fatal (ofilenamez, linenum, "", "$readmem file ended before specified ending-address");
     }
@@ -971,15 +1493,13 @@ IData VL_SYSTEM_IW(int lhswords, WDataInP filenamep) {
 }
 
 IData VL_TESTPLUSARGS_I(const char* formatp) {
-    const string& match = VerilatedImp::argPlusMatch(formatp);
-    if (match == "") return 0;
-    else return 1;
+    return VerilatedImp::argPlusMatch(formatp) ? 1 : 0;
 }
 
 IData VL_VALUEPLUSARGS_IW(int rbits, const char* prefixp, char fmt, WDataOutP rwp) {
-    const string& match = VerilatedImp::argPlusMatch(prefixp);
-    const char* dp = match.c_str() + 1 /*leading + */ + strlen(prefixp);
-    if (match == "") return 0;
+    const char* matchp = VerilatedImp::argPlusMatch(prefixp);
+    if (!matchp) return 0;
+    const char* dp = matchp + 1 /*leading + */ + strlen(prefixp);
     VL_ZERO_RESET_W(rbits, rwp);
     switch (tolower(fmt)) {
     case '%':
@@ -1013,10 +1533,10 @@ IData VL_VALUEPLUSARGS_IW(int rbits, const char* prefixp, char fmt, WDataOutP rw
 }
 
 const char* vl_mc_scan_plusargs(const char* prefixp) {
-    const string& match = VerilatedImp::argPlusMatch(prefixp);
+    const char* matchp = VerilatedImp::argPlusMatch(prefixp);
     static VL_THREAD char outstr[VL_VALUE_STRING_MAX_WIDTH];
-    if (match == "") return NULL;
-    strncpy(outstr, match.c_str()+strlen(prefixp)+1, // +1 to skip the "+"
+    if (!matchp) return NULL;
+    strncpy(outstr, matchp+strlen(prefixp)+1, // +1 to skip the "+"
 	    VL_VALUE_STRING_MAX_WIDTH);
     outstr[VL_VALUE_STRING_MAX_WIDTH-1] = '\0';
     return outstr;
@@ -1066,6 +1586,7 @@ const char* Verilated::catName(const char* n1, const char* n2) {
 }
 
 void Verilated::flushCb(VerilatedVoidCb cb) {
+    VerilatedLockGuard guard (s_flushMutex);
     if (s_flushCb == cb) {}  // Ok - don't duplicate
     else if (!s_flushCb) { s_flushCb=cb; }
     else {
@@ -1075,13 +1596,37 @@ void Verilated::flushCb(VerilatedVoidCb cb) {
 }
 
 void Verilated::commandArgs(int argc, const char** argv) {
-    s_args.argc = argc;
-    s_args.argv = argv;
     VerilatedImp::commandArgs(argc,argv);
+    for (int i=0; i<argc; ++i) {
+	static const char seedArg[] = "+verilator+seed+";
+	if (0==strncmp(argv[i], seedArg, sizeof(seedArg)-1)) {
+	    vluint64_t seed = 0;
+	    for (const char* cp=argv[i]+sizeof(seedArg)-1; isdigit(*cp); ++cp) {
+		seed = seed*10 + (*cp-'0');
+	    }
+	    randSeed(seed);
+	}
+    }
+}
+
+void Verilated::randSeed(vluint64_t seed) {
+    vl_rand_seed(t_contextp->m_s.s_randState, seed);
+}
+
+Verilated::CommandArgValues* Verilated::getCommandArgs() {
+    static VL_THREAD CommandArgValues args;
+    VerilatedImp::argsGet(args.argc, args.argv);
+    return &args;
 }
 
 const char* Verilated::commandArgsPlusMatch(const char* prefixp) {
-    return VerilatedImp::argPlusMatch(prefixp).c_str();
+    // Copy out, as a later commandArgs may replace the arguments
+    const char* matchp = VerilatedImp::argPlusMatch(prefixp);
+    static VL_THREAD char outstr[VL_VALUE_STRING_MAX_WIDTH];
+    if (!matchp) return "";
+    strncpy(outstr, matchp, VL_VALUE_STRING_MAX_WIDTH);
+    outstr[VL_VALUE_STRING_MAX_WIDTH-1] = '\0';
+    return outstr;
 }
 
 void Verilated::internalsDump() {
@@ -1096,6 +1641,10 @@ const VerilatedScope* Verilated::scopeFind(const char* namep) {
     return VerilatedImp::scopeFind(namep);
 }
 
+vluint32_t Verilated::scopesGeneration() {
+    return VerilatedImp::scopesGeneration();
+}
+
 int Verilated::exportFuncNum(const char* namep) {
     return VerilatedImp::exportFind(namep);
 }
@@ -1138,6 +1687,7 @@ VerilatedScope::VerilatedScope() {
     m_funcnumMax = 0;
     m_symsp = NULL;
     m_varsp = NULL;
+    m_contextp = NULL;
 }
 
 VerilatedScope::~VerilatedScope() {
@@ -1157,6 +1707,7 @@ void VerilatedScope::configure(VerilatedSyms* symsp, const char* prefixp, const
     if (*prefixp && *suffixp) strcat(namep,".");
     strcat(namep, suffixp);
     m_namep = namep;
+    m_contextp = Verilated::threadContextp();
     VerilatedImp::scopeInsert(this);
 }
 
@@ -1180,14 +1731,14 @@ void VerilatedScope::exportInsert(int finalize, const char* namep, void* cb) {
     }
 }
 
-void VerilatedScope::varInsert(int finalize, const char* namep, void* datap,
+void VerilatedScope::varInsert(int finalize, const char* namep, void* datap, CData* dirtyp,
 			       VerilatedVarType vltype, int vlflags, int dims, ...) {
     // Grab dimensions
     // In the future we may just create a large table at emit time and statically construct from that.
     if (!finalize) return;
 
     if (!m_varsp) m_varsp = new VerilatedVarNameMap();
-    VerilatedVar var (namep, datap, vltype, (VerilatedVarFlags)vlflags, dims);
+    VerilatedVar var (namep, datap, dirtyp, vltype, (VerilatedVarFlags)vlflags, dims);
 
     va_list ap;
     va_start(ap,dims);
@@ -1208,16 +1759,14 @@ void VerilatedScope::varInsert(int finalize, const char* namep, void* datap,
     }
     va_end(ap);
 
-    m_varsp->insert(make_pair(namep,var));
+    VerilatedVarNameMap::iterator it = m_varsp->insert(make_pair(namep,var)).first;
+    m_varsp->hashInsert(it->first, &(it->second));
 }
 
 // cppcheck-suppress unusedFunction  // Used by applications
 VerilatedVar* VerilatedScope::varFind(const char* namep) const {
     if (VL_LIKELY(m_varsp)) {
-	VerilatedVarNameMap::iterator it = m_varsp->find(namep);
-	if (VL_LIKELY(it != m_varsp->end())) {	
-	    return &(it->second);
-	}
+	return m_varsp->hashFind(namep);
     }
     return NULL;
 }
@@ -37,6 +37,9 @@
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
+#ifdef VL_THREADED
+# include <pthread.h>
+#endif
 // <iostream> avoided to reduce compile time
 // <string> avoided and instead in verilated_heavy.h to reduce compile time
 using namespace std;
@@ -68,6 +71,7 @@ typedef void (*VerilatedVoidCb)(void);
 
 class SpTraceVcd;
 class SpTraceVcdCFile;
+class VerilatedContext;
 class VerilatedVar;
 class VerilatedVarNameMap;
 class VerilatedVcd;
@@ -109,6 +113,57 @@ public:
     const char* name() const { return m_namep; }	///< Return name of module
 };
 
+//=========================================================================
+/// Memory stored as pages allocated on first access, see --sparse-memory.
+/// Indexing has the same syntax as the dense C array it replaces.
+
+typedef void* (*VerilatedEntryCb)(void* memp, IData entry);	///< Return pointer to a memory's entry
+
+template <class T_Value, size_t T_Depth> class VlSparseArray {
+public:
+    enum { PAGE_BITS = 12 };			///< log2 of entries per page
+    static const size_t PAGE_ENTRIES = (size_t)1 << PAGE_BITS;	///< Entries per page
+    static const size_t PAGES = (T_Depth + PAGE_ENTRIES - 1) >> PAGE_BITS;	///< Pages to cover the memory
+private:
+    T_Value*	m_pagesp[PAGES];	///< Each page, or NULL if not yet accessed
+    static T_Value s_zero;		///< Value of entries not yet accessed
+    VlSparseArray(const VlSparseArray&);	///< N/A, no copying
+    T_Value* pageNew(size_t page) {
+	T_Value* pagep = new T_Value[PAGE_ENTRIES];
+	memset(pagep, 0, sizeof(T_Value)*PAGE_ENTRIES);
+	return m_pagesp[page] = pagep;
+    }
+public:
+    VlSparseArray() { memset(m_pagesp, 0, sizeof(m_pagesp)); }
+    ~VlSparseArray() { clear(); }
+    /// Entry at index, allocating its page if needed
+    T_Value& operator[](size_t index) {
+	T_Value* pagep = m_pagesp[index >> PAGE_BITS];
+	if (VL_UNLIKELY(!pagep)) pagep = pageNew(index >> PAGE_BITS);
+	return pagep[index & (PAGE_ENTRIES-1)];
+    }
+    /// Entry at index, without allocating its page
+    const T_Value& read(size_t index) const {
+	const T_Value* pagep = m_pagesp[index >> PAGE_BITS];
+	if (!pagep) return s_zero;
+	return pagep[index & (PAGE_ENTRIES-1)];
+    }
+    /// Page of entries, or NULL if not allocated; for save/restore
+    T_Value* pagep(size_t page) const { return m_pagesp[page]; }
+    /// Page of entries, allocating if needed
+    T_Value* pagepNew(size_t page) { return m_pagesp[page] ? m_pagesp[page] : pageNew(page); }
+    /// Free all pages, returning every entry to zero
+    void clear() {
+	for (size_t page=0; page<PAGES; ++page) {
+	    delete[] m_pagesp[page];
+	    m_pagesp[page] = NULL;
+	}
+    }
+    /// Callback for routines like $readmem taking any memory
+    static void* entryCb(void* memp, IData entry) { return &((*(VlSparseArray*)memp)[entry]); }
+};
+template <class T_Value, size_t T_Depth> T_Value VlSparseArray<T_Value,T_Depth>::s_zero;
+
 //=========================================================================
 // Declare nets
 
@@ -125,6 +180,11 @@ public:
 # define VL_SIG64(name, msb,lsb)	QData name		///< Declare signal, 33-64 bits
 # define VL_SIG(name, msb,lsb)		IData name		///< Declare signal, 17-32 bits
 # define VL_SIGW(name, msb,lsb, words)	WData name[words]	///< Declare signal, 65+ bits
+# define VL_SPARSE8(name, depth, msb,lsb)	VlSparseArray<CData,depth> name	///< Declare sparse memory, 1-8 bits
+# define VL_SPARSE16(name, depth, msb,lsb)	VlSparseArray<SData,depth> name	///< Declare sparse memory, 9-16 bits
+# define VL_SPARSE64(name, depth, msb,lsb)	VlSparseArray<QData,depth> name	///< Declare sparse memory, 33-64 bits
+# define VL_SPARSE(name, depth, msb,lsb)	VlSparseArray<IData,depth> name	///< Declare sparse memory, 17-32 bits
+# define VL_SPARSEW(name, depth, msb,lsb, words) VlSparseArray<WData[words],depth> name	///< Declare sparse memory, 65+ bits
 # define VL_IN8(name, msb,lsb)		CData name		///< Declare input signal, 1-8 bits
 # define VL_IN16(name, msb,lsb)		SData name		///< Declare input signal, 9-16 bits
 # define VL_IN64(name, msb,lsb)		QData name		///< Declare input signal, 33-64 bits
@@ -167,6 +227,9 @@ public:
 #ifndef VL_VPRINTF
 # define VL_VPRINTF vprintf	///< Print ala vprintf; may redefine if desired
 #endif
+#ifndef VL_DISPLAY_BUFFERING
+# define VL_DISPLAY_BUFFERING VL_DISPLAY_UNBUFFERED	///< Initial Verilated::displayBuffering of each context
+#endif
 
 //===========================================================================
 /// Verilator symbol table base class
@@ -186,16 +249,18 @@ class VerilatedScope {
     // 4 bytes padding (on -m64), for rent.
     VerilatedVarNameMap* m_varsp;	///< Variable map
     const char* 	m_namep;	///< Scope name (Slowpath)
+    VerilatedContext*	m_contextp;	///< Context whose scope map holds this (Slowpath)
 
 public:  // But internals only - called from VerilatedModule's
     VerilatedScope();
     ~VerilatedScope();
     void configure(VerilatedSyms* symsp, const char* prefixp, const char* suffixp);
     void exportInsert(int finalize, const char* namep, void* cb);
-    void varInsert(int finalize, const char* namep, void* datap,
+    void varInsert(int finalize, const char* namep, void* datap, CData* dirtyp,
 		   VerilatedVarType vltype, int vlflags, int dims, ...);
     // ACCESSORS
     const char* name() const { return m_namep; }
+    VerilatedContext* contextp() const { return m_contextp; }
     inline VerilatedSyms* symsp() const { return m_symsp; }
     VerilatedVar* varFind(const char* namep) const;
     VerilatedVarNameMap* varsp() const { return m_varsp; }
@@ -214,16 +279,72 @@ public:  // But internals only - called from VerilatedModule's
 };
 
 //===========================================================================
-/// Verilator global static information class
+/// Mutex around runtime state shared between threads; no-op unless VL_THREADED
 
-class Verilated {
-    // MEMBERS
-    // Slow path variables
-    static VerilatedVoidCb  s_flushCb;		///< Flush callback function
+#ifdef VL_THREADED
+class VerilatedMutex {
+    pthread_mutex_t	m_mutex;	///< Underlying mutex
+    VerilatedMutex(const VerilatedMutex&);	///< N/A; no copy constructor
+    VerilatedMutex& operator= (const VerilatedMutex&);	///< N/A; no copy
+public:
+    VerilatedMutex() { pthread_mutex_init(&m_mutex, NULL); }
+    ~VerilatedMutex() { pthread_mutex_destroy(&m_mutex); }
+    void lock() { pthread_mutex_lock(&m_mutex); }
+    void unlock() { pthread_mutex_unlock(&m_mutex); }
+};
+#else
+class VerilatedMutex {
+public:
+    void lock() {}
+    void unlock() {}
+};
+#endif
+
+/// Lock a VerilatedMutex for the lifetime of this object
+class VerilatedLockGuard {
+    VerilatedMutex&	m_mutexr;
+public:
+    explicit VerilatedLockGuard(VerilatedMutex& mutexr) : m_mutexr(mutexr) { m_mutexr.lock(); }
+    ~VerilatedLockGuard() { m_mutexr.unlock(); }
+};
 
-    static struct Serialized {   // All these members serialized/deserialized
+//===========================================================================
+/// Buffering of $display and $write output to stdout, see Verilated::displayBuffering
+
+enum VerilatedDisplayBuffering {
+    VL_DISPLAY_UNBUFFERED = 0,	///< Pass each $display straight to VL_PRINTF
+    VL_DISPLAY_LINE = 1,	///< Write out complete lines after each $display
+    VL_DISPLAY_EVAL = 2,	///< Write out when eval() returns
+    VL_DISPLAY_SIZE = 3		///< Write out complete lines when the buffer fills
+};
+
+//===========================================================================
+/// Verilator per-simulation state
+///
+/// A model is bound to the context that is current on the thread that
+/// constructs it, and makes that context current again each time it is
+/// evaluated, so the Verilated:: accessors, $finish, assertion enables and
+/// $fopen'ed files act on that model's simulation.  Independent models
+/// built with VL_THREADED may then be evaluated concurrently on separate
+/// threads, each constructed under its own context.
+
+class VerilatedContextImp;
+
+/// Internal: Base of a context's VPI state, so the context may delete it
+class VerilatedContextVpi {
+public:
+    virtual ~VerilatedContextVpi() {}
+};
+
+class VerilatedContext {
+    friend class Verilated;
+    friend class VerilatedImp;
+    friend class VerilatedVpi;
+    // MEMBERS
+    struct Serialized {   // All these members serialized/deserialized
 	// Slow path
 	int		s_randReset;		///< Random reset: 0=all 0s, 1=all 1s, 2=random
+	vluint64_t	s_randState[4];		///< $random and random reset generator state
 	// Fast path
 	int		s_debug;		///< See accessors... only when VL_DEBUG set
 	bool		s_calcUnusedSigs;	///< Waves file on, need all signals calculated
@@ -231,7 +352,42 @@ class Verilated {
 	bool		s_assertOn;		///< Assertions are enabled
         bool		s_fatalOnVpiError;	///< Stop on vpi error/unsupported
 	Serialized();
-    } s_s;
+    } m_s;
+    vluint64_t		m_time;		///< Simulation time, see VL_TIME_CONTEXT
+    VerilatedContextImp* m_impp;	///< Files, display buffer, scopes and arguments, created on first use
+    VerilatedContextVpi* m_vpip;	///< VPI state, created on first VPI use
+    int			m_threadUses;	///< Threads other than by default this is current on
+    size_t		m_displayBufferSize;	///< Bytes to buffer under VL_DISPLAY_SIZE
+    VerilatedDisplayBuffering m_displayBuffering;	///< Buffering of $display to stdout
+    bool		m_displayEvalPending;	///< Buffered output to write when eval() returns
+
+    VerilatedContext(const VerilatedContext&);	///< N/A; no copy constructor
+    VerilatedContext& operator= (const VerilatedContext&);	///< N/A; no copy
+public:
+    // CONSTRUCTORS
+    VerilatedContext();
+    /// Destroy only after the models bound to the context are deleted, and
+    /// every other thread that selected it has exited or selected another
+    ~VerilatedContext();
+    // METHODS
+    /// Did this simulation $finish?
+    bool gotFinish() const { return m_s.s_gotFinish; }
+    /// Simulation time; $time under VL_TIME_CONTEXT, else only for the application's use
+    vluint64_t time() const { return m_time; }
+    void time(vluint64_t value) { m_time = value; }
+};
+
+//===========================================================================
+/// Verilator global static information class
+
+class Verilated {
+    // MEMBERS
+    // Slow path variables
+    static VerilatedVoidCb  s_flushCb;		///< Flush callback function
+    static VerilatedMutex   s_flushMutex;	///< Protect s_flushCb registration
+
+    static VerilatedContext s_defaultContext;	///< Context of threads that never set one
+    static VL_THREAD VerilatedContext* t_contextp;	///< Context of this thread's current model
 
     static VL_THREAD const VerilatedScope* t_dpiScopep;	///< DPI context scope
     static VL_THREAD const char*	t_dpiFilename;	///< DPI context filename
@@ -239,54 +395,84 @@ class Verilated {
 
     // no need to be save-restored (serialized) the
     // assumption is that the restore is allowed to pass different arguments
-    static struct CommandArgValues {
+    struct CommandArgValues {
 	int          argc;
 	const char** argv;
-    } s_args;
+    };
+
+    static void threadContextSwitch(VerilatedContext* contextp);
 
 public:
 
     // METHODS - User called
 
+    /// Select the simulation context used by this thread; the model
+    /// constructors and evaluations that follow are bound to it.
+    /// NULL selects the default context shared by all threads.
+    static void threadContextp(VerilatedContext* contextp) {
+	if (!contextp) contextp = &s_defaultContext;
+	if (VL_UNLIKELY(t_contextp != contextp)) threadContextSwitch(contextp);
+    }
+    static VerilatedContext* threadContextp() { return t_contextp; }
+    static VerilatedContext* defaultContextp() { return &s_defaultContext; }
+
+    /// Select buffering of $display and $write output to stdout for the
+    /// current context.  Buffered output is written a chunk of whole lines
+    /// at a time, so text from models on other threads is never interleaved
+    /// within a line.
+    static void displayBuffering(VerilatedDisplayBuffering mode, size_t bytes=64*1024) {
+	t_contextp->m_displayBuffering=mode; t_contextp->m_displayBufferSize=bytes; }
+    static VerilatedDisplayBuffering displayBuffering() { return t_contextp->m_displayBuffering; }
+    /// Write out any buffered $display output of the current context
+    static void displayFlush();
+    /// Internal: Called by the model as eval() returns
+    static void displayEvalDone() {
+	if (VL_UNLIKELY(t_contextp->m_displayEvalPending)) displayFlush(); }
+
     /// Select initial value of otherwise uninitialized signals.
     ////
     /// 0 = Set to zeros
     /// 1 = Set all bits to one
     /// 2 = Randomize all bits
-    static void randReset(int val) { s_s.s_randReset=val; }
-    static int  randReset() { return s_s.s_randReset; }	///< Return randReset value
+    static void randReset(int val) { t_contextp->m_s.s_randReset=val; }
+    static int  randReset() { return t_contextp->m_s.s_randReset; }	///< Return randReset value
+    /// Seed the generator used by $random and randReset(2) in the current
+    /// context.  Also set by a +verilator+seed+<value> command argument.
+    static void randSeed(vluint64_t seed);
 
     /// Enable debug of internal verilated code
-    static inline void debug(int level) { s_s.s_debug = level; }
+    static inline void debug(int level) { t_contextp->m_s.s_debug = level; }
 #ifdef VL_DEBUG
-    static inline int  debug() { return s_s.s_debug; }	///< Return debug value
+    static inline int  debug() { return t_contextp->m_s.s_debug; }	///< Return debug value
 #else
     static inline int  debug() { return 0; }		///< Constant 0 debug, so C++'s optimizer rips up
 #endif
     /// Enable calculation of unused signals
-    static void calcUnusedSigs(bool flag) { s_s.s_calcUnusedSigs=flag; }
-    static bool calcUnusedSigs() { return s_s.s_calcUnusedSigs; }	///< Return calcUnusedSigs value
+    static void calcUnusedSigs(bool flag) { t_contextp->m_s.s_calcUnusedSigs=flag; }
+    static bool calcUnusedSigs() { return t_contextp->m_s.s_calcUnusedSigs; }	///< Return calcUnusedSigs value
     /// Did the simulation $finish?
-    static void gotFinish(bool flag) { s_s.s_gotFinish=flag; }
-    static bool gotFinish() { return s_s.s_gotFinish; }	///< Return if got a $finish
+    static void gotFinish(bool flag) { t_contextp->m_s.s_gotFinish=flag; }
+    static bool gotFinish() { return t_contextp->m_s.s_gotFinish; }	///< Return if got a $finish
     /// Allow traces to at some point be enabled (disables some optimizations)
     static void traceEverOn(bool flag) {
 	if (flag) { calcUnusedSigs(flag); }
     }
     /// Enable/disable assertions
-    static void assertOn(bool flag) { s_s.s_assertOn=flag; }
-    static bool assertOn() { return s_s.s_assertOn; }
+    static void assertOn(bool flag) { t_contextp->m_s.s_assertOn=flag; }
+    static bool assertOn() { return t_contextp->m_s.s_assertOn; }
     /// Enable/disable vpi fatal
-    static void fatalOnVpiError(bool flag) { s_s.s_fatalOnVpiError=flag; }
-    static bool fatalOnVpiError() { return s_s.s_fatalOnVpiError; }
+    static void fatalOnVpiError(bool flag) { t_contextp->m_s.s_fatalOnVpiError=flag; }
+    static bool fatalOnVpiError() { return t_contextp->m_s.s_fatalOnVpiError; }
     /// Flush callback for VCD waves
     static void flushCb(VerilatedVoidCb cb);
-    static void flushCall() { if (s_flushCb) (*s_flushCb)(); }
+    static void flushCall() { displayFlush(); if (s_flushCb) (*s_flushCb)(); }
 
-    /// Record command line arguments, for retrieval by $test$plusargs/$value$plusargs
+    /// Record command line arguments of the current context, for retrieval
+    /// by $test$plusargs/$value$plusargs.  A context that never had any
+    /// recorded uses the default context's.
     static void commandArgs(int argc, const char** argv);
     static void commandArgs(int argc, char** argv) { commandArgs(argc,(const char**)argv); }
-    static CommandArgValues* getCommandArgs() {return &s_args;}
+    static CommandArgValues* getCommandArgs();
     static const char* commandArgsPlusMatch(const char* prefixp);
 
     /// Produce name & version for (at least) VPI
@@ -298,16 +484,19 @@ public:
     /// releases - contact the authors before production use.
     static void internalsDump();
 
-    /// For debugging, print text list of all scope names with
-    /// dpiImport/Export context.  This function may change in future
-    /// releases - contact the authors before production use.
+    /// For debugging, print text list of all scope names of the current
+    /// context with dpiImport/Export context.  This function may change
+    /// in future releases - contact the authors before production use.
     static void scopesDump();
 
     // METHODS - INTERNAL USE ONLY
     // Internal: Create a new module name by concatenating two strings
     static const char* catName(const char* n1, const char* n2); // Returns new'ed data
-    // Internal: Find scope
+    // Internal: Find scope of the current context
     static const VerilatedScope* scopeFind(const char* namep);
+    // Internal: Changes whenever a scope of the current context is added or removed,
+    // so scopeFind results may be cached
+    static vluint32_t scopesGeneration();
     // Internal: Get and set DPI context
     static const VerilatedScope* dpiScope() { return t_dpiScopep; }
     static void dpiScope(const VerilatedScope* scopep) { t_dpiScopep=scopep; }
@@ -318,8 +507,9 @@ public:
     static const char* dpiFilenamep() { return t_dpiFilename; }
     static int dpiLineno() { return t_dpiLineno; }
     static int exportFuncNum(const char* namep);
-    static size_t serializedSize() { return sizeof(s_s); }
-    static void* serializedPtr() { return &s_s; }
+    static vluint64_t* randStatep() { return t_contextp->m_s.s_randState; }
+    static size_t serializedSize() { return sizeof(t_contextp->m_s); }
+    static void* serializedPtr() { return &t_contextp->m_s; }
 };
 
 //=========================================================================
@@ -345,6 +535,17 @@ extern IData  VL_RAND_RESET_I(int obits);	///< Random reset a signal
 extern QData  VL_RAND_RESET_Q(int obits);	///< Random reset a signal
 extern WDataOutP VL_RAND_RESET_W(int obits, WDataOutP outwp);	///< Random reset a signal
 extern WDataOutP VL_ZERO_RESET_W(int obits, WDataOutP outwp);	///< Zero reset a signal
+/// Random reset every entry of an unpacked array, in one call
+extern void VL_RAND_RESET_ARRAY(int obits, CData* outp, size_t entries);
+extern void VL_RAND_RESET_ARRAY(int obits, SData* outp, size_t entries);
+extern void VL_RAND_RESET_ARRAY(int obits, IData* outp, size_t entries);
+extern void VL_RAND_RESET_ARRAY(int obits, QData* outp, size_t entries);
+extern void VL_RAND_RESET_ARRAY_W(int obits, WDataOutP outwp, size_t entries);
+/// Random reset a run of separate signals of the same width, in one call
+extern void VL_RAND_RESET_RUN(int obits, CData* const* outpp, size_t count);
+extern void VL_RAND_RESET_RUN(int obits, SData* const* outpp, size_t count);
+extern void VL_RAND_RESET_RUN(int obits, IData* const* outpp, size_t count);
+extern void VL_RAND_RESET_RUN(int obits, QData* const* outpp, size_t count);
 
 /// Math
 extern WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp, bool is_modulus);
@@ -360,15 +561,31 @@ inline IData VL_FOPEN_II(IData ofilename, IData mode) { return VL_FOPEN_QI(ofile
 extern void VL_FCLOSE_I(IData fdi);
 
 extern void VL_READMEM_W(bool hex, int width, int depth, int array_lsb, int fnwords,
-			 WDataInP ofilename, void* memp, IData start, IData end);
+			 WDataInP ofilename, void* memp, IData start, IData end,
+			 VerilatedEntryCb entrycb=NULL);
 extern void VL_READMEM_Q(bool hex, int width, int depth, int array_lsb, int fnwords,
-			 QData ofilename,    void* memp, IData start, IData end);
+			 QData ofilename,    void* memp, IData start, IData end,
+			 VerilatedEntryCb entrycb=NULL);
 inline void VL_READMEM_I(bool hex, int width, int depth, int array_lsb, int fnwords,
-			 IData ofilename,    void* memp, IData start, IData end) {
-    VL_READMEM_Q(hex, width,depth,array_lsb,fnwords, ofilename,memp,start,end); }
+			 IData ofilename,    void* memp, IData start, IData end,
+			 VerilatedEntryCb entrycb=NULL) {
+    VL_READMEM_Q(hex, width,depth,array_lsb,fnwords, ofilename,memp,start,end,entrycb); }
+
+/// One operation of a $display-like format precompiled by Verilator;
+/// an array of these replaces the format string so no parsing is needed at runtime.
+struct VerilatedFormatOp {
+    const char*	m_textp;	///< Literal text to output before the value
+    int		m_textLen;	///< Length of m_textp
+    char	m_fmt;		///< Format code, as in _vl_vsformat; '\0' ends the operations
+    bool	m_zeroPad;	///< Pad decimal with zeros rather than spaces
+    int		m_width;	///< Field width, or -1 if none specified
+    const char*	m_cfmtp;	///< printf() format of real values, else NULL
+};
 
 extern void VL_WRITEF(const char* formatp, ...);
 extern void VL_FWRITEF(IData fpi, const char* formatp, ...);
+extern void VL_WRITEF(const VerilatedFormatOp* opsp, ...);
+extern void VL_FWRITEF(IData fpi, const VerilatedFormatOp* opsp, ...);
 
 extern IData VL_FSCANF_IX(IData fpi, const char* formatp, ...);
 extern IData VL_SSCANF_IIX(int lbits, IData ld, const char* formatp, ...);
@@ -376,6 +593,7 @@ extern IData VL_SSCANF_IQX(int lbits, QData ld, const char* formatp, ...);
 extern IData VL_SSCANF_IWX(int lbits, WDataInP lwp, const char* formatp, ...);
 
 extern void VL_SFORMAT_X(int obits, void* destp, const char* formatp, ...);
+extern void VL_SFORMAT_X(int obits, void* destp, const VerilatedFormatOp* opsp, ...);
 
 extern IData VL_SYSTEM_IW(int lhsnwords, WDataInP lhs);
 extern IData VL_SYSTEM_IQ(QData lhs);
@@ -444,7 +662,12 @@ void _VL_DEBUG_PRINT_W(int lbits, WDataInP iwp);
 #endif
 
 /// Return current simulation time
-#if defined(SYSTEMC_VERSION) && (SYSTEMC_VERSION>20011000)
+#if defined(VL_TIME_CONTEXT)
+// Each simulation's time is kept in its VerilatedContext, rather than a single sc_time_stamp()
+# define VL_TIME_I() ((IData)(Verilated::threadContextp()->time()*VL_TIME_MULTIPLIER))
+# define VL_TIME_Q() ((QData)(Verilated::threadContextp()->time()*VL_TIME_MULTIPLIER))
+# define VL_TIME_D() ((double)(Verilated::threadContextp()->time()*VL_TIME_MULTIPLIER))
+#elif defined(SYSTEMC_VERSION) && (SYSTEMC_VERSION>20011000)
 # define VL_TIME_I() ((IData)(sc_time_stamp().to_default_time_units()*VL_TIME_MULTIPLIER))
 # define VL_TIME_Q() ((QData)(sc_time_stamp().to_default_time_units()*VL_TIME_MULTIPLIER))
 # define VL_TIME_D() ((double)(sc_time_stamp().to_default_time_units()*VL_TIME_MULTIPLIER))
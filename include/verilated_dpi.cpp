@@ -86,47 +86,146 @@ void svPutPartselLogic(svLogicVecVal* d, const svLogicVecVal s, int i, int w) {
     _VL_SVDPI_UNIMP();
 }
 
+//======================================================================
+// Open array internal utilities
+
+// Open arrays from Verilated code have a single unpacked dimension; see VerilatedDpiOpenVar
+static inline const VerilatedDpiOpenVar* _vl_openhandle_varp(const svOpenArrayHandle h) {
+    if (VL_UNLIKELY(!h)) {
+	vl_fatal(__FILE__,__LINE__,"","%%Error: DPI svOpenArrayHandle function called with NULL handle");
+    }
+    return (const VerilatedDpiOpenVar*)(h);
+}
+
+static void* _vl_sv_adims_elemp(const char* funcp, const svOpenArrayHandle h, int nargs, int indx1) {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(h);
+    if (VL_UNLIKELY(nargs != 1)) {
+	VL_PRINTF("%%Warning: DPI %s called with %d indices on array with 1 unpacked dimension\n",
+		  funcp, nargs);
+	return NULL;
+    }
+    void* datap = varp->elemp(indx1);
+    if (VL_UNLIKELY(!datap)) {
+	VL_PRINTF("%%Warning: DPI %s index %d outside array bounds [%d:%d]\n",
+		  funcp, indx1, varp->left(), varp->right());
+    }
+    return datap;
+}
+
+// Copy element from Verilated storage into svBitVecVal words
+static void _vl_sv_get_vec(svBitVecVal* d, const VerilatedDpiOpenVar* varp, const void* datap) {
+    switch (varp->entSize()) {
+    case sizeof(CData): d[0] = *((const CData*)datap); break;
+    case sizeof(SData): d[0] = *((const SData*)datap); break;
+    case sizeof(IData): d[0] = *((const IData*)datap); break;
+    case sizeof(QData): VL_SET_WQ(d, *((const QData*)datap)); break;
+    default: memcpy(d, datap, varp->entSize()); break;
+    }
+}
+
+// Copy svBitVecVal words into Verilated storage, masking to the element width
+static void _vl_sv_put_vec(const VerilatedDpiOpenVar* varp, void* datap, const svBitVecVal* s) {
+    int bits = varp->bits();
+    switch (varp->entSize()) {
+    case sizeof(CData): *((CData*)datap) = s[0] & VL_MASK_I(bits); break;
+    case sizeof(SData): *((SData*)datap) = s[0] & VL_MASK_I(bits); break;
+    case sizeof(IData): *((IData*)datap) = s[0] & VL_MASK_I(bits); break;
+    case sizeof(QData): *((QData*)datap) = _VL_SET_QII(s[1], s[0]) & VL_MASK_Q(bits); break;
+    default: VL_SET_W_SVBV(bits, (WDataOutP)datap, (svBitVecVal*)s); break;
+    }
+}
+
+static void _vl_sv_get_logic_vec(svLogicVecVal* d, const VerilatedDpiOpenVar* varp, const void* datap) {
+    // Note we don't create X/Z in svLogicVecVal
+    if (varp->bits() > VL_QUADSIZE) {
+	VL_SET_SVLV_W(varp->bits(), d, (WDataInP)datap);
+    } else {
+	svBitVecVal tmp[VL_WORDS_I(VL_QUADSIZE)];
+	_vl_sv_get_vec(tmp, varp, datap);
+	for (int i=0; i<VL_WORDS_I(varp->bits()); ++i) { d[i].aval = tmp[i]; d[i].bval = 0; }
+    }
+}
+
+static void _vl_sv_put_logic_vec(const VerilatedDpiOpenVar* varp, void* datap, const svLogicVecVal* s) {
+    // Note we ignore X/Z in svLogicVecVal
+    if (varp->bits() > VL_QUADSIZE) {
+	VL_SET_W_SVLV(varp->bits(), (WDataOutP)datap, (svLogicVecVal*)s);
+    } else {
+	svBitVecVal tmp[VL_WORDS_I(VL_QUADSIZE)];
+	tmp[0] = s[0].aval;
+	tmp[1] = (varp->bits() > VL_WORDSIZE) ? s[1].aval : 0;
+	_vl_sv_put_vec(varp, datap, tmp);
+    }
+}
+
+static svBit _vl_sv_get_bit(const VerilatedDpiOpenVar* varp, const void* datap) {
+    if (varp->bits() > VL_QUADSIZE) return *((const IData*)datap) & 1;
+    svBitVecVal tmp[VL_WORDS_I(VL_QUADSIZE)];
+    _vl_sv_get_vec(tmp, varp, datap);
+    return tmp[0] & 1;
+}
+
+static void _vl_sv_put_bit(const VerilatedDpiOpenVar* varp, void* datap, svBit value) {
+    if (varp->bits() > VL_QUADSIZE) {
+	memset(datap, 0, varp->entSize());
+	*((IData*)datap) = value & 1;
+    } else {
+	svBitVecVal tmp[VL_WORDS_I(VL_QUADSIZE)];
+	tmp[0] = value & 1;
+	tmp[1] = 0;
+	_vl_sv_put_vec(varp, datap, tmp);
+    }
+}
+
 //======================================================================
 // Open array querying functions
 
+// Dimension 0 is the packed element, dimension 1 the unpacked array
 int svLeft(const svOpenArrayHandle h, int d) {
-    _VL_SVDPI_UNIMP(); return 0;
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(h);
+    return (d == 0) ? varp->bits()-1 : (d == 1) ? varp->left() : 0;
 }
 int svRight(const svOpenArrayHandle h, int d) {
-    _VL_SVDPI_UNIMP(); return 0;
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(h);
+    return (d == 1) ? varp->right() : 0;
 }
 int svLow(const svOpenArrayHandle h, int d) {
-    _VL_SVDPI_UNIMP(); return 0;
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(h);
+    return (d == 1) ? varp->low() : 0;
 }
 int svHigh(const svOpenArrayHandle h, int d) {
-    _VL_SVDPI_UNIMP(); return 0;
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(h);
+    return (d == 0) ? varp->bits()-1 : (d == 1) ? varp->high() : 0;
 }
 int svIncrement(const svOpenArrayHandle h, int d) {
-    _VL_SVDPI_UNIMP(); return 0;
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(h);
+    return (d == 1 && varp->left() < varp->right()) ? -1 : 1;
 }
 int svDimensions(const svOpenArrayHandle h) {
-    _VL_SVDPI_UNIMP(); return 0;
+    _vl_openhandle_varp(h);
+    return 1;
 }
 
-void *svGetArrayPtr(const svOpenArrayHandle) {
-    _VL_SVDPI_UNIMP(); return NULL;
+void *svGetArrayPtr(const svOpenArrayHandle h) {
+    return _vl_openhandle_varp(h)->datap();
 }
 
-int svSizeOfArray(const svOpenArrayHandle) {
-    _VL_SVDPI_UNIMP(); return 0;
+int svSizeOfArray(const svOpenArrayHandle h) {
+    const VerilatedDpiOpenVar* varp = _vl_openhandle_varp(h);
+    return varp->elements() * varp->entSize();
 }
 
-void *svGetArrElemPtr(const svOpenArrayHandle, int indx1, ...) {
-    _VL_SVDPI_UNIMP(); return NULL;
+void *svGetArrElemPtr(const svOpenArrayHandle h, int indx1, ...) {
+    return _vl_sv_adims_elemp(VL_FUNC, h, 1, indx1);
 }
-void *svGetArrElemPtr1(const svOpenArrayHandle, int indx1) {
-    _VL_SVDPI_UNIMP(); return NULL;
+void *svGetArrElemPtr1(const svOpenArrayHandle h, int indx1) {
+    return _vl_sv_adims_elemp(VL_FUNC, h, 1, indx1);
 }
-void *svGetArrElemPtr2(const svOpenArrayHandle, int indx1, int indx2) {
-    _VL_SVDPI_UNIMP(); return NULL;
+void *svGetArrElemPtr2(const svOpenArrayHandle h, int indx1, int indx2) {
+    return _vl_sv_adims_elemp(VL_FUNC, h, 2, indx1);
 }
-void *svGetArrElemPtr3(const svOpenArrayHandle, int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP(); return NULL;
+void *svGetArrElemPtr3(const svOpenArrayHandle h, int indx1, int indx2, int indx3) {
+    return _vl_sv_adims_elemp(VL_FUNC, h, 3, indx1);
 }
 
 //======================================================================
@@ -135,35 +234,39 @@ void *svGetArrElemPtr3(const svOpenArrayHandle, int indx1, int indx2, int indx3)
 
 void svPutBitArrElemVecVal(const svOpenArrayHandle d, const svBitVecVal* s,
 			   int indx1, ...) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, d, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_put_vec(_vl_openhandle_varp(d), datap, s);
 }
 void svPutBitArrElem1VecVal(const svOpenArrayHandle d, const svBitVecVal* s,
 			    int indx1) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, d, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_put_vec(_vl_openhandle_varp(d), datap, s);
 }
 void svPutBitArrElem2VecVal(const svOpenArrayHandle d, const svBitVecVal* s,
 			    int indx1, int indx2) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, d, 2, indx1);
 }
 void svPutBitArrElem3VecVal(const svOpenArrayHandle d, const svBitVecVal* s,
 			    int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, d, 3, indx1);
 }
 void svPutLogicArrElemVecVal(const svOpenArrayHandle d, const svLogicVecVal* s,
 			     int indx1, ...) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, d, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_put_logic_vec(_vl_openhandle_varp(d), datap, s);
 }
 void svPutLogicArrElem1VecVal(const svOpenArrayHandle d, const svLogicVecVal* s,
 			      int indx1) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, d, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_put_logic_vec(_vl_openhandle_varp(d), datap, s);
 }
 void svPutLogicArrElem2VecVal(const svOpenArrayHandle d, const svLogicVecVal* s,
 			      int indx1, int indx2) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, d, 2, indx1);
 }
 void svPutLogicArrElem3VecVal(const svOpenArrayHandle d, const svLogicVecVal* s,
 			      int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, d, 3, indx1);
 }
 
 //======================================================================
@@ -171,84 +274,100 @@ void svPutLogicArrElem3VecVal(const svOpenArrayHandle d, const svLogicVecVal* s,
 
 void svGetBitArrElemVecVal(svBitVecVal* d, const svOpenArrayHandle s,
 			   int indx1, ...) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, s, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_get_vec(d, _vl_openhandle_varp(s), datap);
 }
 void svGetBitArrElem1VecVal(svBitVecVal* d, const svOpenArrayHandle s,
 			    int indx1) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, s, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_get_vec(d, _vl_openhandle_varp(s), datap);
 }
 void svGetBitArrElem2VecVal(svBitVecVal* d, const svOpenArrayHandle s,
 			    int indx1, int indx2) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, s, 2, indx1);
 }
 void svGetBitArrElem3VecVal(svBitVecVal* d, const svOpenArrayHandle s,
 			    int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, s, 3, indx1);
 }
 void svGetLogicArrElemVecVal(svLogicVecVal* d, const svOpenArrayHandle s,
 			     int indx1, ...) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, s, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_get_logic_vec(d, _vl_openhandle_varp(s), datap);
 }
 void svGetLogicArrElem1VecVal(svLogicVecVal* d, const svOpenArrayHandle s,
 			      int indx1) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, s, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_get_logic_vec(d, _vl_openhandle_varp(s), datap);
 }
 void svGetLogicArrElem2VecVal(svLogicVecVal* d, const svOpenArrayHandle s,
 			      int indx1, int indx2) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, s, 2, indx1);
 }
 void svGetLogicArrElem3VecVal(svLogicVecVal* d, const svOpenArrayHandle s,
 			      int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, s, 3, indx1);
 }
 
 svBit svGetBitArrElem(const svOpenArrayHandle s, int indx1, ...) {
-    _VL_SVDPI_UNIMP(); return 0;
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, s, 1, indx1);
+    return datap ? _vl_sv_get_bit(_vl_openhandle_varp(s), datap) : 0;
 }
 svBit svGetBitArrElem1(const svOpenArrayHandle s, int indx1) {
-    _VL_SVDPI_UNIMP(); return 0;
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, s, 1, indx1);
+    return datap ? _vl_sv_get_bit(_vl_openhandle_varp(s), datap) : 0;
 }
 svBit svGetBitArrElem2(const svOpenArrayHandle s, int indx1, int indx2) {
-    _VL_SVDPI_UNIMP(); return 0;
+    _vl_sv_adims_elemp(VL_FUNC, s, 2, indx1); return 0;
 }
 svBit svGetBitArrElem3(const svOpenArrayHandle s, int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP(); return 0;
+    _vl_sv_adims_elemp(VL_FUNC, s, 3, indx1); return 0;
 }
 svLogic svGetLogicArrElem(const svOpenArrayHandle s, int indx1, ...) {
-    _VL_SVDPI_UNIMP(); return sv_x;
+    // Verilator doesn't support X/Z so only aval
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, s, 1, indx1);
+    return datap ? _vl_sv_get_bit(_vl_openhandle_varp(s), datap) : sv_x;
 }
 svLogic svGetLogicArrElem1(const svOpenArrayHandle s, int indx1) {
-    _VL_SVDPI_UNIMP(); return sv_x;
+    // Verilator doesn't support X/Z so only aval
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, s, 1, indx1);
+    return datap ? _vl_sv_get_bit(_vl_openhandle_varp(s), datap) : sv_x;
 }
 svLogic svGetLogicArrElem2(const svOpenArrayHandle s, int indx1, int indx2) {
-    _VL_SVDPI_UNIMP(); return sv_x;
+    _vl_sv_adims_elemp(VL_FUNC, s, 2, indx1); return sv_x;
 }
 svLogic svGetLogicArrElem3(const svOpenArrayHandle s, int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP(); return sv_x;
+    _vl_sv_adims_elemp(VL_FUNC, s, 3, indx1); return sv_x;
 }
 void svPutLogicArrElem(const svOpenArrayHandle d, svLogic value, int indx1, ...) {
-    _VL_SVDPI_UNIMP();
+    // Verilator doesn't support X/Z so only aval
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, d, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_put_bit(_vl_openhandle_varp(d), datap, value);
 }
 void svPutLogicArrElem1(const svOpenArrayHandle d, svLogic value, int indx1) {
-    _VL_SVDPI_UNIMP();
+    // Verilator doesn't support X/Z so only aval
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, d, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_put_bit(_vl_openhandle_varp(d), datap, value);
 }
 void svPutLogicArrElem2(const svOpenArrayHandle d, svLogic value, int indx1, int indx2) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, d, 2, indx1);
 }
 void svPutLogicArrElem3(const svOpenArrayHandle d, svLogic value, int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, d, 3, indx1);
 }
 void svPutBitArrElem(const svOpenArrayHandle d, svBit value, int indx1, ...) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, d, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_put_bit(_vl_openhandle_varp(d), datap, value);
 }
 void svPutBitArrElem1(const svOpenArrayHandle d, svBit value, int indx1) {
-    _VL_SVDPI_UNIMP();
+    void* datap = _vl_sv_adims_elemp(VL_FUNC, d, 1, indx1);
+    if (VL_LIKELY(datap)) _vl_sv_put_bit(_vl_openhandle_varp(d), datap, value);
 }
 void svPutBitArrElem2(const svOpenArrayHandle d, svBit value, int indx1, int indx2) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, d, 2, indx1);
 }
 void svPutBitArrElem3(const svOpenArrayHandle d, svBit value, int indx1, int indx2, int indx3) {
-    _VL_SVDPI_UNIMP();
+    _vl_sv_adims_elemp(VL_FUNC, d, 3, indx1);
 }
 
 //======================================================================
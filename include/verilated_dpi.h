@@ -59,6 +59,44 @@ static inline void VL_SET_SVLV_W(int obits, svLogicVecVal* owp, WDataInP lwp) {
     owp[words-1].aval = lwp[words-1] & VL_MASK_I(obits);
 }
 
+//===================================================================
+// OPEN ARRAYS
+
+/// Open array ([]) argument to a DPI import.  Created by the Verilated
+/// wrapper around the connected array's storage, and passed to the user
+/// function as its svOpenArrayHandle; no elements are copied.
+class VerilatedDpiOpenVar {
+    void*	m_datap;	///< Storage of the connected array
+    int		m_left;		///< Left index of the unpacked dimension
+    int		m_right;	///< Right index of the unpacked dimension
+    int		m_bits;		///< Bits in each element, the packed dimension
+public:
+    VerilatedDpiOpenVar(void* datap, int left, int right, int bits)
+	: m_datap(datap), m_left(left), m_right(right), m_bits(bits) {}
+    ~VerilatedDpiOpenVar() {}
+    // METHODS
+    void* datap() const { return m_datap; }
+    int left() const { return m_left; }
+    int right() const { return m_right; }
+    int low() const { return (m_left < m_right) ? m_left : m_right; }
+    int high() const { return (m_left > m_right) ? m_left : m_right; }
+    int elements() const { return high() - low() + 1; }
+    int bits() const { return m_bits; }
+    /// Bytes in each element, per the Verilated CData/SData/IData/QData/WData storage
+    int entSize() const {
+	return ((m_bits <= 8) ? sizeof(CData)
+		: (m_bits <= 16) ? sizeof(SData)
+		: (m_bits <= VL_WORDSIZE) ? sizeof(IData)
+		: (m_bits <= VL_QUADSIZE) ? sizeof(QData)
+		: VL_WORDS_I(m_bits) * sizeof(IData));
+    }
+    /// Pointer to element at given index, or NULL if out of bounds
+    void* elemp(int indx) const {
+	if (VL_UNLIKELY(indx < low() || indx > high())) return NULL;
+	return (vluint8_t*)(m_datap) + (indx - low()) * entSize();
+    }
+};
+
 //======================================================================
 
 #endif // _VERILATED_DPI_H_
@@ -50,6 +50,7 @@ inline string VL_CVT_PACK_STR_NI(IData lhs) {
 }
 
 extern void VL_SFORMAT_X(int obits_ignored, string &output, const char* formatp, ...);
+extern void VL_SFORMAT_X(int obits_ignored, string &output, const VerilatedFormatOp* opsp, ...);
 extern string VL_SFORMATF_NX(const char* formatp, ...);
 
 #endif // Guard
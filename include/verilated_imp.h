@@ -33,6 +33,7 @@
 #include "verilated_heavy.h"
 #include "verilated_syms.h"
 
+#include <algorithm>
 #include <map>
 #include <vector>
 #include <deque>
@@ -43,45 +44,87 @@ class VerilatedScope;
 //======================================================================
 // Types
 
-class VerilatedImp {
-    // Whole class is internal use only - Global information shared between verilated*.cpp files.
+class VerilatedContextImp {
+    // Whole class is internal use only - Per-simulation information, see VerilatedContext.
+    friend class VerilatedImp;
 
     // TYPES
     typedef vector<string> ArgVec;
+    typedef pair<const char*,size_t> ArgPlus;	// Plusarg after the "+", and its argument number
+    typedef vector<ArgPlus> ArgPlusVec;
     typedef map<pair<const void*,void*>,void*> UserMap;
     typedef map<const char*, const VerilatedScope*, VerilatedCStrCmp>  ScopeNameMap;
+    typedef VerilatedCStrHash<const VerilatedScope*>  ScopeNameHash;
+
+    // File I/O
+    vector<FILE*>	m_fdps;		///< File descriptors
+    deque<IData>	m_fdFree;	///< List of free descriptors (SLOW - FOPEN/CLOSE only)
+    string		m_displayBuf;	///< Buffered $display output not yet written
+
+    // Not save-restored; users expected to re-register appropriately
+    // Scopes and user data, changed under VerilatedImp's m_mutex
+    UserMap	 	m_userMap;	///< Map of <(scope,userkey), userData>
+    ScopeNameMap	m_nameMap;	///< Map of <scope_name, scope pointer>
+    ScopeNameHash	m_nameHash;	///< Hashed index of m_nameMap, for scopeFind
+    vluint32_t		m_nameGeneration;	///< Incremented when scopes are added or removed
+
+    // Arguments
+    ArgVec		m_argVec;	///< Argument list (NOT save-restored, may want different results)
+    bool		m_argVecLoaded;	///< Ever loaded argument list
+    ArgPlusVec		m_argPlusVec;	///< Plusargs, sorted by text then argument number
+    int			m_argc;		///< Arguments as passed, for Verilated::getCommandArgs
+    const char**	m_argv;
+
+public: // But only for verilated*.cpp
+    // CONSTRUCTORS
+    VerilatedContextImp() : m_nameGeneration(0), m_argVecLoaded(false), m_argc(0), m_argv(NULL) {
+	m_fdps.resize(3);
+	m_fdps[0] = stdin;
+	m_fdps[1] = stdout;
+	m_fdps[2] = stderr;
+    }
+    ~VerilatedContextImp() {}
+};
+
+class VerilatedImp {
+    // Whole class is internal use only - Global information shared between verilated*.cpp files.
+
+    // TYPES
+    typedef VerilatedContextImp::ArgVec ArgVec;
+    typedef VerilatedContextImp::ArgPlus ArgPlus;
+    typedef VerilatedContextImp::ArgPlusVec ArgPlusVec;
+    typedef VerilatedContextImp::UserMap UserMap;
+    typedef VerilatedContextImp::ScopeNameMap ScopeNameMap;
     typedef map<const char*, int, VerilatedCStrCmp>  ExportNameMap;
 
     // MEMBERS
     static VerilatedImp	s_s;		///< Static Singleton; One and only static this
 
     // Nothing here is save-restored; users expected to re-register appropriately
+    // Shared by all contexts, so m_mutex protects everything changed after startup
 
-    ArgVec		m_argVec;	///< Argument list (NOT save-restored, may want different results)
-    bool		m_argVecLoaded;	///< Ever loaded argument list
-    UserMap	 	m_userMap;	///< Map of <(scope,userkey), userData>
-    ScopeNameMap	m_nameMap;	///< Map of <scope_name, scope pointer>
+    VerilatedMutex	m_mutex;	///< Protect scope, user and export maps, and context use counts
+    VerilatedMutex	m_displayMutex;	///< Keep each buffered write to stdout whole
+#ifdef VL_THREADED
+    pthread_key_t	m_threadKey;	///< Each thread's selected context, to release at thread exit
+#endif
     // Slow - somewhat static:
     ExportNameMap	m_exportMap;	///< Map of <export_func_proto, func number>
     int			m_exportNext;	///< Next export funcnum
 
-    // File I/O
-    vector<FILE*>	m_fdps;		///< File descriptors
-    deque<IData>	m_fdFree;	///< List of free descriptors (SLOW - FOPEN/CLOSE only)
-
 public: // But only for verilated*.cpp
     // CONSTRUCTORS
-    VerilatedImp() : m_argVecLoaded(false), m_exportNext(0) {
-	m_fdps.resize(3);
-	m_fdps[0] = stdin;
-	m_fdps[1] = stdout;
-	m_fdps[2] = stderr;
+    VerilatedImp() : m_exportNext(0) {
+#ifdef VL_THREADED
+	pthread_key_create(&m_threadKey, &threadExit);
+#endif
     }
     ~VerilatedImp() {}
     static void internalsDump() {
+	VerilatedContextImp* impp = contextImp();
 	VL_PRINTF("internalsDump:\n");
 	VL_PRINTF("  Argv:");
-	for (ArgVec::iterator it=s_s.m_argVec.begin(); it!=s_s.m_argVec.end(); ++it) {
+	for (ArgVec::iterator it=impp->m_argVec.begin(); it!=impp->m_argVec.end(); ++it) {
 	    VL_PRINTF(" %s",it->c_str());
 	}
 	VL_PRINTF("\n");
@@ -91,59 +134,145 @@ public: // But only for verilated*.cpp
 	userDump();
     }
 
+    // METHODS - contexts
+    static VerilatedContextImp* contextImp(VerilatedContext* contextp) {
+	if (VL_UNLIKELY(!contextp->m_impp)) contextp->m_impp = new VerilatedContextImp;
+	return contextp->m_impp;
+    }
+    static VerilatedContextImp* contextImp() { return contextImp(Verilated::threadContextp()); }
+    static void threadContextUse(VerilatedContext* oldp, VerilatedContext* newp) {
+	// The calling thread switches from oldp to newp; either may be NULL.
+	// The default context isn't counted, as it is never destroyed early.
+	VerilatedLockGuard guard (s_s.m_mutex);
+	if (oldp && oldp != Verilated::defaultContextp()) --oldp->m_threadUses;
+	if (newp && newp != Verilated::defaultContextp()) ++newp->m_threadUses;
+#ifdef VL_THREADED
+	pthread_setspecific(s_s.m_threadKey, (newp == Verilated::defaultContextp()) ? NULL : newp);
+#endif
+    }
+    static void contextDestroy(VerilatedContext* contextp) {
+	// Called by ~VerilatedContext, once the calling thread no longer uses it
+	VerilatedLockGuard guard (s_s.m_mutex);
+	if (contextp == Verilated::defaultContextp()) return;  // At exit; leaked models are normal
+	if (VL_UNLIKELY(contextp->m_threadUses)) {
+	    vl_fatal("unknown",0,"", "VerilatedContext destroyed while another thread still has it selected");
+	}
+	if (VL_UNLIKELY(contextp->m_impp && !contextp->m_impp->m_nameMap.empty())) {
+	    vl_fatal("unknown",0,"", "VerilatedContext destroyed before the models bound to it");
+	}
+    }
+private:
+#ifdef VL_THREADED
+    static void threadExit(void* contextp) {
+	// pthread key destructor: a thread exited with a context other than the default selected
+	threadContextUse((VerilatedContext*)contextp, NULL);
+    }
+#endif
+
+public: // But only for verilated*.cpp
     // METHODS - arguments
     static void commandArgs(int argc, const char** argv) {
-	s_s.m_argVec.clear();
-	for (int i=0; i<argc; i++) s_s.m_argVec.push_back(argv[i]);
-	s_s.m_argVecLoaded = true; // Can't just test later for empty vector, no arguments is ok
+	VerilatedContextImp* impp = contextImp();
+	impp->m_argc = argc;
+	impp->m_argv = argv;
+	impp->m_argVec.clear();
+	for (int i=0; i<argc; i++) impp->m_argVec.push_back(argv[i]);
+	impp->m_argVecLoaded = true; // Can't just test later for empty vector, no arguments is ok
+	// Sort the plusargs, so the ones with a given prefix are found by a
+	// binary search.  The vector is not changed again, so its strings may
+	// be pointed to.
+	impp->m_argPlusVec.clear();
+	for (size_t i=0; i<impp->m_argVec.size(); ++i) {
+	    if (impp->m_argVec[i][0]=='+') impp->m_argPlusVec.push_back(make_pair(impp->m_argVec[i].c_str()+1, i));
+	}
+	sort(impp->m_argPlusVec.begin(), impp->m_argPlusVec.end(), argPlusLess);
+    }
+    static VerilatedContextImp* argsImp() {
+	// Context whose arguments the current context uses
+	VerilatedContextImp* impp = contextImp();
+	if (VL_LIKELY(impp->m_argVecLoaded)) return impp;
+	return contextImp(Verilated::defaultContextp());
+    }
+    static void argsGet(int& argcr, const char**& argvr) {
+	VerilatedContextImp* impp = argsImp();
+	argcr = impp->m_argc;
+	argvr = impp->m_argv;
     }
-    static string argPlusMatch(const char* prefixp) {
+    static bool argPlusLess(const ArgPlus& a, const ArgPlus& b) {
+	int cmp = strcmp(a.first, b.first);
+	return cmp ? (cmp < 0) : (a.second < b.second);
+    }
+    static bool argPlusBelow(const ArgPlus& a, const char* prefixp) {
+	return strcmp(a.first, prefixp) < 0;
+    }
+    static const char* argPlusMatch(const char* prefixp) {
 	// Note prefixp does not include the leading "+"
-	size_t len = strlen(prefixp);
-	if (VL_UNLIKELY(!s_s.m_argVecLoaded)) {
-	    s_s.m_argVecLoaded = true;  // Complain only once
+	// Returns the whole matching argument, or NULL if none
+	VerilatedContextImp* impp = argsImp();
+	if (VL_UNLIKELY(!impp->m_argVecLoaded)) {
+	    impp->m_argVecLoaded = true;  // Complain only once
 	    vl_fatal("unknown",0,"",
 		     "%Error: Verilog called $test$plusargs or $value$plusargs without"
 		     " testbench C first calling Verilated::commandArgs(argc,argv).");
 	}
-	for (ArgVec::iterator it=s_s.m_argVec.begin(); it!=s_s.m_argVec.end(); ++it) {
-	    if ((*it)[0]=='+') {
-		if (0==strncmp(prefixp, it->c_str()+1, len)) return *it;
+	size_t len = strlen(prefixp);
+	if (VL_UNLIKELY(!len)) {  // Matches every plusarg, so just the first
+	    for (ArgVec::iterator it=impp->m_argVec.begin(); it!=impp->m_argVec.end(); ++it) {
+		if ((*it)[0]=='+') return it->c_str();
 	    }
+	    return NULL;
 	}
-	return "";
+	// Everything with the prefix sorts together, starting at the first
+	// plusarg not below the prefix itself.  Earlier arguments win.
+	const ArgPlus* bestp = NULL;
+	for (ArgPlusVec::const_iterator it
+		 = lower_bound(impp->m_argPlusVec.begin(), impp->m_argPlusVec.end(), prefixp, argPlusBelow);
+	     it != impp->m_argPlusVec.end() && 0==strncmp(prefixp, it->first, len); ++it) {
+	    if (!bestp || it->second < bestp->second) bestp = &(*it);
+	}
+	return bestp ? bestp->first-1 : NULL;
     }
 
     // METHODS - user scope tracking
     // We implement this as a single large map instead of one map per scope
     // There's often many more scopes than userdata's and thus having a ~48byte
     // per map overhead * N scopes would take much more space and cache thrashing.
+    // Each map is in the context of its scopes.
     static inline void userInsert(const void* scopep, void* userKey, void* userData) {
-	UserMap::iterator it=s_s.m_userMap.find(make_pair(scopep,userKey));
-	if (it != s_s.m_userMap.end()) it->second = userData;
-	// When we support VL_THREADs, we need a lock around this insert, as it's runtime
-	else s_s.m_userMap.insert(it, make_pair(make_pair(scopep,userKey),userData));
+	VerilatedLockGuard guard (s_s.m_mutex);
+	UserMap& userMap = scopeContextImp(scopep)->m_userMap;
+	UserMap::iterator it=userMap.find(make_pair(scopep,userKey));
+	if (it != userMap.end()) it->second = userData;
+	else userMap.insert(it, make_pair(make_pair(scopep,userKey),userData));
     }
     static inline void* userFind(const void* scopep, void* userKey) {
-	UserMap::iterator it=s_s.m_userMap.find(make_pair(scopep,userKey));
-	if (VL_LIKELY(it != s_s.m_userMap.end())) return it->second;
+	VerilatedLockGuard guard (s_s.m_mutex);
+	UserMap& userMap = scopeContextImp(scopep)->m_userMap;
+	UserMap::iterator it=userMap.find(make_pair(scopep,userKey));
+	if (VL_LIKELY(it != userMap.end())) return it->second;
 	else return NULL;
     }
 private:
+    static VerilatedContextImp* scopeContextImp(const void* scopep) {
+	const VerilatedScope* sp = (const VerilatedScope*)scopep;
+	return contextImp((sp && sp->contextp()) ? sp->contextp() : Verilated::threadContextp());
+    }
     /// Symbol table destruction cleans up the entries for each scope.
-    static void userEraseScope(const VerilatedScope* scopep) {
+    static void userEraseScope(VerilatedContextImp* impp, const VerilatedScope* scopep) {
 	// Slow ok - called once/scope on destruction, so we simply iterate.
-	for (UserMap::iterator it=s_s.m_userMap.begin(); it!=s_s.m_userMap.end(); ) {
+	// Caller holds m_mutex
+	for (UserMap::iterator it=impp->m_userMap.begin(); it!=impp->m_userMap.end(); ) {
 	    if (it->first.first == scopep) {
-		s_s.m_userMap.erase(it++);
+		impp->m_userMap.erase(it++);
 	    } else {
 		++it;
 	    }
 	}
     }
     static void userDump() {
+	VerilatedContextImp* impp = contextImp();
 	bool first = true;
-	for (UserMap::iterator it=s_s.m_userMap.begin(); it!=s_s.m_userMap.end(); ++it) {
+	for (UserMap::iterator it=impp->m_userMap.begin(); it!=impp->m_userMap.end(); ++it) {
 	    if (first) { VL_PRINTF("  userDump:\n"); first=false; }
 	    VL_PRINTF("    DPI_USER_DATA scope %p key %p: %p\n",
 		      it->first.first, it->first.second, it->second);
@@ -152,27 +281,43 @@ private:
 
 public: // But only for verilated*.cpp
     // METHODS - scope name
+    // Each context has its own scopes, so models in separate simulations may share names
     static void scopeInsert(const VerilatedScope* scopep) {
 	// Slow ok - called once/scope at construction
-	ScopeNameMap::iterator it=s_s.m_nameMap.find(scopep->name());
-	if (it == s_s.m_nameMap.end()) {
-	    s_s.m_nameMap.insert(it, make_pair(scopep->name(),scopep));
+	VerilatedLockGuard guard (s_s.m_mutex);
+	VerilatedContextImp* impp = contextImp(scopep->contextp());
+	ScopeNameMap::iterator it=impp->m_nameMap.find(scopep->name());
+	if (it == impp->m_nameMap.end()) {
+	    impp->m_nameMap.insert(it, make_pair(scopep->name(),scopep));
+	    impp->m_nameHash.insert(scopep->name(), scopep);
+	    ++impp->m_nameGeneration;
 	}
     }
     static inline const VerilatedScope* scopeFind(const char* namep) {
-	ScopeNameMap::iterator it=s_s.m_nameMap.find(namep);
-	if (VL_LIKELY(it != s_s.m_nameMap.end())) return it->second;
+	VerilatedLockGuard guard (s_s.m_mutex);
+	const VerilatedScope* const* scopepp = contextImp()->m_nameHash.find(namep);
+	if (VL_LIKELY(scopepp)) return *scopepp;
 	else return NULL;
     }
     static void scopeErase(const VerilatedScope* scopep) {
 	// Slow ok - called once/scope at destruction
-	userEraseScope(scopep);
-	ScopeNameMap::iterator it=s_s.m_nameMap.find(scopep->name());
-	if (it != s_s.m_nameMap.end()) s_s.m_nameMap.erase(it);
+	VerilatedLockGuard guard (s_s.m_mutex);
+	if (!scopep->contextp()) return;  // Never configured
+	VerilatedContextImp* impp = scopep->contextp()->m_impp;
+	if (!impp) return;
+	userEraseScope(impp, scopep);
+	ScopeNameMap::iterator it=impp->m_nameMap.find(scopep->name());
+	if (it != impp->m_nameMap.end() && it->second == scopep) {
+	    impp->m_nameMap.erase(it);
+	    impp->m_nameHash.erase(scopep->name());
+	    ++impp->m_nameGeneration;
+	}
     }
+    static vluint32_t scopesGeneration() { return contextImp()->m_nameGeneration; }
     static void scopesDump() {
+	VerilatedContextImp* impp = contextImp();
 	VL_PRINTF("  scopesDump:\n");
-	for (ScopeNameMap::iterator it=s_s.m_nameMap.begin(); it!=s_s.m_nameMap.end(); ++it) {
+	for (ScopeNameMap::iterator it=impp->m_nameMap.begin(); it!=impp->m_nameMap.end(); ++it) {
 	    const VerilatedScope* scopep = it->second;
 	    scopep->scopeDump();
 	}
@@ -190,6 +335,7 @@ public: // But only for verilated*.cpp
     // miss at the cost of a multiply, and all lookups move to slowpath.
     static int exportInsert(const char* namep) {
 	// Slow ok - called once/function at creation
+	VerilatedLockGuard guard (s_s.m_mutex);
 	ExportNameMap::iterator it=s_s.m_exportMap.find(namep);
 	if (it == s_s.m_exportMap.end()) {
 	    s_s.m_exportMap.insert(it, make_pair(namep, s_s.m_exportNext++));
@@ -199,8 +345,11 @@ public: // But only for verilated*.cpp
 	}
     }
     static int exportFind(const char* namep) {
-	ExportNameMap::iterator it=s_s.m_exportMap.find(namep);
-	if (VL_LIKELY(it != s_s.m_exportMap.end())) return it->second;
+	{
+	    VerilatedLockGuard guard (s_s.m_mutex);
+	    ExportNameMap::iterator it=s_s.m_exportMap.find(namep);
+	    if (VL_LIKELY(it != s_s.m_exportMap.end())) return it->second;
+	}
 	string msg = (string("%Error: Testbench C called ")+namep
 		      +" but no such DPI export function name exists in ANY model");
 	vl_fatal("unknown",0,"", msg.c_str());
@@ -223,32 +372,47 @@ public: // But only for verilated*.cpp
     // We don't free up m_exportMap until the end, because we can't be sure
     // what other models are using the assigned funcnum's.
 
+public: // But only for verilated*.cpp
+    // METHODS - $display buffering, see verilated.cpp
+    static bool displayBuffered() { return Verilated::displayBuffering() != VL_DISPLAY_UNBUFFERED; }
+    static void displayFormat(const char* formatp, va_list ap);
+    static void displayFormat(const VerilatedFormatOp* opsp, va_list ap);
+    static void displayFlush(VerilatedContext* contextp);
+private:
+    static void displayAppended(string& bufr);
+    static void displayWrite(string& bufr, size_t len);
+
 public: // But only for verilated*.cpp
     // METHODS - file IO
+    // Descriptors belong to the current thread's context, so each simulation
+    // numbers its own files and no lock is needed.
     static IData fdNew(FILE* fp) {
 	if (VL_UNLIKELY(!fp)) return 0;
+	VerilatedContextImp* impp = contextImp();
 	// Bit 31 indicates it's a descriptor not a MCD
-	if (s_s.m_fdFree.empty()) {
+	if (impp->m_fdFree.empty()) {
 	    // Need to create more space in m_fdps and m_fdFree
-	    size_t start = s_s.m_fdps.size();
-	    s_s.m_fdps.resize(start*2);
-	    for (size_t i=start; i<start*2; i++) s_s.m_fdFree.push_back((IData)i);
+	    size_t start = impp->m_fdps.size();
+	    impp->m_fdps.resize(start*2);
+	    for (size_t i=start; i<start*2; i++) impp->m_fdFree.push_back((IData)i);
 	}
-	IData idx = s_s.m_fdFree.back(); s_s.m_fdFree.pop_back();
-	s_s.m_fdps[idx] = fp;
+	IData idx = impp->m_fdFree.back(); impp->m_fdFree.pop_back();
+	impp->m_fdps[idx] = fp;
 	return (idx | (1UL<<31));  // bit 31 indicates not MCD
     }
     static void fdDelete(IData fdi) {
+	VerilatedContextImp* impp = contextImp();
 	IData idx = VL_MASK_I(31) & fdi;
-	if (VL_UNLIKELY(!(fdi & (1ULL<<31)) || idx >= s_s.m_fdps.size())) return;
-	if (VL_UNLIKELY(!s_s.m_fdps[idx])) return;  // Already free
-	s_s.m_fdps[idx] = NULL;
-	s_s.m_fdFree.push_back(idx);
+	if (VL_UNLIKELY(!(fdi & (1ULL<<31)) || idx >= impp->m_fdps.size())) return;
+	if (VL_UNLIKELY(!impp->m_fdps[idx])) return;  // Already free
+	impp->m_fdps[idx] = NULL;
+	impp->m_fdFree.push_back(idx);
     }
     static inline FILE* fdToFp(IData fdi) {
+	VerilatedContextImp* impp = contextImp();
 	IData idx = VL_MASK_I(31) & fdi;
-	if (VL_UNLIKELY(!(fdi & (1ULL<<31)) || idx >= s_s.m_fdps.size())) return NULL;
-	return s_s.m_fdps[idx];
+	if (VL_UNLIKELY(!(fdi & (1ULL<<31)) || idx >= impp->m_fdps.size())) return NULL;
+	return impp->m_fdps[idx];
     }
 };
 
@@ -230,5 +230,30 @@ inline VerilatedDeserialize& operator>>(VerilatedDeserialize& os, string& rhs) {
     rhs.resize(len);
     return os.read((void*)rhs.data(), len);
 }
+// Sparse memories save only allocated pages, each preceded by its number
+template <class T_Value, size_t T_Depth>
+VerilatedSerialize&   operator<<(VerilatedSerialize& os,   VlSparseArray<T_Value,T_Depth>& rhs) {
+    typedef VlSparseArray<T_Value,T_Depth> Array;
+    for (vluint64_t page=0; page<Array::PAGES; ++page) {
+	if (T_Value* pagep = rhs.pagep(page)) {
+	    os<<page;
+	    os.write(pagep, sizeof(T_Value)*Array::PAGE_ENTRIES);
+	}
+    }
+    vluint64_t endPage = Array::PAGES;
+    return os<<endPage;
+}
+template <class T_Value, size_t T_Depth>
+VerilatedDeserialize& operator>>(VerilatedDeserialize& os, VlSparseArray<T_Value,T_Depth>& rhs) {
+    typedef VlSparseArray<T_Value,T_Depth> Array;
+    rhs.clear();
+    while (1) {
+	vluint64_t page;
+	os>>page;
+	if (page >= Array::PAGES) break;
+	os.read(rhs.pagepNew(page), sizeof(T_Value)*Array::PAGE_ENTRIES);
+    }
+    return os;
+}
 
 #endif // guard
@@ -31,6 +31,7 @@
 #include "verilated_heavy.h"
 
 #include <map>
+#include <vector>
 
 //======================================================================
 // Types
@@ -42,6 +43,91 @@ struct VerilatedCStrCmp {
     }
 };
 
+//===========================================================================
+/// Hash index keyed by const char*'s
+///
+///	Used beside the ordered maps so name lookups are O(name length)
+///	while iteration order stays sorted.  Keys are not copied; the
+///	caller must keep each key's storage alive until it is erased.
+
+template <class T> class VerilatedCStrHash {
+    struct Entry {
+	const char*	m_keyp;		// Key, NULL if empty or erased
+	vluint32_t	m_hash;		// Hash of key
+	bool		m_erased;	// Tombstone
+	T		m_value;
+	Entry() : m_keyp(NULL), m_hash(0), m_erased(false), m_value() {}
+    };
+    vector<Entry>	m_table;	// Open addressed, size power of two
+    size_t		m_used;		// Entries in use, including tombstones
+public:
+    VerilatedCStrHash() : m_used(0) {}
+    ~VerilatedCStrHash() {}
+    static inline vluint32_t hash(const char* keyp) {
+	// FNV-1a
+	vluint32_t h = 2166136261UL;
+	for (const char* cp=keyp; *cp; ++cp) { h ^= (vluint8_t)(*cp); h *= 16777619UL; }
+	return h;
+    }
+private:
+    const Entry* findEntry(const char* keyp, vluint32_t h) const {
+	if (VL_UNLIKELY(m_table.empty())) return NULL;
+	size_t mask = m_table.size()-1;
+	for (size_t i=h & mask; ; i=(i+1) & mask) {
+	    const Entry& ent = m_table[i];
+	    if (!ent.m_keyp) {
+		if (!ent.m_erased) return NULL;
+	    } else if (ent.m_hash==h && 0==std::strcmp(ent.m_keyp, keyp)) {
+		return &ent;
+	    }
+	}
+    }
+    void rehash(size_t size) {
+	vector<Entry> old;
+	old.swap(m_table);
+	m_table.resize(size);
+	m_used = 0;
+	for (typename vector<Entry>::iterator it=old.begin(); it!=old.end(); ++it) {
+	    if (it->m_keyp) insertNew(it->m_keyp, it->m_hash, it->m_value);
+	}
+    }
+    void insertNew(const char* keyp, vluint32_t h, const T& value) {
+	size_t mask = m_table.size()-1;
+	size_t i = h & mask;
+	while (m_table[i].m_keyp || m_table[i].m_erased) i=(i+1) & mask;
+	m_table[i].m_keyp = keyp;
+	m_table[i].m_hash = h;
+	m_table[i].m_value = value;
+	++m_used;
+    }
+public:
+    /// Insert, or replace the value of an existing key
+    void insert(const char* keyp, const T& value) {
+	vluint32_t h = hash(keyp);
+	if (Entry* entp = const_cast<Entry*>(findEntry(keyp, h))) {
+	    entp->m_value = value;
+	    return;
+	}
+	if ((m_used+1)*4 >= m_table.size()*3) {  // Keep load under 3/4
+	    rehash(m_table.empty() ? 64 : m_table.size()*2);
+	}
+	insertNew(keyp, h, value);
+    }
+    /// Return pointer to value, or NULL if not found
+    inline const T* find(const char* keyp) const {
+	const Entry* entp = findEntry(keyp, hash(keyp));
+	return entp ? &(entp->m_value) : NULL;
+    }
+    void erase(const char* keyp) {
+	if (Entry* entp = const_cast<Entry*>(findEntry(keyp, hash(keyp)))) {
+	    entp->m_keyp = NULL;
+	    entp->m_erased = true;
+	    entp->m_value = T();
+	}
+    }
+    void clear() { m_table.clear(); m_used = 0; }
+};
+
 //===========================================================================
 /// Verilator range
 
@@ -66,6 +152,7 @@ public:
 
 class VerilatedVar {
     void*		m_datap;	// Location of data
+    CData*		m_dirtyp;	// Set when the model writes the data, or NULL if unknown
     VerilatedVarType	m_vltype;	// Data type
     VerilatedVarFlags	m_vlflags;	// Direction
     VerilatedRange	m_range;	// First range
@@ -74,12 +161,13 @@ class VerilatedVar {
     const char*		m_namep;	// Name - slowpath
 protected:
     friend class VerilatedScope;
-    VerilatedVar(const char* namep, void* datap,
+    VerilatedVar(const char* namep, void* datap, CData* dirtyp,
 		 VerilatedVarType vltype, VerilatedVarFlags vlflags, int dims)
-	: m_datap(datap), m_vltype(vltype), m_vlflags(vlflags), m_dims(dims), m_namep(namep) {}
+	: m_datap(datap), m_dirtyp(dirtyp), m_vltype(vltype), m_vlflags(vlflags), m_dims(dims), m_namep(namep) {}
 public:
     ~VerilatedVar() {}
     void* datap() const { return m_datap; }
+    CData* dirtyp() const { return m_dirtyp; }
     VerilatedVarType vltype() const { return m_vltype; }
     VerilatedVarFlags vldir() const { return (VerilatedVarFlags)((int)m_vlflags & VLVF_MASK_DIR); }
     vluint32_t entSize() const;
@@ -94,9 +182,15 @@ public:
 /// Types
 
 class VerilatedVarNameMap : public map<const char*, VerilatedVar, VerilatedCStrCmp> {
+    VerilatedCStrHash<VerilatedVar*>	m_hash;	///< Hashed index of the map, for varFind
 public:
     VerilatedVarNameMap() {}
     ~VerilatedVarNameMap() {}
+    void hashInsert(const char* namep, VerilatedVar* varp) { m_hash.insert(namep, varp); }
+    VerilatedVar* hashFind(const char* namep) const {
+	VerilatedVar* const* varpp = m_hash.find(namep);
+	return varpp ? *varpp : NULL;
+    }
 };
 
 #endif // Guard
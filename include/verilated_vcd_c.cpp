@@ -52,6 +52,7 @@
 // Global
 
 vector<VerilatedVcd*>	VerilatedVcd::s_vcdVecp;	///< List of all created traces
+VerilatedMutex		VerilatedVcd::s_vcdMutex;	///< Protect s_vcdVecp
 
 //=============================================================================
 // VerilatedVcdCallInfo
@@ -86,7 +87,11 @@ void VerilatedVcd::open (const char* filename) {
 
     // Set member variables
     m_filename = filename;
-    s_vcdVecp.push_back(this);
+    m_contextp = Verilated::threadContextp();
+    {
+	VerilatedLockGuard guard (s_vcdMutex);
+	s_vcdVecp.push_back(this);
+    }
 
     // SPDIFF_OFF
     // Set callback so an early exit will flush us
@@ -200,6 +205,7 @@ VerilatedVcd::~VerilatedVcd() {
     if (m_sigs_oldvalp) { delete[] m_sigs_oldvalp; m_sigs_oldvalp=NULL; }
     deleteNameMap();
     // Remove from list of traces
+    VerilatedLockGuard guard (s_vcdMutex);
     vector<VerilatedVcd*>::iterator pos = find(s_vcdVecp.begin(), s_vcdVecp.end(), this);
     if (pos != s_vcdVecp.end()) { s_vcdVecp.erase(pos); }
 }
@@ -594,9 +600,12 @@ void VerilatedVcd::dumpDone () {
 // Static members
 
 void VerilatedVcd::flush_all() {
+    // Only this simulation's traces; others may be mid-dump on their own threads
+    VerilatedContext* contextp = Verilated::threadContextp();
+    VerilatedLockGuard guard (s_vcdMutex);
     for (vluint32_t ent = 0; ent< s_vcdVecp.size(); ent++) {
 	VerilatedVcd* vcdp = s_vcdVecp[ent];
-	vcdp->flush();
+	if (vcdp->m_contextp == contextp) vcdp->flush();
     }
 }
 
@@ -26,6 +26,7 @@
 #define _VERILATED_VCD_C_H_ 1
 
 #include "verilatedos.h"
+#include "verilated.h"
 
 #include <string>
 #include <vector>
@@ -85,7 +86,9 @@ private:
     vector<VerilatedVcdCallInfo*>	m_callbacks;	///< Routines to perform dumping
     typedef map<string,string>	NameMap;
     NameMap*			m_namemapp;	///< List of names for the header
+    VerilatedContext*		m_contextp;	///< Simulation context that opened the file
     static vector<VerilatedVcd*>	s_vcdVecp;	///< List of all created traces
+    static VerilatedMutex	s_vcdMutex;	///< Protect s_vcdVecp
 
     inline static size_t bufferSize() { return 256*1024; }  // See below for slack calculation
     inline static size_t bufferInsertSize() { return 16*1024; }
@@ -134,7 +137,7 @@ protected:
 
 public:
     // CREATORS
-    VerilatedVcd () : m_isOpen(false), m_rolloverMB(0), m_modDepth(0), m_nextCode(1) {
+    VerilatedVcd () : m_isOpen(false), m_rolloverMB(0), m_modDepth(0), m_nextCode(1), m_contextp(NULL) {
 	m_wrBufp = new char [bufferSize()];
 	m_writep = m_wrBufp;
 	m_namemapp = NULL;
@@ -27,11 +27,20 @@
 
 //======================================================================
 
-VerilatedVpi VerilatedVpi::s_s;  // Singleton
 vluint8_t* VerilatedVpio::s_freeHead = NULL;
 
 //======================================================================
 
+VerilatedVpi::~VerilatedVpi() {
+    // Context is being destroyed; its handles are no longer valid
+    for (ValueWatchList::iterator it=m_valueWatches.begin(); it!=m_valueWatches.end(); ++it) {
+	delete *it;
+    }
+    if (m_errorInfop) { delete m_errorInfop; m_errorInfop=NULL; }
+}
+
+//======================================================================
+
 const char* VerilatedVpiError::strFromVpiVal(PLI_INT32 vpiVal) {
     static const char *names[] = {
         "*undefined*",
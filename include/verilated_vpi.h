@@ -51,8 +51,10 @@
 //======================================================================
 // Implementation
 
+#include <algorithm>
 #include <set>
 #include <list>
+#include <vector>
 #include <map>
 
 #define VL_DEBUG_IF_PLI VL_DEBUG_IF
@@ -72,7 +74,7 @@ public:
 	// To simplify our free list, we use a size large enough for all derived types
 	// We reserve word zero for the next pointer, as that's safer in case a
 	// dangling reference to the original remains around.
-	static size_t chunk = 96;
+	static size_t chunk = 128;
 	if (VL_UNLIKELY(size>chunk)) vl_fatal(__FILE__,__LINE__,"", "increase chunk");
 	if (VL_LIKELY(s_freeHead)) {
 	    vluint8_t* newp = s_freeHead;
@@ -104,14 +106,20 @@ public:
 
 typedef PLI_INT32 (*VerilatedPliCb)(struct t_cb_data *);
 
+class VerilatedVpiValueWatch;
+
 class VerilatedVpioCb : public VerilatedVpio {
     t_cb_data		m_cbData;
     s_vpi_value		m_value;
     QData		m_time;
+    QData		m_seq;		// Timed callbacks: registration order, to order same time callbacks
+    size_t		m_timedIdx;	// Timed callbacks: index in VerilatedVpi heap, or npos if not pending
+    VerilatedVpiValueWatch* m_watchp;	// cbValueChange variable this is on, if any
 public:
+    enum { TIMED_NPOS = ~((size_t)0) };
     // cppcheck-suppress uninitVar  // m_value
     VerilatedVpioCb(const t_cb_data* cbDatap, QData time)
-	: m_cbData(*cbDatap), m_time(time) {
+	: m_cbData(*cbDatap), m_time(time), m_seq(0), m_timedIdx(TIMED_NPOS), m_watchp(NULL) {
         m_value.format = cbDatap->value ? cbDatap->value->format : vpiSuppressVal;
 	m_cbData.value = &m_value;
     }
@@ -122,6 +130,12 @@ public:
     VerilatedPliCb cb_rtnp() const { return m_cbData.cb_rtn; }
     t_cb_data* cb_datap() { return &(m_cbData); }
     QData time() const { return m_time; }
+    QData seq() const { return m_seq; }
+    void seq(QData seq) { m_seq = seq; }
+    size_t timedIdx() const { return m_timedIdx; }
+    void timedIdx(size_t idx) { m_timedIdx = idx; }
+    VerilatedVpiValueWatch* watchp() const { return m_watchp; }
+    void watchp(VerilatedVpiValueWatch* watchp) { m_watchp = watchp; }
 };
 
 class VerilatedVpioConst : public VerilatedVpio {
@@ -173,7 +187,6 @@ public:
 class VerilatedVpioVar : public VerilatedVpio {
     const VerilatedVar*		m_varp;
     const VerilatedScope*	m_scopep;
-    vluint8_t*			m_prevDatap;	// Previous value of data, for cbValueChange
     union {
 	vluint8_t u8[4];
 	vluint32_t u32;
@@ -189,14 +202,11 @@ protected:
 public:
     VerilatedVpioVar(const VerilatedVar* varp, const VerilatedScope* scopep)
 	: m_varp(varp), m_scopep(scopep), m_index(0) {
-	m_prevDatap = NULL;
 	m_mask.u32 = VL_MASK_I(varp->range().elements());
 	m_entSize = varp->entSize();
 	m_varDatap = varp->datap();
     }
-    virtual ~VerilatedVpioVar() {
-	if (m_prevDatap) { delete [] m_prevDatap; m_prevDatap = NULL; }
-    }
+    virtual ~VerilatedVpioVar() {}
     static inline VerilatedVpioVar* castp(vpiHandle h) { return dynamic_cast<VerilatedVpioVar*>((VerilatedVpio*)h); }
     const VerilatedVar* varp() const { return m_varp; }
     const VerilatedScope* scopep() const { return m_scopep; }
@@ -216,14 +226,8 @@ public:
 	out = string(m_scopep->name())+"."+name();
 	return out.c_str();
     }
-    void* prevDatap() const { return m_prevDatap; }
     void* varDatap() const { return m_varDatap; }
-    void createPrevDatap() {
-	if (VL_UNLIKELY(!m_prevDatap)) {
-	    m_prevDatap = new vluint8_t [entSize()];
-	    memcpy(prevDatap(), varp()->datap(), entSize());
-	}
-    }
+    void markDirty() const { if (m_varp->dirtyp()) *(m_varp->dirtyp()) = 1; }  // For cbValueChange
 };
 
 class VerilatedVpioMemoryWord : public VerilatedVpioVar {
@@ -295,22 +299,47 @@ public:
 
 //======================================================================
 
-struct VerilatedVpiTimedCbsCmp {
-    /// Ordering sets keyed by time, then callback descriptor
-    bool operator() (const pair<QData,VerilatedVpioCb*>& a,
-		     const pair<QData,VerilatedVpioCb*>& b) const {
-	if (a.first < b.first) return 1;
-	if (a.first > b.first) return 0;
-	return a.second < b.second;
-    }
+class VerilatedVpiValueWatch {
+    // All cbValueChange callbacks on the same variable data, so
+    // callValueCbs compares each watched value once, and only visits
+    // the callbacks of values that changed.
+public:
+    typedef list<VerilatedVpioCb*> VpioCbList;
+    void*	m_datap;	// Data being watched
+    CData*	m_dirtyp;	// Set when the model writes the data, NULL to always compare
+    vluint8_t*	m_prevDatap;	// Previous value of data
+    vluint32_t	m_entSize;	// Size of data
+    VpioCbList	m_cbs;		// Callbacks on this data, NULL if removed
+    size_t	m_live;		// Callbacks in m_cbs not yet removed
+    VerilatedVpiValueWatch(void* datap, CData* dirtyp, vluint32_t entSize)
+	: m_datap(datap), m_dirtyp(dirtyp), m_entSize(entSize), m_live(0) {
+	m_prevDatap = new vluint8_t [entSize];
+	memcpy(m_prevDatap, datap, entSize);
+    }
+    ~VerilatedVpiValueWatch() {
+	delete [] m_prevDatap; m_prevDatap = NULL;
+    }
+    inline bool dirty() const { return !m_dirtyp || *m_dirtyp; }
+    inline bool changed() const { return 0!=memcmp(m_prevDatap, m_datap, m_entSize); }
+    void update() { memcpy(m_prevDatap, m_datap, m_entSize); }
 };
 
+//======================================================================
+
 class VerilatedVpiError;
 
-class VerilatedVpi {
+class VerilatedVpi : public VerilatedContextVpi {
+    // VPI state of one VerilatedContext; handles and callbacks belong to the
+    // context current on the thread that registers them
     enum { CB_ENUM_MAX_VALUE = cbAtEndOfSimTime+1 };	// Maxium callback reason
     typedef list<VerilatedVpioCb*> VpioCbList;
-    typedef set<pair<QData,VerilatedVpioCb*>,VerilatedVpiTimedCbsCmp > VpioTimedCbs;
+    typedef vector<VerilatedVpioCb*> VpioTimedCbs;	// Binary min-heap by time, then registration order
+public:
+    typedef pair<const VerilatedScope*,const VerilatedVar*> NameEnt;  // Var NULL if names a scope
+private:
+    typedef map<string,NameEnt> NameCacheMap;
+    typedef map<void*,VerilatedVpiValueWatch*> ValueWatchMap;
+    typedef vector<VerilatedVpiValueWatch*> ValueWatchList;
 
     struct product_info {
 	PLI_BYTE8* product;
@@ -319,61 +348,157 @@ class VerilatedVpi {
 
     VpioCbList		m_cbObjLists[CB_ENUM_MAX_VALUE];	// Callbacks for each supported reason
     VpioTimedCbs	m_timedCbs;	// Time based callbacks
+    QData		m_timedSeq;	// Next timed callback registration number
+    ValueWatchMap	m_valueWatchMap;	// cbValueChange watches, by variable data
+    ValueWatchList	m_valueWatches;	// cbValueChange watches, in registration order
+    bool		m_valueWatchRemoved;	// Watch emptied in callValueCbs; cleanup m_valueWatches
+    bool		m_inValueCbs;	// In callValueCbs, so m_valueWatches may not be changed
     VerilatedVpiError*  m_errorInfop;	// Container for vpi error info
+    NameCacheMap	m_nameCache;	// Resolved vpi_handle_by_name names (owns key strings)
+    VerilatedCStrHash<NameEnt> m_nameHash;	// Hashed index of m_nameCache
+    vluint32_t		m_nameGeneration;	// Verilated::scopesGeneration() when cache filled
 
-    static VerilatedVpi s_s;		// Singleton
+    static VerilatedVpi& s() {	// State of the current context
+	VerilatedContext* contextp = Verilated::threadContextp();
+	if (VL_UNLIKELY(!contextp->m_vpip)) contextp->m_vpip = new VerilatedVpi;
+	return *static_cast<VerilatedVpi*>(contextp->m_vpip);
+    }
 
 public:
-    VerilatedVpi() { m_errorInfop=NULL; }
-    ~VerilatedVpi() {}
+    VerilatedVpi() { m_errorInfop=NULL; m_nameGeneration=0; m_valueWatchRemoved=false; m_inValueCbs=false; m_timedSeq=0; }
+    virtual ~VerilatedVpi();
+    static const NameEnt* nameFind(const char* namep) {
+	if (VL_UNLIKELY(s().m_nameGeneration != Verilated::scopesGeneration())) {
+	    // Scopes were added or removed, so the cached pointers may be stale
+	    s().m_nameHash.clear();
+	    s().m_nameCache.clear();
+	    s().m_nameGeneration = Verilated::scopesGeneration();
+	    return NULL;
+	}
+	return s().m_nameHash.find(namep);
+    }
+    static void nameInsert(const char* namep, const VerilatedScope* scopep, const VerilatedVar* varp) {
+	NameCacheMap::iterator it = s().m_nameCache.insert(make_pair(string(namep),NameEnt(scopep,varp))).first;
+	s().m_nameHash.insert(it->first.c_str(), it->second);
+    }
     static void cbReasonAdd(VerilatedVpioCb* vop) {
+	if (VL_UNLIKELY(vop->reason() >= CB_ENUM_MAX_VALUE)) vl_fatal(__FILE__,__LINE__,"", "vpi bb reason too large");
 	if (vop->reason() == cbValueChange) {
 	    if (VerilatedVpioVar* varop = VerilatedVpioVar::castp(vop->cb_datap()->obj)) {
-		varop->createPrevDatap();
+		VerilatedVpiValueWatch* watchp;
+		ValueWatchMap::iterator it = s().m_valueWatchMap.find(varop->varDatap());
+		if (it != s().m_valueWatchMap.end()) {
+		    watchp = it->second;
+		} else {
+		    watchp = new VerilatedVpiValueWatch(varop->varDatap(), varop->varp()->dirtyp(),
+							varop->entSize());
+		    s().m_valueWatchMap.insert(make_pair(varop->varDatap(), watchp));
+		    s().m_valueWatches.push_back(watchp);
+		}
+		watchp->m_cbs.push_back(vop);
+		++watchp->m_live;
+		vop->watchp(watchp);
+		return;
 	    }
 	}
-	if (VL_UNLIKELY(vop->reason() >= CB_ENUM_MAX_VALUE)) vl_fatal(__FILE__,__LINE__,"", "vpi bb reason too large");
-	s_s.m_cbObjLists[vop->reason()].push_back(vop);
+	s().m_cbObjLists[vop->reason()].push_back(vop);
     }
     static void cbTimedAdd(VerilatedVpioCb* vop) {
-	s_s.m_timedCbs.insert(make_pair(vop->time(), vop));
+	// O(log n); the removal in cbTimedRemove is also O(log n)
+	vop->seq(s().m_timedSeq++);
+	vop->timedIdx(s().m_timedCbs.size());
+	s().m_timedCbs.push_back(vop);
+	timedSiftUp(vop->timedIdx());
     }
     static void cbReasonRemove(VerilatedVpioCb* cbp) {
-	VpioCbList& cbObjList = s_s.m_cbObjLists[cbp->reason()];
+	VerilatedVpiValueWatch* watchp = cbp->watchp();
+	VpioCbList& cbObjList = (watchp ? watchp->m_cbs
+				 : s().m_cbObjLists[cbp->reason()]);
 	// We do not remove it now as we may be iterating the list,
 	// instead set to NULL and will cleanup later
 	for (VpioCbList::iterator it=cbObjList.begin(); it!=cbObjList.end(); ++it) {
             if (*it == cbp) *it = NULL;
 	}
+	if (watchp) {
+	    cbp->watchp(NULL);
+	    if (--watchp->m_live == 0) {
+		// Last callback on it; free it now unless callValueCbs is scanning
+		if (s().m_inValueCbs) s().m_valueWatchRemoved = true;
+		else valueWatchDelete(watchp);
+	    }
+	}
     }
     static void cbTimedRemove(VerilatedVpioCb* cbp) {
-	VpioTimedCbs::iterator it=s_s.m_timedCbs.find(make_pair(cbp->time(),cbp));
-	if (VL_LIKELY(it != s_s.m_timedCbs.end())) {
-	    s_s.m_timedCbs.erase(it);
+	size_t idx = cbp->timedIdx();
+	if (VL_UNLIKELY(idx == VerilatedVpioCb::TIMED_NPOS)) return;  // Already called or removed
+	cbp->timedIdx(VerilatedVpioCb::TIMED_NPOS);
+	VerilatedVpioCb* lastp = s().m_timedCbs.back();
+	s().m_timedCbs.pop_back();
+	if (lastp != cbp) {
+	    timedSet(idx, lastp);
+	    timedSiftUp(idx);
+	    timedSiftDown(lastp->timedIdx());
 	}
     }
     static void callTimedCbs() {
+	// Callbacks are one-shot, so each is removed before it is called, and
+	// may then be re-registered, or remove others.  Callbacks registered
+	// from within a callback wait for the next call, so a zero delay
+	// callback re-registering itself can't loop forever.
 	QData time = VL_TIME_Q();
-	for (VpioTimedCbs::iterator it=s_s.m_timedCbs.begin(); it!=s_s.m_timedCbs.end(); ) {
-	    if (VL_UNLIKELY(it->first <= time)) {
-		VerilatedVpioCb* vop = it->second;
-		++it;  // iterator may be deleted by callback
-		VL_DEBUG_IF_PLI(VL_PRINTF("-vltVpi:  timed_callback %p\n",vop););
-		(vop->cb_rtnp()) (vop->cb_datap());
-	    }
-	    else { ++it; }
+	QData seqEnd = s().m_timedSeq;
+	while (!s().m_timedCbs.empty()) {
+	    VerilatedVpioCb* vop = s().m_timedCbs.front();
+	    if (vop->time() > time || vop->seq() >= seqEnd) break;
+	    cbTimedRemove(vop);
+	    VL_DEBUG_IF_PLI(VL_PRINTF("-vltVpi:  timed_callback %p\n",vop););
+	    (vop->cb_rtnp()) (vop->cb_datap());
 	}
     }
+    /// Time of the earliest pending cbAfterDelay callback, or maximum time if none.
+    /// Testbenches may advance time directly to here when the design is otherwise idle.
     static QData cbNextDeadline() {
-	VpioTimedCbs::iterator it=s_s.m_timedCbs.begin();
-	if (VL_LIKELY(it!=s_s.m_timedCbs.end())) {
-	    return it->first;
+	if (VL_LIKELY(!s().m_timedCbs.empty())) {
+	    return s().m_timedCbs.front()->time();
 	} else {
 	    return ~VL_ULL(0);  // maxquad
 	}
     }
+private:
+    static inline bool timedBefore(const VerilatedVpioCb* ap, const VerilatedVpioCb* bp) {
+	if (ap->time() != bp->time()) return ap->time() < bp->time();
+	return ap->seq() < bp->seq();
+    }
+    static inline void timedSet(size_t idx, VerilatedVpioCb* vop) {
+	s().m_timedCbs[idx] = vop;
+	vop->timedIdx(idx);
+    }
+    static void timedSiftUp(size_t idx) {
+	VerilatedVpioCb* vop = s().m_timedCbs[idx];
+	while (idx) {
+	    size_t parent = (idx-1)/2;
+	    if (!timedBefore(vop, s().m_timedCbs[parent])) break;
+	    timedSet(idx, s().m_timedCbs[parent]);
+	    idx = parent;
+	}
+	timedSet(idx, vop);
+    }
+    static void timedSiftDown(size_t idx) {
+	VerilatedVpioCb* vop = s().m_timedCbs[idx];
+	size_t size = s().m_timedCbs.size();
+	while (1) {
+	    size_t child = idx*2+1;
+	    if (child >= size) break;
+	    if (child+1 < size && timedBefore(s().m_timedCbs[child+1], s().m_timedCbs[child])) ++child;
+	    if (!timedBefore(s().m_timedCbs[child], vop)) break;
+	    timedSet(idx, s().m_timedCbs[child]);
+	    idx = child;
+	}
+	timedSet(idx, vop);
+    }
+public:
     static void callCbs(vluint32_t reason) {
-	VpioCbList& cbObjList = s_s.m_cbObjLists[reason];
+	VpioCbList& cbObjList = s().m_cbObjLists[reason];
 	for (VpioCbList::iterator it=cbObjList.begin(); it!=cbObjList.end();) {
 	    if (VL_UNLIKELY(!*it)) { // Deleted earlier, cleanup
 		it = cbObjList.erase(it);
@@ -384,35 +509,65 @@ public:
 	    (vop->cb_rtnp()) (vop->cb_datap());
 	}
     }
-    static void callValueCbs() {
-	VpioCbList& cbObjList = s_s.m_cbObjLists[cbValueChange];
-        set<VerilatedVpioVar*> update; // set of objects to update after callbacks
-	for (VpioCbList::iterator it=cbObjList.begin(); it!=cbObjList.end();) {
-	    if (VL_UNLIKELY(!*it)) { // Deleted earlier, cleanup
-		it = cbObjList.erase(it);
-		continue;
+    static void valueWatchDelete(VerilatedVpiValueWatch* watchp) {
+	s().m_valueWatchMap.erase(watchp->m_datap);
+	s().m_valueWatches.erase(find(s().m_valueWatches.begin(), s().m_valueWatches.end(), watchp));
+	delete watchp;
+    }
+    static void valueWatchCleanup() {
+	// Free watches emptied by callbacks during callValueCbs
+	ValueWatchList::iterator to = s().m_valueWatches.begin();
+	for (ValueWatchList::iterator it=s().m_valueWatches.begin(); it!=s().m_valueWatches.end(); ++it) {
+	    VerilatedVpiValueWatch* watchp = *it;
+	    if (watchp->m_live == 0) {
+		s().m_valueWatchMap.erase(watchp->m_datap);
+		delete watchp;
+	    } else {
+		*to++ = watchp;
 	    }
-	    VerilatedVpioCb* vop = *it++;
-	    if (VerilatedVpioVar* varop = VerilatedVpioVar::castp(vop->cb_datap()->obj)) {
-		void* newDatap = varop->varDatap();
-		void* prevDatap = varop->prevDatap();  // Was malloced when we added the callback
-		VL_DEBUG_IF_PLI(VL_PRINTF("-vltVpi:  value_test %s v[0]=%d/%d %p %p\n",
-					  varop->fullname(), *((CData*)newDatap), *((CData*)prevDatap),
-					  newDatap, prevDatap););
-		if (memcmp(prevDatap, newDatap, varop->entSize())) {
-		    VL_DEBUG_IF_PLI(VL_PRINTF("-vltVpi:  value_callback %p %s v[0]=%d\n",
-					      vop,varop->fullname(), *((CData*)newDatap)););
-                    update.insert(varop);
-		    vpi_get_value(vop->cb_datap()->obj, vop->cb_datap()->value);
-		    (vop->cb_rtnp()) (vop->cb_datap());
+	}
+	s().m_valueWatches.erase(to, s().m_valueWatches.end());
+	s().m_valueWatchRemoved = false;
+    }
+    static void callValueCbs() {
+	ValueWatchList update;  // Watches to update after callbacks
+	vector<CData*> clean;	// Marks to clear after callbacks; memory words share their variable's
+	ValueWatchList& watches = s().m_valueWatches;
+	s().m_inValueCbs = true;
+	// Index, not iterator, as callbacks may add more watches
+	for (size_t i=0; i<watches.size(); ++i) {
+	    VerilatedVpiValueWatch* watchp = watches[i];
+	    if (VL_LIKELY(!watchp->dirty())) continue;  // Model hasn't written it since the last call
+	    if (watchp->m_dirtyp) clean.push_back(watchp->m_dirtyp);
+	    if (!watchp->m_live || !watchp->changed()) continue;
+	    update.push_back(watchp);
+	    VpioCbList& cbObjList = watchp->m_cbs;
+	    for (VpioCbList::iterator it=cbObjList.begin(); it!=cbObjList.end();) {
+		if (VL_UNLIKELY(!*it)) { // Deleted earlier, cleanup
+		    it = cbObjList.erase(it);
+		    continue;
 		}
+		VerilatedVpioCb* vop = *it++;
+		VL_DEBUG_IF_PLI(VL_PRINTF("-vltVpi:  value_callback %p %p v[0]=%d\n",
+					  vop, watchp->m_datap, *((CData*)watchp->m_datap)););
+		vpi_get_value(vop->cb_datap()->obj, vop->cb_datap()->value);
+		(vop->cb_rtnp()) (vop->cb_datap());
 	    }
 	}
-	for (set<VerilatedVpioVar*>::iterator it=update.begin(); it!=update.end(); it++ ) {
-	    memcpy((*it)->prevDatap(), (*it)->varDatap(), (*it)->entSize());
+	for (ValueWatchList::iterator it=update.begin(); it!=update.end(); ++it) {
+	    (*it)->update();
 	}
+	for (vector<CData*>::iterator it=clean.begin(); it!=clean.end(); ++it) {
+	    **it = 0;
+	}
+	s().m_inValueCbs = false;
+	if (VL_UNLIKELY(s().m_valueWatchRemoved)) valueWatchCleanup();
     }
 
+    // Verilator extensions: batched raw value access, see definitions below
+    static PLI_INT32 getValues(PLI_INT32 count, const vpiHandle* objectsp, PLI_UINT32* bufp);
+    static PLI_INT32 putValues(PLI_INT32 count, const vpiHandle* objectsp, const PLI_UINT32* bufp);
+
     static VerilatedVpiError* error_info(); // getter for vpi error info
 };
 
@@ -496,10 +651,10 @@ public:
 };
 
 VerilatedVpiError* VerilatedVpi::error_info() {
-    if (s_s.m_errorInfop == NULL) {
-	s_s.m_errorInfop = new VerilatedVpiError();
+    if (s().m_errorInfop == NULL) {
+	s().m_errorInfop = new VerilatedVpiError();
     }
-    return s_s.m_errorInfop;
+    return s().m_errorInfop;
 }
 
 // callback related
@@ -578,10 +733,16 @@ vpiHandle vpi_handle_by_name(PLI_BYTE8* namep, vpiHandle scope) {
 	scopeAndName = string(voScopep->fullname()) + "." + namep;
 	namep = (PLI_BYTE8*)scopeAndName.c_str();
     }
+    // Testbenches often resolve the same names many times, so remember the answer
+    if (const VerilatedVpi::NameEnt* entp = VerilatedVpi::nameFind(namep)) {
+	if (!entp->second) return (new VerilatedVpioScope(entp->first))->castVpiHandle();
+	return (new VerilatedVpioVar(entp->second, entp->first))->castVpiHandle();
+    }
     {
 	// This doesn't yet follow the hierarchy in the proper way
 	scopep = Verilated::scopeFind(namep);
 	if (scopep) {  // Whole thing found as a scope
+	    VerilatedVpi::nameInsert(namep, scopep, NULL);
 	    return (new VerilatedVpioScope(scopep))->castVpiHandle();
 	}
 	const char* baseNamep = scopeAndName.c_str();
@@ -596,6 +757,7 @@ vpiHandle vpi_handle_by_name(PLI_BYTE8* namep, vpiHandle scope) {
 	varp = scopep->varFind(baseNamep);
     }
     if (!varp) return NULL;
+    VerilatedVpi::nameInsert(namep, scopep, varp);
     return (new VerilatedVpioVar(varp, scopep))->castVpiHandle();
 }
 
@@ -1062,6 +1224,7 @@ vpiHandle vpi_put_value(vpiHandle object, p_vpi_value value_p,
             _VL_VPI_WARNING(__FILE__, __LINE__, "Ignoring vpi_put_value to signal marked read-only, use public_flat_rw instead: ", vop->fullname());
 	    return 0;
 	}
+	vop->markDirty();
 	if (value_p->format == vpiVectorVal) {
 	    if (VL_UNLIKELY(!value_p->value.vector)) return NULL;
 	    switch (vop->varp()->vltype()) {
@@ -1314,6 +1477,88 @@ void vpi_put_value_array(vpiHandle object, p_vpi_arrayvalue arrayvalue_p,
     _VL_VPI_UNIMP(); return;
 }
 
+// Verilator extensions: batched raw value access
+//
+// Testbenches reading or writing many signals each cycle may pass an
+// array of variable handles and a buffer, avoiding per-call format
+// dispatch.  Each value occupies VL_WORDS_I(vpiSize) 32-bit words, least
+// significant word first, values packed one after another in handle
+// order.  Returns the number of words used, or -1 on an error, with the
+// vpi_chk_error information set.
+
+PLI_INT32 VerilatedVpi::getValues(PLI_INT32 count, const vpiHandle* objectsp, PLI_UINT32* bufp) {
+    _VL_VPI_ERROR_RESET(); // reset vpi error status
+    PLI_UINT32* outp = bufp;
+    for (PLI_INT32 n=0; n<count; ++n) {
+	VerilatedVpioVar* vop = VerilatedVpioVar::castp(objectsp[n]);
+	if (VL_UNLIKELY(!vop)) {
+	    _VL_VPI_ERROR(__FILE__, __LINE__, "%s: Handle %d is not a variable", VL_FUNC, n);
+	    return -1;
+	}
+	switch (vop->varp()->vltype()) {
+	case VLVT_UINT8:  *outp++ = *((CData*)(vop->varDatap())); break;
+	case VLVT_UINT16: *outp++ = *((SData*)(vop->varDatap())); break;
+	case VLVT_UINT32: *outp++ = *((IData*)(vop->varDatap())); break;
+	case VLVT_UINT64: {
+	    QData data = *((QData*)(vop->varDatap()));
+	    *outp++ = (IData)(data);
+	    *outp++ = (IData)(data>>VL_ULL(32));
+	    break;
+	}
+	case VLVT_WDATA: {
+	    int words = VL_WORDS_I(vop->varp()->range().elements());
+	    memcpy(outp, vop->varDatap(), words*sizeof(IData));
+	    outp += words;
+	    break;
+	}
+	default:
+	    _VL_VPI_ERROR(__FILE__, __LINE__, "%s: Unsupported type for %s", VL_FUNC, vop->fullname());
+	    return -1;
+	}
+    }
+    return (PLI_INT32)(outp - bufp);
+}
+
+PLI_INT32 VerilatedVpi::putValues(PLI_INT32 count, const vpiHandle* objectsp, const PLI_UINT32* bufp) {
+    _VL_VPI_ERROR_RESET(); // reset vpi error status
+    const PLI_UINT32* inp = bufp;
+    for (PLI_INT32 n=0; n<count; ++n) {
+	VerilatedVpioVar* vop = VerilatedVpioVar::castp(objectsp[n]);
+	if (VL_UNLIKELY(!vop)) {
+	    _VL_VPI_ERROR(__FILE__, __LINE__, "%s: Handle %d is not a variable", VL_FUNC, n);
+	    return -1;
+	}
+	if (VL_UNLIKELY(!vop->varp()->isPublicRW())) {
+	    _VL_VPI_ERROR(__FILE__, __LINE__, "%s: Signal marked read-only, use public_flat_rw instead: %s",
+			  VL_FUNC, vop->fullname());
+	    return -1;
+	}
+	vop->markDirty();
+	switch (vop->varp()->vltype()) {
+	case VLVT_UINT8:  *((CData*)(vop->varDatap())) = *inp++ & vop->mask(); break;
+	case VLVT_UINT16: *((SData*)(vop->varDatap())) = *inp++ & vop->mask(); break;
+	case VLVT_UINT32: *((IData*)(vop->varDatap())) = *inp++ & vop->mask(); break;
+	case VLVT_UINT64: {
+	    *((QData*)(vop->varDatap())) = _VL_SET_QII(inp[1] & vop->mask(), inp[0]);
+	    inp += 2;
+	    break;
+	}
+	case VLVT_WDATA: {
+	    int words = VL_WORDS_I(vop->varp()->range().elements());
+	    WDataOutP datap = ((IData*)(vop->varDatap()));
+	    memcpy(datap, inp, words*sizeof(IData));
+	    datap[words-1] &= vop->mask();
+	    inp += words;
+	    break;
+	}
+	default:
+	    _VL_VPI_ERROR(__FILE__, __LINE__, "%s: Unsupported type for %s", VL_FUNC, vop->fullname());
+	    return -1;
+	}
+    }
+    return (PLI_INT32)(inp - bufp);
+}
+
 
 // time processing
 
@@ -38,7 +38,8 @@ vluint64_t AstNode::s_editCntGbl=0;	// Hot cache line
 // To allow for fast clearing of all user pointers, we keep a "timestamp"
 // along with each userp, and thus by bumping this count we can make it look
 // as if we iterated across the entire tree to set all the userp's to null.
-int AstNode::s_cloneCntGbl=0;
+V3THREAD_LOCAL int AstNode::s_cloneCntGbl=0;
+int AstNode::s_cloneCntNext=0;
 uint32_t AstUser1InUse::s_userCntGbl=0;	// Hot cache line, leave adjacent
 uint32_t AstUser2InUse::s_userCntGbl=0;	// Hot cache line, leave adjacent
 uint32_t AstUser3InUse::s_userCntGbl=0;	// Hot cache line, leave adjacent
@@ -79,6 +80,7 @@ void AstNode::init() {
     // Attributes
     m_didWidth = false;
     m_doingWidth = false;
+    m_typeTag = AstType::_ENUM_END;
     m_user1p = NULL;
     m_user1Cnt = 0;
     m_user2p = NULL;
@@ -206,9 +208,9 @@ string AstNode::prettyTypeName() const {
 string AstNode::quoteName(const string& namein) {
     // Encode control chars into C style escapes
     // Reverse is V3Parse::deQuote
-    const char* start = namein.c_str();
+    // Iterates the string, not its c_str(), so an embedded NUL is kept
     string out;
-    for (const char* pos = start; *pos; pos++) {
+    for (string::const_iterator pos = namein.begin(); pos != namein.end(); ++pos) {
 	if (pos[0]=='\\' || pos[0]=='"') {
 	    out += string("\\")+pos[0];
 	} else if (pos[0]=='\n') {
@@ -221,7 +223,7 @@ string AstNode::quoteName(const string& namein) {
 	    out += pos[0];
 	} else {
 	    // This will also cover \a etc
-	    char octal[10]; sprintf(octal,"\\%03o",pos[0]);
+	    char octal[10]; sprintf(octal,"\\%03o",(unsigned char)pos[0]);
 	    out += octal;
 	}
     }
@@ -716,22 +718,94 @@ void AstNode::deleteTree() {
 }
 
 //======================================================================
-// Memory checks
+// Memory allocation
+
+class AstNodeArena {
+    // Nodes are carved from large slabs rather than each being its own
+    // heap allocation, and deleted nodes are kept on a free list per size
+    // to be reused by later nodes.  Slabs are never returned, so nothing
+    // is freed one node at a time at exit.
+    // All members are zero initialized, so this may be used before
+    // static constructors have run.
+    enum { ALIGN = 8,			// Alignment and size class granularity
+	   MAX_SIZE = 512,		// Larger nodes go directly to the heap
+	   SLAB_BYTES = 1024*1024 };
+    struct FreeEnt { FreeEnt* m_nextp; };
+    FreeEnt*	m_freeps[MAX_SIZE/ALIGN+1];	// Deleted nodes, per size class
+    char*	m_curp;		// Next unused byte of current slab
+    char*	m_endp;		// End of current slab
+    double	m_arenaBytes;	// Bytes obtained from the system
+    double	m_liveBytes;	// Bytes in use by nodes
+public:
+    void* alloc(size_t size) {
+	size = (size + ALIGN-1) & ~(size_t)(ALIGN-1);
+	m_liveBytes += size;
+	if (VL_UNLIKELY(size > MAX_SIZE)) {
+	    m_arenaBytes += size;
+	    return ::operator new(size);
+	}
+	if (FreeEnt* entp = m_freeps[size/ALIGN]) {
+	    m_freeps[size/ALIGN] = entp->m_nextp;
+	    return entp;
+	}
+	if (VL_UNLIKELY(m_curp + size > m_endp)) {
+	    m_curp = static_cast<char*>(::operator new(SLAB_BYTES));
+	    m_endp = m_curp + SLAB_BYTES;
+	    m_arenaBytes += SLAB_BYTES;
+	}
+	void* objp = m_curp;
+	m_curp += size;
+	return objp;
+    }
+    void free(void* objp, size_t size) {
+	size = (size + ALIGN-1) & ~(size_t)(ALIGN-1);
+	m_liveBytes -= size;
+	if (VL_UNLIKELY(size > MAX_SIZE)) {
+	    m_arenaBytes -= size;
+	    ::operator delete(objp);
+	    return;
+	}
+	FreeEnt* entp = static_cast<FreeEnt*>(objp);
+	entp->m_nextp = m_freeps[size/ALIGN];
+	m_freeps[size/ALIGN] = entp;
+    }
+    double arenaBytes() const { return m_arenaBytes; }
+    double liveBytes() const { return m_liveBytes; }
+};
+
+static AstNodeArena s_nodeArena;
+static double s_nodesLive;	// Nodes not yet deleted, zero initialized as with s_nodeArena
+static V3Mutex s_nodeArenaMutex;	// Protects the above while V3ThreadPool jobs run
 
-#ifdef VL_LEAK_CHECKS
 void* AstNode::operator new(size_t size) {
+    V3JobLockGuard lock (s_nodeArenaMutex);
+    s_nodesLive++;
+#ifdef VL_LEAK_CHECKS
+    // Heap allocate each node, so leak checkers see them individually
     AstNode* objp = static_cast<AstNode*>(::operator new(size));
     V3Broken::addNewed(objp);
     return objp;
+#else
+    return s_nodeArena.alloc(size);
+#endif
 }
 
 void AstNode::operator delete(void* objp, size_t size) {
     if (!objp) return;
+    V3JobLockGuard lock (s_nodeArenaMutex);
+    s_nodesLive--;
+#ifdef VL_LEAK_CHECKS
     AstNode* nodep = static_cast<AstNode*>(objp);
     V3Broken::deleted(nodep);
     ::operator delete(objp);
-}
+#else
+    s_nodeArena.free(objp, size);
 #endif
+}
+
+double AstNode::memArenaBytes() { return s_nodeArena.arenaBytes(); }
+double AstNode::memLiveBytes() { return s_nodeArena.liveBytes(); }
+double AstNode::memLiveNodes() { return s_nodesLive; }
 
 //======================================================================
 // Iterators
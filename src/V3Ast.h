@@ -25,6 +25,7 @@
 #include "V3Error.h"
 #include "V3Number.h"
 #include "V3Global.h"
+#include "V3ThreadPool.h"
 #include <vector>
 #include <cmath>
 #include <map>
@@ -245,7 +246,8 @@ public:
 	VAR_PUBLIC_FLAT_RW,		// V3LinkParse moves to AstVar::sigPublic
 	VAR_ISOLATE_ASSIGNMENTS,	// V3LinkParse moves to AstVar::attrIsolateAssign
 	VAR_SC_BV,			// V3LinkParse moves to AstVar::attrScBv
-	VAR_SFORMAT			// V3LinkParse moves to AstVar::attrSFormat
+	VAR_SFORMAT,			// V3LinkParse moves to AstVar::attrSFormat
+	VAR_SPARSE			// V3LinkParse moves to AstVar::attrSparse
     };
     enum en m_e;
     const char* ascii() const {
@@ -256,7 +258,7 @@ public:
 	    "MEMBER_BASE",
 	    "VAR_BASE", "VAR_CLOCK", "VAR_CLOCK_ENABLE", "VAR_PUBLIC",
 	    "VAR_PUBLIC_FLAT", "VAR_PUBLIC_FLAT_RD","VAR_PUBLIC_FLAT_RW",
-	    "VAR_ISOLATE_ASSIGNMENTS", "VAR_SC_BV", "VAR_SFORMAT"
+	    "VAR_ISOLATE_ASSIGNMENTS", "VAR_SC_BV", "VAR_SFORMAT", "VAR_SPARSE"
 	};
 	return names[m_e];
     };
@@ -704,6 +706,8 @@ protected:
     }
     static void clearcnt(int id, uint32_t& cntGblRef, bool& userBusyRef) {
 	UASSERT_STATIC(userBusyRef, "Clear of User"+cvtToStr(id)+"() not under AstUserInUse");
+	// Jobs share one count, so only the thread that started them may change it
+	UASSERT_STATIC(!V3ThreadPool::running(), "Clear of User"+cvtToStr(id)+"() inside a V3ThreadPool job");
 	// If this really fires and is real (after 2^32 edits???)
 	// we could just walk the tree and clear manually
 	++cntGblRef;
@@ -873,7 +877,10 @@ ostream& operator<<(ostream& os, V3Hash rhs);
 #define ASTNODE_PREFETCH(nodep) \
     { if (nodep) { VL_PREFETCH_RD(&(nodep->m_nextp)); VL_PREFETCH_RD(&(nodep->m_iterpp)); }}
 
+template <class T_Visitor, class T_Base> class AstNVisitorStatic;
+
 class AstNode {
+    template <class T_Visitor, class T_Base> friend class AstNVisitorStatic;
     // v ASTNODE_PREFETCH depends on below ordering of members
     AstNode*	m_nextp;	// Next peer in the parent's list
     AstNode*	m_backp;	// Node that points to this one (via next/op1/op2/...)
@@ -895,7 +902,8 @@ class AstNode {
 
     AstNode*	m_clonep;	// Pointer to clone of/ source of this module (for *LAST* cloneTree() ONLY)
     int		m_cloneCnt;	// Mark of when userp was set
-    static int	s_cloneCntGbl;	// Count of which userp is set
+    static V3THREAD_LOCAL int s_cloneCntGbl;	// Count of which userp is set, for this thread's cloneTree()
+    static int	s_cloneCntNext;	// Last count handed to any thread, so V3ThreadPool jobs don't collide
 
     // Attributes
     bool	m_didWidth:1;	// Did V3Width computation
@@ -913,6 +921,7 @@ class AstNode {
     AstNUser*	m_user4p;	// Pointer to any information the user iteration routine wants
     AstNUser*	m_user5p;	// Pointer to any information the user iteration routine wants
     uint32_t	m_user5Cnt;	// Mark of when userp was set
+    mutable AstType::en m_typeTag;	// Cache of type(), _ENUM_END until first typeTag()
 
     // METHODS
     void	op1p(AstNode* nodep) { m_op1p = nodep; if (nodep) nodep->m_backp = this; }
@@ -963,11 +972,18 @@ protected:
     void	addNOp4p(AstNode* newp) { if (newp) addOp4p(newp); }
 
     void	clonep(AstNode* nodep) { m_clonep=nodep; m_cloneCnt=s_cloneCntGbl; }
-    static void	cloneClearTree() { s_cloneCntGbl++; UASSERT_STATIC(s_cloneCntGbl,"Rollover"); }
+    static void	cloneClearTree() {
+	s_cloneCntGbl = (VL_LIKELY(!V3ThreadPool::running()) ? ++s_cloneCntNext
+			 : __sync_add_and_fetch(&s_cloneCntNext, 1));
+	UASSERT_STATIC(s_cloneCntGbl,"Rollover"); }
 
 public:
     // ACCESSORS
     virtual AstType	type() const = 0;
+    virtual size_t	nodeSize() const = 0;	// sizeof() this node's class
+    AstType::en	typeTag() const {  // type(), without a virtual call once known
+	if (VL_UNLIKELY(m_typeTag==AstType::_ENUM_END)) m_typeTag = type();
+	return m_typeTag; }
     const char*	typeName() const { return type().ascii(); }  // See also prettyTypeName
     AstNode*	nextp() const { return m_nextp; }
     AstNode*	backp() const { return m_backp; }
@@ -983,10 +999,11 @@ public:
 
     // CONSTRUCTORS
     virtual ~AstNode();
-#ifdef VL_LEAK_CHECKS
     static void* operator new(size_t size);
     static void operator delete(void* obj, size_t size);
-#endif
+    static double memArenaBytes();	// Bytes obtained from the system for nodes
+    static double memLiveBytes();	// Bytes in use by nodes not yet deleted
+    static double memLiveNodes();	// Nodes not yet deleted
 
     // CONSTANT ACCESSORS
     static int	instrCountBranch() { return 4; }	///< Instruction cycles to branch
@@ -1086,7 +1103,9 @@ public:
     static void	user5ClearTree() { AstUser5InUse::clear(); }
 
     vluint64_t	editCount() const { return m_editCount; }
-    void	editCountInc() { m_editCount = ++s_editCntGbl; }  // Preincrement, so can "watch AstNode::s_editCntGbl=##"
+    void	editCountInc() {  // Preincrement, so can "watch AstNode::s_editCntGbl=##"
+	m_editCount = (VL_LIKELY(!V3ThreadPool::running()) ? ++s_editCntGbl
+		       : __sync_add_and_fetch(&s_editCntGbl, 1)); }
     static vluint64_t	editCountLast() { return s_editCntLast; }
     static vluint64_t	editCountGbl() { return s_editCntGbl; }
     static void		editCountSetLast() { s_editCntLast = editCountGbl(); }
@@ -1519,6 +1538,12 @@ public:
     const string& text() const { return m_text; }
 };
 
+struct AstNodeRange : public AstNode {
+    // A range, sized or unsized
+    AstNodeRange(FileLine* fl) : AstNode(fl) {}
+    ASTNODE_BASE_FUNCS(NodeRange)
+};
+
 struct AstNodeDType : public AstNode {
 private:
     // Ideally width() would migrate to BasicDType as that's where it makes sense,
@@ -1863,4 +1888,64 @@ inline void AstIfaceRefDType::cloneRelink() {
     if (m_ifacep && m_ifacep->clonep()) m_ifacep = m_ifacep->clonep()->castIface();
     if (m_modportp && m_modportp->clonep()) m_modportp = m_modportp->clonep()->castModport(); }
 
+//######################################################################
+// AstNVisitorStatic -- Visitor with non-virtual dispatch
+//
+//  A visitor derived as
+//
+//	class FooVisitor : public AstNVisitorStatic<FooVisitor> {
+//	    friend class AstNVisitorStatic<FooVisitor>;
+//
+//  may call accept(nodep), iterateAndNext(nodep) and iterateChildren(nodep)
+//  in place of nodep->accept(*this) etc.  These switch on the node's type
+//  and call FooVisitor::visit directly, choosing the visit() for the
+//  nearest base class just as the virtual calls would, rather than calling
+//  the virtual AstNode::accept which in turn calls the virtual visit.
+//  FooVisitor must not be subclassed, and must declare all its visit()s
+//  itself; T_Base may supply other helpers.
+
+template <class T_Visitor, class T_Base=AstNVisitor>
+class AstNVisitorStatic : public T_Base {
+protected:
+    void accept(AstNode* nodep, AstNUser* vup=NULL) {
+	T_Visitor& v = *static_cast<T_Visitor*>(this);
+	switch (nodep->typeTag()) {
+#include "V3Ast__gen_dispatch.h"	// From ./astgen
+	// Things like:
+	//  case AstType::atADD: v.T_Visitor::visit(static_cast<AstAdd*>(nodep),vup); break;
+	default: nodep->accept(v, vup); break;
+	}
+    }
+    void iterateAndNext(AstNode* nodep, AstNUser* vup=NULL) {
+	// See AstNode::iterateAndNext
+#ifdef VL_DEBUG
+	if (VL_UNLIKELY(nodep && !nodep->m_backp)) nodep->v3fatalSrc("iterateAndNext node has no back");
+#endif
+	while (nodep) {
+	    AstNode* niterp = nodep;  // This address may get stomped via m_iterpp if the node is edited
+	    ASTNODE_PREFETCH(nodep->m_nextp);
+	    niterp->m_iterpp = &niterp;
+	    accept(niterp, vup);
+	    if (!niterp) return;
+	    niterp->m_iterpp = NULL;
+	    if (VL_UNLIKELY(niterp!=nodep)) { // Edited it
+		nodep = niterp;
+	    } else {  // Same node, just loop
+		nodep = niterp->m_nextp;
+	    }
+	}
+    }
+    void iterateChildren(AstNode* nodep, AstNUser* vup=NULL) {
+	if (!nodep) return;
+	ASTNODE_PREFETCH(nodep->m_op1p);
+	ASTNODE_PREFETCH(nodep->m_op2p);
+	ASTNODE_PREFETCH(nodep->m_op3p);
+	ASTNODE_PREFETCH(nodep->m_op4p);
+	if (nodep->m_op1p) iterateAndNext(nodep->m_op1p, vup);
+	if (nodep->m_op2p) iterateAndNext(nodep->m_op2p, vup);
+	if (nodep->m_op3p) iterateAndNext(nodep->m_op3p, vup);
+	if (nodep->m_op4p) iterateAndNext(nodep->m_op4p, vup);
+    }
+};
+
 #endif // Guard
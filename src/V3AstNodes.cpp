@@ -175,6 +175,12 @@ string AstVar::vlArgType(bool named, bool forReturn) const {
     if (forReturn) named=false;
     if (forReturn) v3fatalSrc("verilator internal data is never passed as return, but as first argument");
     string arg;
+    if (isDpiOpenArray()) {
+	// Storage of the connected array, which the DPI wrapper describes to the callee
+	arg += "void*";
+	if (named) arg += " "+name();
+	return arg;
+    }
     if (isWide() && isInOnly()) arg += "const ";
     AstBasicDType* bdtypep = basicp();
     bool strtype = bdtypep && bdtypep->keyword()==AstBasicDTypeKwd::STRING;
@@ -275,7 +281,10 @@ string AstVar::dpiArgType(bool named, bool forReturn) const {
     if (forReturn) named=false;
     string arg;
     if (!basicp()) arg = "UNKNOWN";
-    if (basicp()->isBitLogic()) {
+    if (isDpiOpenArray()) {
+	if (forReturn) v3fatalSrc("Open arrays can't be returned");
+	arg = isInOnly() ? "const svOpenArrayHandle" : "svOpenArrayHandle";
+    } else if (basicp()->isBitLogic()) {
 	if (widthMin() == 1) {
 	    arg = "unsigned char";
 	    if (!forReturn && isOutput()) arg += "*";
@@ -515,6 +524,9 @@ bool AstSenTree::hasCombo() {
     return false;
 }
 
+// V3ThreadPool jobs creating nodes share the one type table
+static V3Mutex s_typeTableMutex;
+
 void AstTypeTable::clearCache() {
     // When we mass-change widthMin in V3WidthCommit, we need to correct the table.
     // Just clear out the maps; the search functions will be used to rebuild the map
@@ -547,6 +559,7 @@ void AstTypeTable::repairCache() {
 }
 
 AstBasicDType* AstTypeTable::findBasicDType(FileLine* fl, AstBasicDTypeKwd kwd) {
+    V3JobLockGuard lock (s_typeTableMutex);
     if (m_basicps[kwd]) return m_basicps[kwd];
     //
     AstBasicDType* new1p = new AstBasicDType(fl, kwd);
@@ -563,6 +576,7 @@ AstBasicDType* AstTypeTable::findBasicDType(FileLine* fl, AstBasicDTypeKwd kwd)
 
 AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kwd,
 					       int width, int widthMin, AstNumeric numeric) {
+    V3JobLockGuard lock (s_typeTableMutex);
     int idx = IDX0_LOGIC;
     if (kwd == AstBasicDTypeKwd::LOGIC) idx = IDX0_LOGIC;
     else if (kwd == AstBasicDTypeKwd::BIT) idx = IDX0_BIT;
@@ -586,6 +600,7 @@ AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kw
 
 AstBasicDType* AstTypeTable::findLogicBitDType(FileLine* fl, AstBasicDTypeKwd kwd,
 					       VNumRange range, int widthMin, AstNumeric numeric) {
+    V3JobLockGuard lock (s_typeTableMutex);
     AstBasicDType* new1p = new AstBasicDType(fl, kwd, numeric, range, widthMin);
     AstBasicDType* newp = findInsertSameDType(new1p);
     if (newp != new1p) new1p->deleteTree();
@@ -801,6 +816,10 @@ void AstNodeArrayDType::dumpSmall(ostream& str) {
     if (castPackArrayDType()) str<<"p"; else str<<"u";
     str<<"["<<declRange().left()<<":"<<declRange().right()<<"]";
 }
+void AstUnsizedArrayDType::dumpSmall(ostream& str) {
+    this->AstNodeDType::dumpSmall(str);
+    str<<"u[]";
+}
 void AstNodeArrayDType::dump(ostream& str) {
     this->AstNodeDType::dump(str);
     str<<" ["<<declRange().left()<<":"<<declRange().right()<<"]";
@@ -906,6 +925,8 @@ void AstVar::dump(ostream& str) {
     if (attrClockEn()) str<<" [aCLKEN]";
     if (attrIsolateAssign()) str<<" [aISO]";
     if (attrFileDescr()) str<<" [aFD]";
+    if (attrSparse()) str<<" [aSPARSE]";
+    if (isSparse()) str<<" [SPARSE]";
     if (isFuncReturn()) str<<" [FUNCRTN]";
     else if (isFuncLocal()) str<<" [FUNC]";
     str<<" "<<varType();
@@ -975,6 +996,14 @@ void AstCoverInc::dump(ostream& str) {
     if (declp()) { declp()->dump(str); }
     else { str<<"%Error:UNLINKED"; }
 }
+void AstCoverToggle::dump(ostream& str) {
+    this->AstNode::dump(str);
+    str<<" bits";
+    for (ToggleBits::const_iterator it=m_toggleBits.begin(); it!=m_toggleBits.end(); ++it) {
+	str<<" "<<dec<<it->first;
+	if (it->second!=1) str<<"+:"<<it->second;
+    }
+}
 void AstTraceInc::dump(ostream& str) {
     this->AstNode::dump(str);
     str<<" -> ";
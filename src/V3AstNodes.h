@@ -31,6 +31,7 @@
 #define ASTNODE_NODE_FUNCS(name,ucname)	\
     virtual ~Ast ##name() {} \
     virtual AstType type() const { return AstType::at ##ucname; } \
+    virtual size_t nodeSize() const { return sizeof(Ast ##name); } \
     virtual AstNode* clone() { return new Ast ##name (*this); } \
     virtual void accept(AstNVisitor& v, AstNUser* vup=NULL) { v.visit(this,vup); } \
     Ast ##name * cloneTree(bool cloneNext) { return AstNode::cloneTree(cloneNext)->cast ##name(); }
@@ -128,22 +129,22 @@ public:
     void name(const string& flag) { m_name = flag; rewidth(); }
 };
 
-struct AstRange : public AstNode {
+struct AstRange : public AstNodeRange {
     // Range specification, for use under variables and cells
 private:
     bool	m_littleEndian:1;	// Bit vector is little endian
 public:
     AstRange(FileLine* fl, AstNode* msbp, AstNode* lsbp)
-	:AstNode(fl) {
+	:AstNodeRange(fl) {
 	m_littleEndian = false;
 	setOp2p(msbp); setOp3p(lsbp); }
     AstRange(FileLine* fl, int msb, int lsb)
-	:AstNode(fl) {
+	:AstNodeRange(fl) {
 	m_littleEndian = false;
 	setOp2p(new AstConst(fl,msb)); setOp3p(new AstConst(fl,lsb));
     }
     AstRange(FileLine* fl, VNumRange range)
-	:AstNode(fl) {
+	:AstNodeRange(fl) {
 	m_littleEndian = range.littleEndian();
 	setOp2p(new AstConst(fl,range.hi())); setOp3p(new AstConst(fl,range.lo()));
     }
@@ -163,6 +164,18 @@ public:
     virtual bool same(AstNode* samep) const { return true; }
 };
 
+struct AstUnsizedRange : public AstNodeRange {
+    // Unsized range specification, for open array arguments
+    // Only exists in the parser; converted to AstUnsizedArrayDType by createArray
+    AstUnsizedRange(FileLine* fl)
+	: AstNodeRange(fl) {}
+    ASTNODE_NODE_FUNCS(UnsizedRange, UNSIZEDRANGE)
+    virtual string emitC() { V3ERROR_NA; return ""; }
+    virtual string emitVerilog() { return "[]"; }
+    virtual V3Hash sameHash() const { return V3Hash(); }
+    virtual bool same(AstNode* samep) const { return true; }
+};
+
 //######################################################################
 //==== Data Types
 
@@ -284,6 +297,46 @@ public:
     ASTNODE_NODE_FUNCS(UnpackArrayDType, UNPACKARRAYDTYPE)
 };
 
+struct AstUnsizedArrayDType : public AstNodeDType {
+    // Open array data type, ie "some_dtype var_name []"
+    // Only legal on DPI import arguments; the size comes from each call's connection
+    // Children: DTYPE (moved to refDTypep() in V3Width)
+private:
+    AstNodeDType*	m_refDTypep;	// Elements of this type (after widthing)
+public:
+    AstUnsizedArrayDType(FileLine* fl, VFlagChildDType, AstNodeDType* dtp)
+	: AstNodeDType(fl) {
+	childDTypep(dtp);  // Only for parser
+	refDTypep(NULL);
+	dtypep(NULL);  // V3Width will resolve
+	// Like AstUnpackArrayDType, width and signing are those of an element
+	widthFromSub(subDTypep());
+    }
+    ASTNODE_NODE_FUNCS(UnsizedArrayDType, UNSIZEDARRAYDTYPE)
+    virtual const char* broken() const { BROKEN_RTN(!((m_refDTypep && !childDTypep() && m_refDTypep->brokeExists())
+						     || (!m_refDTypep && childDTypep()))); return NULL; }
+    virtual void cloneRelink() { if (m_refDTypep && m_refDTypep->clonep()) {
+	m_refDTypep = m_refDTypep->clonep()->castNodeDType();
+    }}
+    virtual bool same(AstNode* samep) const {
+	return (subDTypep()==samep->castUnsizedArrayDType()->subDTypep()); }
+    virtual V3Hash sameHash() const { return V3Hash(m_refDTypep); }
+    virtual void dumpSmall(ostream& str);
+    AstNodeDType* getChildDTypep() const { return childDTypep(); }
+    AstNodeDType* childDTypep() const { return op1p()->castNodeDType(); } // op1 = Element type
+    void childDTypep(AstNodeDType* nodep) { setOp1p(nodep); }
+    AstNodeDType* subDTypep() const { return m_refDTypep ? m_refDTypep : childDTypep(); }
+    void refDTypep(AstNodeDType* nodep) { m_refDTypep = nodep; }
+    virtual AstNodeDType* virtRefDTypep() const { return m_refDTypep; }
+    virtual void virtRefDTypep(AstNodeDType* nodep) { refDTypep(nodep); }
+    // METHODS
+    virtual AstBasicDType* basicp() const { return subDTypep()->basicp(); }  // (Slow) recurse down to find basic data type
+    virtual AstNodeDType* skipRefp() const { return (AstNodeDType*)this; }
+    virtual AstNodeDType* skipRefToConstp() const { return (AstNodeDType*)this; }
+    virtual int widthAlignBytes() const { return subDTypep()->widthAlignBytes(); }
+    virtual int widthTotalBytes() const { return subDTypep()->widthTotalBytes(); }  // Per element; storage is the caller's
+};
+
 struct AstBasicDType : public AstNodeDType {
     // Builtin atomic/vectored data type
     // Children: RANGE (converted to constant in V3Width)
@@ -890,6 +943,7 @@ private:
     bool	m_attrScBv:1; // User force bit vector attribute
     bool	m_attrIsolateAssign:1;// User isolate_assignments attribute
     bool	m_attrSFormat:1;// User sformat attribute
+    bool	m_attrSparse:1;	// User sparse attribute
     bool	m_fileDescr:1;	// File descriptor
     bool	m_isConst:1;	// Table contains constant data
     bool	m_isStatic:1;	// Static variable
@@ -897,6 +951,7 @@ private:
     bool	m_isPullup:1;	// Tri1
     bool	m_isIfaceParent:1;	// dtype is reference to interface present in this module
     bool	m_trace:1;	// Trace this variable
+    bool	m_sparse:1;	// Stored as pages allocated on use
 
     void	init() {
 	m_input=false; m_output=false; m_tristate=false; m_declOutput=false;
@@ -906,9 +961,10 @@ private:
 	m_sigPublic=false; m_sigModPublic=false; m_sigUserRdPublic=false; m_sigUserRWPublic=false;
 	m_funcLocal=false; m_funcReturn=false;
 	m_attrClockEn=false; m_attrScBv=false; m_attrIsolateAssign=false; m_attrSFormat=false;
+	m_attrSparse=false;
 	m_fileDescr=false; m_isConst=false; m_isStatic=false; m_isPulldown=false; m_isPullup=false;
 	m_isIfaceParent=false;
-	m_trace=false;
+	m_trace=false; m_sparse=false;
     }
 public:
     AstVar(FileLine* fl, AstVarType type, const string& name, VFlagChildDType, AstNodeDType* dtp)
@@ -986,6 +1042,7 @@ public:
     void	attrScBv(bool flag) { m_attrScBv = flag; }
     void	attrIsolateAssign(bool flag) { m_attrIsolateAssign = flag; }
     void	attrSFormat(bool flag) { m_attrSFormat = flag; }
+    void	attrSparse(bool flag) { m_attrSparse = flag; }
     void	usedClock(bool flag) { m_usedClock = flag; }
     void	usedParam(bool flag) { m_usedParam = flag; }
     void	usedLoopIdx(bool flag) { m_usedLoopIdx = flag; }
@@ -1002,6 +1059,7 @@ public:
     void	funcLocal(bool flag) { m_funcLocal = flag; }
     void	funcReturn(bool flag) { m_funcReturn = flag; }
     void	trace(bool flag) { m_trace=flag; }
+    void	sparse(bool flag) { m_sparse=flag; }
     // METHODS
     virtual void name(const string& name) { m_name = name; }
     bool	isInput() const { return m_input; }
@@ -1030,6 +1088,7 @@ public:
     bool	isGParam() const { return (varType()==AstVarType::GPARAM); }
     bool	isGenVar() const { return (varType()==AstVarType::GENVAR); }
     bool	isBitLogic() const { AstBasicDType* bdtypep = basicp(); return bdtypep && bdtypep->isBitLogic(); }
+    bool	isDpiOpenArray() const { return dtypeSkipRefp()->castUnsizedArrayDType(); }
     bool	isUsedClock() const { return m_usedClock; }
     bool	isUsedParam() const { return m_usedParam; }
     bool	isUsedLoopIdx() const { return m_usedLoopIdx; }
@@ -1044,6 +1103,7 @@ public:
     bool	isSigUserRdPublic() const { return m_sigUserRdPublic; }
     bool	isSigUserRWPublic() const { return m_sigUserRWPublic; }
     bool	isTrace() const { return m_trace; }
+    bool	isSparse() const { return m_sparse; }
     bool	isConst() const { return m_isConst; }
     bool	isStatic() const { return m_isStatic; }
     bool	isFuncLocal() const { return m_funcLocal; }
@@ -1056,6 +1116,7 @@ public:
     bool	attrScClocked() const { return m_scClocked; }
     bool	attrSFormat() const { return m_attrSFormat; }
     bool	attrIsolateAssign() const { return m_attrIsolateAssign; }
+    bool	attrSparse() const { return m_attrSparse; }
     virtual string verilogKwd() const;
     void	propagateAttrFrom(AstVar* fromp) {
 	// This is getting connected to fromp; keep attributes
@@ -1989,25 +2050,35 @@ public:
 struct AstCoverToggle : public AstNodeStmt {
     // Toggle analysis of given signal
     // Parents:  MODULE
-    // Children: AstCoverInc, orig var, change det var
-    AstCoverToggle(FileLine* fl, AstCoverInc* incp, AstNode* origp, AstNode* changep)
+    // Children: AstCoverInc list, orig var, change det var
+    // Each AstCoverInc counts changes of a bit (or unranged field) of the original, as given
+    // by toggleBits(), so a whole packed word is compared once, and counters only touched on a change.
+public:
+    typedef vector<pair<int,int> > ToggleBits;	// lsb, width of origp() each AstCoverInc counts
+private:
+    ToggleBits	m_toggleBits;
+public:
+    AstCoverToggle(FileLine* fl, AstNode* origp, AstNode* changep)
 	: AstNodeStmt(fl) {
-	setOp1p(incp);
 	setOp2p(origp);
 	setOp3p(changep);
     }
     ASTNODE_NODE_FUNCS(CoverToggle, COVERTOGGLE)
+    virtual void dump(ostream& str);
     virtual int instrCount()	const { return 3+instrCountBranch()+instrCountLd(); }
-    virtual V3Hash sameHash() const { return V3Hash(); }
-    virtual bool same(AstNode*) const { return true; }
+    virtual V3Hash sameHash() const { return V3Hash((uint32_t)m_toggleBits.size()); }
+    virtual bool same(AstNode* samep) const {
+	return m_toggleBits==samep->castCoverToggle()->m_toggleBits; }
     virtual bool isGateOptimizable() const { return false; }
     virtual bool isPredictOptimizable() const { return true; }
     virtual bool isOutputter() const { return false; }   // Though the AstCoverInc under this is an outputter
     // but isPure()  true
-    AstCoverInc* incp() const { return op1p()->castCoverInc(); }
-    void 	incp(AstCoverInc* nodep) { setOp1p(nodep); }
+    AstCoverInc* incsp() const { return op1p()->castCoverInc(); }	// op1 = increments, one per toggleBits()
+    void 	addIncp(AstCoverInc* nodep, int lsb, int width) {
+	addOp1p(nodep); m_toggleBits.push_back(make_pair(lsb,width)); }
     AstNode* origp() const { return op2p(); }
     AstNode* changep() const { return op3p(); }
+    const ToggleBits& toggleBits() const { return m_toggleBits; }
 };
 
 struct AstGenCase : public AstNodeCase {
@@ -43,11 +43,13 @@
 #include <cstdarg>
 #include <unistd.h>
 #include <algorithm>
+#include <vector>
 
 #include "V3Global.h"
 #include "V3Case.h"
 #include "V3Ast.h"
 #include "V3Stats.h"
+#include "V3ThreadPool.h"
 
 #define CASE_OVERLAP_WIDTH 12		// Maximum width we can check for overlaps in
 #define CASE_BARF	   999999	// Magic width when non-constant
@@ -124,13 +126,14 @@ public:
 class CaseVisitor : public AstNVisitor {
 private:
     // NODE STATE
-    // Cleared each Case
-    //  AstIf::user3()		-> bool.  Set true to indicate clone not needed
-    AstUser3InUse	m_inuser3;
+    //  AstIf::user3()		-> int.  Set to m_caseNum to indicate clone not needed
+    // The AstUser3InUse is in V3Case::caseAll, shared by every module's job,
+    // so each case is numbered rather than clearing user3 between cases
 
     // STATE
     V3Double0	m_statCaseFast;	// Statistic tracking
     V3Double0	m_statCaseSlow;	// Statistic tracking
+    int		m_caseNum;	// Number of the current fast case, for user3
 
     // Per-CASE
     int		m_caseWidth;	// Width of valueItems
@@ -252,8 +255,8 @@ private:
 	    // Must have differing logic, so make a selection
 
 	    // Case expressions can't be linked twice, so clone them
-	    if (tree0p && !tree0p->user3()) tree0p = tree0p->cloneTree(true);
-	    if (tree1p && !tree1p->user3()) tree1p = tree1p->cloneTree(true);
+	    if (tree0p && tree0p->user3() != m_caseNum) tree0p = tree0p->cloneTree(true);
+	    if (tree1p && tree1p->user3() != m_caseNum) tree1p = tree1p->cloneTree(true);
 
 	    // Alternate scheme if we ever do multiple bits at a time:
 	    //V3Number nummask (cexprp->fileline(), cexprp->width(), (1UL<<msb));
@@ -265,7 +268,7 @@ private:
 				      new AstConst(cexprp->fileline(), 0),
 				      and1p);
 	    AstIf* ifp = new AstIf(cexprp->fileline(), eqp, tree1p, tree0p);
-	    ifp->user3(1);	// So we don't bother to clone it
+	    ifp->user3(m_caseNum);	// So we don't bother to clone it
 	    return ifp;
 	}
     }
@@ -287,10 +290,10 @@ private:
 	// Handle any assertions
 	replaceCaseParallel(nodep, m_caseNoOverlapsAllCovered);
 
-	AstNode::user3ClearTree();
+	++m_caseNum;  // Ifs made for earlier cases are now plain statements to clone
 	AstNode* ifrootp = replaceCaseFastRecurse(cexprp, m_caseWidth-1, 0UL);
 	// Case expressions can't be linked twice, so clone them
-	if (ifrootp && !ifrootp->user3()) ifrootp = ifrootp->cloneTree(true);
+	if (ifrootp && ifrootp->user3() != m_caseNum) ifrootp = ifrootp->cloneTree(true);
 
 	if (ifrootp) nodep->replaceWith(ifrootp);
 	else nodep->unlinkFrBack();
@@ -466,13 +469,27 @@ private:
 
 public:
     // CONSTUCTORS
-    CaseVisitor(AstNetlist* nodep) {
+    CaseVisitor(AstNodeModule* nodep) {
 	m_caseNoOverlapsAllCovered = false;
+	m_caseNum = 0;
 	nodep->accept(*this);
     }
-    virtual ~CaseVisitor() {
-	V3Stats::addStat("Optimizations, Cases parallelized", m_statCaseFast);
-	V3Stats::addStat("Optimizations, Cases complex", m_statCaseSlow);
+    virtual ~CaseVisitor() {}
+    V3Double0 statCaseFast() const { return m_statCaseFast; }
+    V3Double0 statCaseSlow() const { return m_statCaseSlow; }
+};
+
+class CaseJob : public V3ThreadJob {
+    // Convert the cases of one module, including all its scopes
+    AstNodeModule*	m_modp;
+public:
+    V3Double0		m_statCaseFast;	// Statistic tracking
+    V3Double0		m_statCaseSlow;	// Statistic tracking
+    explicit CaseJob(AstNodeModule* modp) : m_modp(modp) {}
+    virtual void run() {
+	CaseVisitor visitor (m_modp);
+	m_statCaseFast = visitor.statCaseFast();
+	m_statCaseSlow = visitor.statCaseSlow();
     }
 };
 
@@ -481,7 +498,22 @@ public:
 
 void V3Case::caseAll(AstNetlist* nodep) {
     UINFO(2,__FUNCTION__<<": "<<endl);
-    CaseVisitor visitor (nodep);
+    AstUser3InUse	inuser3;  // For all jobs; a job may not allocate user()s
+    // Process each module, in parallel under --build-jobs
+    vector<CaseJob*> jobs;
+    for (AstNodeModule* modp = nodep->modulesp(); modp; modp=modp->nextp()->castNodeModule()) {
+	jobs.push_back(new CaseJob(modp));
+    }
+    V3ThreadPool::runJobs(vector<V3ThreadJob*>(jobs.begin(), jobs.end()));
+    V3Double0 statCaseFast;
+    V3Double0 statCaseSlow;
+    for (vector<CaseJob*>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+	statCaseFast += (*it)->m_statCaseFast;
+	statCaseSlow += (*it)->m_statCaseSlow;
+	delete *it; *it=NULL;
+    }
+    V3Stats::addStat("Optimizations, Cases parallelized", statCaseFast);
+    V3Stats::addStat("Optimizations, Cases complex", statCaseSlow);
 }
 void V3Case::caseLint(AstNodeCase* nodep) {
     UINFO(4,__FUNCTION__<<": "<<endl);
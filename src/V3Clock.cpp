@@ -37,6 +37,7 @@
 #include <cstdarg>
 #include <unistd.h>
 #include <algorithm>
+#include <map>
 
 #include "V3Global.h"
 #include "V3Clock.h"
@@ -71,6 +72,8 @@ private:
     AstSenTree*		m_lastSenp;	// Last sensitivity match, so we can detect duplicates.
     AstIf*		m_lastIfp;	// Last sensitivity if active to add more under
     int			m_stableNum;	// Number of each untilstable
+    int			m_toggleNum;	// Number of each toggle coverage difference
+    map<int,AstVarScope*> m_toggleDiffs;	// Toggle coverage difference temp of each width, in current scope
 
     // METHODS
     static int debug() {
@@ -233,6 +236,8 @@ private:
 	    funcp->addInitsp(new AstCStmt(nodep->fileline(),
 					  EmitCBaseVisitor::symClassVar()+" = this->__VlSymsp;\n"));
 	    funcp->addInitsp(new AstCStmt(nodep->fileline(), EmitCBaseVisitor::symTopAssign()+"\n"));
+	    funcp->addInitsp(new AstCStmt(nodep->fileline(), "Verilated::threadContextp(vlSymsp->__Vm_contextp);\n"));
+	    funcp->addFinalsp(new AstCStmt(nodep->fileline(), "Verilated::displayFlush();\n"));
 	    m_scopep->addActivep(funcp);
 	    m_finalFuncp = funcp;
 	}
@@ -259,12 +264,14 @@ private:
 	//UINFO(4," MOD   "<<nodep<<endl);
 	m_modp = nodep;
 	m_stableNum = 0;
+	m_toggleNum = 0;
 	nodep->iterateChildren(*this);
 	m_modp= NULL;
     }
     virtual void visit(AstScope* nodep, AstNUser*) {
 	//UINFO(4," SCOPE   "<<nodep<<endl);
 	m_scopep = nodep;
+	m_toggleDiffs.clear();
 	nodep->iterateChildren(*this);
 	if (AstNode* movep = nodep->finalClksp()) {
 	    if (!m_topScopep) nodep->v3fatalSrc("Final clocks under non-top scope");
@@ -295,19 +302,41 @@ private:
 	//nodep->dumpTree(cout,"ct:");
 	//COVERTOGGLE(INC, ORIG, CHANGE) ->
 	//   IF(ORIG ^ CHANGE) { INC; CHANGE = ORIG; }
-	AstNode* incp = nodep->incp()->unlinkFrBack();
+	//COVERTOGGLE(INCS, ORIG, CHANGE) for wider elements, so the compare is done a word at a time ->
+	//   IF(ORIG != CHANGE) { DIFF = ORIG ^ CHANGE; IF(DIFF[bit]) INC; ...; CHANGE = ORIG; }
+	FileLine* fl = nodep->fileline();
 	AstNode* origp = nodep->origp()->unlinkFrBack();
 	AstNode* changep = nodep->changep()->unlinkFrBack();
-	AstIf* newp = new AstIf(nodep->fileline(),
-				new AstXor(nodep->fileline(),
-					   origp,
-					   changep),
-				incp, NULL);
+	AstCoverToggle::ToggleBits::const_iterator bitit = nodep->toggleBits().begin();
+	AstIf* newp;
+	if (nodep->toggleBits().size()==1 && bitit->first==0 && bitit->second==origp->width()) {
+	    newp = new AstIf(fl, new AstXor(fl, origp, changep),
+			     nodep->incsp()->unlinkFrBackWithNext(), NULL);
+	} else {
+	    // Each difference is only used under its IF, so one temp serves every element of a width
+	    AstVarScope*& diffVscp = m_toggleDiffs[origp->width()];
+	    if (!diffVscp) diffVscp = getCreateLocalVar(fl, "__Vtogdiff"+cvtToStr(++m_toggleNum),
+						       NULL, origp->width());
+	    newp = new AstIf(fl, new AstNeq(fl, origp, changep), NULL, NULL);
+	    newp->addIfsp(new AstAssign(fl, new AstVarRef(fl, diffVscp, true),
+					new AstXor(fl, origp->cloneTree(false),
+						   changep->cloneTree(false))));
+	    for (AstCoverInc* incp = nodep->incsp(); incp; ++bitit) {
+		AstCoverInc* nextp = incp->nextp()->castCoverInc();
+		incp->unlinkFrBack();
+		AstNode* condp = new AstSel(fl, new AstVarRef(fl, diffVscp, false),
+					    bitit->first, bitit->second);
+		if (bitit->second != 1) {
+		    condp = new AstRedOr(fl, condp);
+		}
+		newp->addIfsp(new AstIf(fl, condp, incp, NULL));
+		incp = nextp;
+	    }
+	}
 	// We could add another IF to detect posedges, and only increment if so.
 	// It's another whole branch though verus a potential memory miss.
 	// We'll go with the miss.
-	newp->addIfsp(new AstAssign(nodep->fileline(),
-				    changep->cloneTree(false),
+	newp->addIfsp(new AstAssign(fl, changep->cloneTree(false),
 				    origp->cloneTree(false)));
 	nodep->replaceWith(newp); nodep->deleteTree(); nodep=NULL;
     }
@@ -531,6 +560,7 @@ public:
 	m_lastIfp = NULL;
 	m_scopep = NULL;
 	m_stableNum = 0;
+	m_toggleNum = 0;
 	m_untilp = NULL;
 	//
 	nodep->accept(*this);
@@ -88,7 +88,8 @@ public:
 //######################################################################
 // Const state, as a visitor of each AstNode
 
-class ConstVisitor : public AstNVisitor {
+class ConstVisitor : public AstNVisitorStatic<ConstVisitor> {
+    friend class AstNVisitorStatic<ConstVisitor>;
 private:
     // NODE STATE
     // ** only when m_warn/m_doExpensive is set.  If state is needed other times,
@@ -373,7 +374,7 @@ private:
 	if (m_doGenerate) {
 	    // Never checked yet
 	    V3Width::widthParamsEdit(nodep);
-	    nodep->iterateChildren(*this);	// May need "constifying"
+	    iterateChildren(nodep);	// May need "constifying"
 	}
 	// Find range of dtype we are selecting from
 	// Similar code in V3Unknown::AstSel
@@ -546,14 +547,14 @@ private:
     //! Replace a ternary node with its RHS after iterating
     //! Used with short-circuting, where the RHS has not yet been iterated.
     void replaceWIteratedRhs(AstNodeTriop* nodep) {
-	if (AstNode *rhsp = nodep->rhsp()) rhsp->iterateAndNext(*this);
+	if (AstNode *rhsp = nodep->rhsp()) iterateAndNext(rhsp);
 	replaceWChild(nodep, nodep->rhsp());	// May have changed
     }
 
     //! Replace a ternary node with its THS after iterating
     //! Used with short-circuting, where the THS has not yet been iterated.
     void replaceWIteratedThs(AstNodeTriop* nodep) {
-	if (AstNode *thsp = nodep->thsp()) thsp->iterateAndNext(*this);
+	if (AstNode *thsp = nodep->thsp()) iterateAndNext(thsp);
 	replaceWChild(nodep, nodep->thsp());	// May have changed
     }
     void replaceWLhs(AstNodeUniop* nodep) {
@@ -713,7 +714,7 @@ private:
 	AstNodeBiop* newp = lhsp;
 	newp->lhsp(shift1p); newp->rhsp(shift2p);
 	handle.relink(newp);
-	newp->accept(*this);	// Further reduce, either node may have more reductions.
+	accept(newp);	// Further reduce, either node may have more reductions.
     }
     void replaceShiftShift (AstNodeBiop* nodep) {
 	UINFO(4,"SHIFT(SHIFT(a,s1),s2)->SHIFT(a,ADD(s1,s2)) "<<nodep<<endl);
@@ -725,7 +726,7 @@ private:
 	if (nodep->type()==lhsp->type()) {
 	    nodep->lhsp(ap);
 	    nodep->rhsp(new AstAdd(nodep->fileline(), shift1p, shift2p));
-	    nodep->accept(*this);	// Further reduce, either node may have more reductions.
+	    accept(nodep);	// Further reduce, either node may have more reductions.
 	} else {
 	    // We know shift amounts are constant, but might be a mixed left/right shift
 	    int shift1 = shift1p->castConst()->toUInt(); if (lhsp->castShiftR())  shift1=-shift1;
@@ -762,7 +763,7 @@ private:
 	    newp->dtypeFrom(nodep);
 	    nodep->replaceWith(newp); nodep->deleteTree(); nodep=NULL;
 	    //newp->dumpTree(cout, "  repShiftShift_new: ");
-	    newp->accept(*this);	// Further reduce, either node may have more reductions.
+	    accept(newp);	// Further reduce, either node may have more reductions.
 	}
 	lhsp->deleteTree(); lhsp=NULL;
     }
@@ -1000,21 +1001,21 @@ private:
     }
     virtual void visit(AstNodeModule* nodep, AstNUser*) {
 	m_modp = nodep;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_modp = NULL;
     }
     virtual void visit(AstCFunc* nodep, AstNUser*) {
 	// No ASSIGNW removals under funcs, we've long eliminated INITIALs
 	// (We should perhaps rename the assignw's to just assigns)
 	m_wremove = false;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_wremove = true;
     }
     virtual void visit(AstScope* nodep, AstNUser*) {
 	// No ASSIGNW removals under scope, we've long eliminated INITIALs
 	m_scopep = nodep;
 	m_wremove = false;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_wremove = true;
 	m_scopep = NULL;
     }
@@ -1026,7 +1027,7 @@ private:
 	AstNode* rhsp = nodep->rhsp()->unlinkFrBackWithNext();
 	nodep->lhsp(rhsp);
 	nodep->rhsp(lhsp);
-	nodep->accept(*this);  // Again?
+	accept(nodep);  // Again?
     }
 
     int operandConcatMove(AstConcat* nodep) {
@@ -1087,13 +1088,13 @@ private:
 
     virtual void visit(AstCell* nodep, AstNUser*) {
 	if (m_params) {
-	    nodep->paramsp()->iterateAndNext(*this);
+	    iterateAndNext(nodep->paramsp());
 	} else {
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
     }
     virtual void visit(AstPin* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 
     void replaceSelSel(AstSel* nodep) {
@@ -1216,16 +1217,16 @@ private:
     virtual void visit(AstAttrOf* nodep, AstNUser*) {
 	AstAttrOf* oldAttr = m_attrp;
 	m_attrp = nodep;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_attrp = oldAttr;
     }
     virtual void visit(AstVarRef* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (!nodep->varp()) nodep->v3fatalSrc("Not linked");
 	bool did=false;
 	if (m_doV && nodep->varp()->hasSimpleInit() && !m_attrp) {
 	    //if (debug()) nodep->varp()->valuep()->dumpTree(cout,"  visitvaref: ");
-	    nodep->varp()->valuep()->iterateAndNext(*this);
+	    iterateAndNext(nodep->varp()->valuep());
 	    if (operandConst(nodep->varp()->valuep())
 		&& !nodep->lvalue()
 		&& ((!m_params // Can reduce constant wires into equations
@@ -1247,12 +1248,12 @@ private:
 	}
     }
     virtual void visit(AstEnumItemRef* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (!nodep->itemp()) nodep->v3fatalSrc("Not linked");
 	bool did=false;
 	if (nodep->itemp()->valuep()) {
 	    //if (debug()) nodep->varp()->valuep()->dumpTree(cout,"  visitvaref: ");
-	    nodep->itemp()->valuep()->iterateAndNext(*this);
+	    iterateAndNext(nodep->itemp()->valuep());
 	    if (AstConst* valuep = nodep->itemp()->valuep()->castConst()) {
 		const V3Number& num = valuep->num();
 		replaceNum(nodep, num); nodep=NULL;
@@ -1273,7 +1274,7 @@ private:
 	return (!nodep->nextp() && nodep->backp()->nextp() != nodep);
     }
     virtual void visit(AstSenItem* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_doNConst
 	    && (nodep->sensp()->castConst()
 		|| nodep->sensp()->castEnumItemRef()
@@ -1313,7 +1314,7 @@ private:
 	}
     }
     virtual void visit(AstSenGate* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (AstConst* constp = nodep->rhsp()->castConst()) {
 	    if (constp->isZero()) {
 		UINFO(4,"SENGATE(...,0)->NEVER"<<endl);
@@ -1359,7 +1360,7 @@ private:
     };
 
     virtual void visit(AstSenTree* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_doExpensive) {
 	    //cout<<endl; nodep->dumpTree(cout,"ssin: ");
 	    // Optimize ideas for the future:
@@ -1463,7 +1464,7 @@ private:
     //-----
     // Zero elimination
     virtual void visit(AstNodeAssign* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_doNConst && replaceNodeAssign(nodep)) return;
     }
     virtual void visit(AstAssignAlias* nodep, AstNUser*) {
@@ -1473,7 +1474,7 @@ private:
 	// Don't perform any optimizations, the node won't be linked yet
     }
     virtual void visit(AstAssignW* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_doNConst && replaceNodeAssign(nodep)) return;
 	AstNodeVarRef* varrefp = nodep->lhsp()->castVarRef();  // Not VarXRef, as different refs may set different values to each hierarchy
 	if (m_wremove && !m_params && m_doNConst
@@ -1500,7 +1501,7 @@ private:
     }
 
     virtual void visit(AstNodeIf* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_doNConst) {
 	    if (AstConst* constp = nodep->condp()->castConst()) {
 		AstNode* keepp = NULL;
@@ -1581,7 +1582,7 @@ private:
 	// Substitute constants into displays.  The main point of this is to
 	// simplify assertion methodologies which call functions with display's.
 	// This eliminates a pile of wide temps, and makes the C a whole lot more readable.
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	bool anyconst = false;
 	for (AstNode* argp = nodep->exprsp(); argp; argp=argp->nextp()) {
 	    if (argp->castConst()) { anyconst=true; break; }
@@ -1641,17 +1642,17 @@ private:
     }
 
     virtual void visit(AstFuncRef* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_params) {  // Only parameters force us to do constant function call propagation
 	    replaceWithSimulation(nodep);
 	}
     }
     virtual void visit(AstArg* nodep, AstNUser*) {
 	// replaceWithSimulation on the Arg's parent FuncRef replaces these
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstWhile* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_doNConst) {
 	    if (nodep->condp()->isZero()) {
 		UINFO(4,"WHILE(0) => nop "<<nodep<<endl);
@@ -1671,7 +1672,7 @@ private:
 
     // Ignored, can eliminate early
     virtual void visit(AstSysIgnore* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_doNConst) {
 	    nodep->unlinkFrBack()->deleteTree(); nodep=NULL;
 	}
@@ -1679,7 +1680,7 @@ private:
 
     // Simplify
     virtual void visit(AstBasicDType* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	nodep->cvtRangeConst();
     }
 
@@ -1687,7 +1688,7 @@ private:
     // Jump elimination
 
     virtual void visit(AstJumpGo* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_doExpensive) { nodep->labelp()->user4(true); }
     }
 
@@ -1695,7 +1696,7 @@ private:
 	// Because JumpLabels disable many optimizations,
 	// remove JumpLabels that are not pointed to by any AstJumpGos
 	// Note this assumes all AstJumpGos are underneath the given label; V3Broken asserts this
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	// AstJumpGo's below here that point to this node will set user4
 	if (m_doExpensive && !nodep->user4()) {
 	    UINFO(4,"JUMPLABEL => unused "<<nodep<<endl);
@@ -2000,7 +2001,7 @@ private:
 	    if (m_params && !nodep->width()) {
 		nodep = V3Width::widthParamsEdit(nodep);
 	    }
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
     }
 
@@ -168,6 +168,8 @@ private:
 		// Create bucket for each dimension * bit.
 		// This is necessarily an O(n^2) expansion, which is why
 		// we limit coverage to signals with < 256 bits.
+		// Buckets are grouped per packed element, so the
+		// change detect is done a word at a time.
 
 		ToggleEnt newvec (string(""),
 				  new AstVarRef(nodep->fileline(), nodep, false),
@@ -182,92 +184,93 @@ private:
     void toggleVarBottom(AstNodeDType* dtypep, int depth, // per-iteration
 		     const ToggleEnt& above,
 		     AstVar* varp, AstVar* chgVarp) { // Constant
+	// One AstCoverToggle per packed element; the bits below it are
+	// compared as a whole word, see V3Clock.
 	AstCoverToggle* newp
 	    = new AstCoverToggle (varp->fileline(),
-				  newCoverInc(varp->fileline(), "", "v_toggle",
-					      varp->name()+above.m_comment),
 				  above.m_varRefp->cloneTree(true),
 				  above.m_chgRefp->cloneTree(true));
+	toggleBitsRecurse(dtypep, 0, above.m_comment, newp, varp);
 	m_modp->addStmtp(newp);
     }
 
-    void toggleVarRecurse(AstNodeDType* dtypep, int depth, // per-iteration
-		     const ToggleEnt& above,
-		     AstVar* varp, AstVar* chgVarp) { // Constant
+    void toggleBitsRecurse(AstNodeDType* dtypep, int lsb, const string& comment, // per-iteration
+			   AstCoverToggle* togglep, AstVar* varp) { // Constant
+	// Add a coverage bucket for each bit of a packed element, lsb relative to the element
 	if (AstBasicDType* bdtypep = dtypep->castBasicDType()) {
 	    if (bdtypep->isRanged()) {
 		for (int index_docs=bdtypep->lsb(); index_docs<bdtypep->msb()+1; index_docs++) {
 		    int index_code = index_docs - bdtypep->lsb();
-		    ToggleEnt newent (above.m_comment+string("[")+cvtToStr(index_docs)+"]",
-				      new AstSel(varp->fileline(), above.m_varRefp->cloneTree(true), index_code, 1),
-				      new AstSel(varp->fileline(), above.m_chgRefp->cloneTree(true), index_code, 1));
-		    toggleVarBottom(dtypep, depth+1,
-				    newent,
-				    varp, chgVarp);
-		    newent.cleanup();
+		    newToggleInc(comment+string("[")+cvtToStr(index_docs)+"]",
+				 lsb+index_code, 1, togglep, varp);
 		}
 	    } else {
-		toggleVarBottom(dtypep, depth+1,
-				above,
-				varp, chgVarp);
-	    }
-	}
-	else if (AstUnpackArrayDType* adtypep = dtypep->castUnpackArrayDType()) {
-	    for (int index_docs=adtypep->lsb(); index_docs<=adtypep->msb(); ++index_docs) {
-		int index_code = index_docs - adtypep->lsb();
-		ToggleEnt newent (above.m_comment+string("[")+cvtToStr(index_docs)+"]",
-				  new AstArraySel(varp->fileline(), above.m_varRefp->cloneTree(true), index_code),
-				  new AstArraySel(varp->fileline(), above.m_chgRefp->cloneTree(true), index_code));
-		toggleVarRecurse(adtypep->subDTypep()->skipRefp(), depth+1,
-				 newent,
-				 varp, chgVarp);
-		newent.cleanup();
+		newToggleInc(comment, lsb, dtypep->width(), togglep, varp);
 	    }
 	}
 	else if (AstPackArrayDType* adtypep = dtypep->castPackArrayDType()) {
 	    for (int index_docs=adtypep->lsb(); index_docs<=adtypep->msb(); ++index_docs) {
 		AstNodeDType* subtypep = adtypep->subDTypep()->skipRefp();
 		int index_code = index_docs - adtypep->lsb();
-		ToggleEnt newent (above.m_comment+string("[")+cvtToStr(index_docs)+"]",
-				  new AstSel(varp->fileline(), above.m_varRefp->cloneTree(true),
-					     index_code*subtypep->width(), subtypep->width()),
-				  new AstSel(varp->fileline(), above.m_chgRefp->cloneTree(true),
-					     index_code*subtypep->width(), subtypep->width()));
-		toggleVarRecurse(adtypep->subDTypep()->skipRefp(), depth+1,
-				 newent,
-				 varp, chgVarp);
-		newent.cleanup();
+		toggleBitsRecurse(subtypep, lsb + index_code*subtypep->width(),
+				  comment+string("[")+cvtToStr(index_docs)+"]",
+				  togglep, varp);
 	    }
 	}
 	else if (AstStructDType* adtypep = dtypep->castStructDType()) {
 	    // For now it's packed, so similar to array
 	    for (AstMemberDType* itemp = adtypep->membersp(); itemp; itemp=itemp->nextp()->castMemberDType()) {
 		AstNodeDType* subtypep = itemp->subDTypep()->skipRefp();
-		int index_code = itemp->lsb();
-		ToggleEnt newent (above.m_comment+string(".")+itemp->name(),
-				  new AstSel(varp->fileline(), above.m_varRefp->cloneTree(true),
-					     index_code, subtypep->width()),
-				  new AstSel(varp->fileline(), above.m_chgRefp->cloneTree(true),
-					     index_code, subtypep->width()));
-		toggleVarRecurse(subtypep, depth+1,
-				 newent,
-				 varp, chgVarp);
-		newent.cleanup();
+		toggleBitsRecurse(subtypep, lsb + itemp->lsb(),
+				  comment+string(".")+itemp->name(),
+				  togglep, varp);
 	    }
 	}
 	else if (AstUnionDType* adtypep = dtypep->castUnionDType()) {
 	    // Arbitrarially handle only the first member of the union
 	    if (AstMemberDType* itemp = adtypep->membersp()) {
 		AstNodeDType* subtypep = itemp->subDTypep()->skipRefp();
-		ToggleEnt newent (above.m_comment+string(".")+itemp->name(),
-				  above.m_varRefp->cloneTree(true),
-				  above.m_chgRefp->cloneTree(true));
-		toggleVarRecurse(subtypep, depth+1,
+		toggleBitsRecurse(subtypep, lsb,
+				  comment+string(".")+itemp->name(),
+				  togglep, varp);
+	    }
+	}
+	else {
+	    dtypep->v3fatalSrc("Unexpected node data type in toggle coverage generation: "<<dtypep->prettyTypeName());
+	}
+    }
+
+    void newToggleInc(const string& comment, int lsb, int width,
+		      AstCoverToggle* togglep, AstVar* varp) {
+	togglep->addIncp(newCoverInc(varp->fileline(), "", "v_toggle",
+				     varp->name()+comment),
+			 lsb, width);
+    }
+
+    void toggleVarRecurse(AstNodeDType* dtypep, int depth, // per-iteration
+		     const ToggleEnt& above,
+		     AstVar* varp, AstVar* chgVarp) { // Constant
+	if (AstUnpackArrayDType* adtypep = dtypep->castUnpackArrayDType()) {
+	    for (int index_docs=adtypep->lsb(); index_docs<=adtypep->msb(); ++index_docs) {
+		int index_code = index_docs - adtypep->lsb();
+		ToggleEnt newent (above.m_comment+string("[")+cvtToStr(index_docs)+"]",
+				  new AstArraySel(varp->fileline(), above.m_varRefp->cloneTree(true), index_code),
+				  new AstArraySel(varp->fileline(), above.m_chgRefp->cloneTree(true), index_code));
+		toggleVarRecurse(adtypep->subDTypep()->skipRefp(), depth+1,
 				 newent,
 				 varp, chgVarp);
 		newent.cleanup();
 	    }
 	}
+	else if (dtypep->castBasicDType()
+		 || dtypep->castPackArrayDType()
+		 || dtypep->castStructDType()
+		 || dtypep->castUnionDType()) {
+	    // Packed, so covered a word at a time
+	    toggleVarBottom(dtypep, depth+1,
+			    above,
+			    varp, chgVarp);
+	}
 	else {
 	    dtypep->v3fatalSrc("Unexpected node data type in toggle coverage generation: "<<dtypep->prettyTypeName());
 	}
@@ -34,6 +34,19 @@
 #include "V3Hashed.h"
 #include "V3Stats.h"
 
+//######################################################################
+// Auxiliary hash check for CoverageJoinVisitor
+
+class CoverageJoinSameBits : public V3HashedUserCheck {
+    // Toggles of the same value may only be joined if their buckets are for the same bits
+public:
+    virtual bool check(AstNode* node1p, AstNode* node2p) {
+	AstCoverToggle* toggle1p = node1p->backp()->castCoverToggle();
+	AstCoverToggle* toggle2p = node2p->backp()->castCoverToggle();
+	return toggle1p && toggle2p && toggle1p->toggleBits() == toggle2p->toggleBits();
+    }
+};
+
 //######################################################################
 // CoverageJoin state, as a visitor of each AstNode
 
@@ -64,6 +77,7 @@ private:
 	UINFO(9,"Finding duplicates\n");
 	// Note uses user4
 	V3Hashed  hashed;	// Duplicate code detection
+	CoverageJoinSameBits sameBits;
 	// Hash all of the original signals we toggle cover
 	for (ToggleList::iterator it = m_toggleps.begin(); it != m_toggleps.end(); ++it) {
 	    AstCoverToggle* nodep = *it;
@@ -76,7 +90,7 @@ private:
 		// Want to choose a base node, and keep finding duplicates that are identical
 		// This prevents making chains where a->b, then c->d, then b->c, as we'll find a->b, a->c, a->d directly.
 		while (1) {
-		    V3Hashed::iterator dupit = hashed.findDuplicate(nodep->origp());
+		    V3Hashed::iterator dupit = hashed.findDuplicate(nodep->origp(), &sameBits);
 		    if (dupit == hashed.end()) break;
 		    //
 		    AstNode* duporigp = hashed.iteratorNodep(dupit);
@@ -84,19 +98,23 @@ private:
 		    // but we need to get back to the covertoggle which is immediately above, so:
 		    AstCoverToggle* removep = duporigp->backp()->castCoverToggle();
 		    if (!removep) nodep->v3fatalSrc("CoverageJoin duplicate of wrong type");
-		    UINFO(8,"  Orig "<<nodep<<" -->> "<<nodep->incp()->declp()<<endl);
-		    UINFO(8,"   dup "<<removep<<" -->> "<<removep->incp()->declp()<<endl);
-		    // The CoverDecl the duplicate pointed to now needs to point to the original's data
+		    // The CoverDecls the duplicate pointed to now needs to point to the original's data
 		    // IE the duplicate will get the coverage number from the non-duplicate
-		    AstCoverDecl* datadeclp = nodep->incp()->declp()->dataDeclThisp();
-		    removep->incp()->declp()->dataDeclp (datadeclp);
-		    UINFO(8,"   new "<<removep->incp()->declp()<<endl);
+		    AstCoverInc* removeincp = removep->incsp();
+		    for (AstCoverInc* incp = nodep->incsp(); incp;
+			 incp = incp->nextp()->castCoverInc(), removeincp = removeincp->nextp()->castCoverInc()) {
+			UINFO(8,"  Orig "<<nodep<<" -->> "<<incp->declp()<<endl);
+			UINFO(8,"   dup "<<removep<<" -->> "<<removeincp->declp()<<endl);
+			AstCoverDecl* datadeclp = incp->declp()->dataDeclThisp();
+			removeincp->declp()->dataDeclp (datadeclp);
+			UINFO(8,"   new "<<removeincp->declp()<<endl);
+			++m_statToggleJoins;
+		    }
 		    // Mark the found node as a duplicate of the first node
 		    // (Not vice-versa as we have the iterator for the found node)
 		    removep->unlinkFrBack();  pushDeletep(removep); removep=NULL;
 		    // Remove node from comparison so don't hit it again
 		    hashed.erase(dupit);
-		    ++m_statToggleJoins;
 		}
 	    }
 	}
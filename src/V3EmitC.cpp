@@ -25,6 +25,7 @@
 #include <unistd.h>
 #include <cmath>
 #include <map>
+#include <set>
 #include <vector>
 #include <algorithm>
 
@@ -32,12 +33,83 @@
 #include "V3String.h"
 #include "V3EmitC.h"
 #include "V3EmitCBase.h"
+#include "V3ThreadPool.h"
+#include "V3Stats.h"
 
 #define VL_VALUE_STRING_MAX_WIDTH 8192	// We use a static char array in VL_VALUE_STRING
 
+//######################################################################
+// Output files
+
+class EmitCFiles {
+    // Files a V3ThreadJob wrote, added to the netlist afterwards in job order,
+    // as AstNodes can't be created inside a job
+    struct Ent {
+	string	m_filename;
+	bool	m_slow;
+	bool	m_source;
+	bool	m_support;
+	Ent(const string& filename, bool slow, bool source, bool support)
+	    : m_filename(filename), m_slow(slow), m_source(source), m_support(support) {}
+    };
+    vector<Ent>	m_ents;
+public:
+    void add(const string& filename, bool slow, bool source, bool support=false) {
+	m_ents.push_back(Ent(filename, slow, source, support));
+    }
+    void addToNetlist() {
+	for (vector<Ent>::iterator it = m_ents.begin(); it != m_ents.end(); ++it) {
+	    AstCFile* cfilep = new AstCFile(v3Global.rootp()->fileline(), it->m_filename);
+	    cfilep->slow(it->m_slow);
+	    cfilep->source(it->m_source);
+	    cfilep->support(it->m_support);
+	    v3Global.rootp()->addFilesp(cfilep);
+	}
+	m_ents.clear();
+    }
+};
+
+class EmitCStats {
+    // Statistics a V3ThreadJob gathered, added to V3Stats afterwards
+public:
+    V3Double0	m_statResetArrays;	// Unpacked arrays reset with one call
+    V3Double0	m_statResetRuns;	// Runs of scalars reset with one call
+    V3Double0	m_statResetRunVars;	// Scalars reset as part of a run
+    V3Double0	m_statResetEach;	// Variables reset by their own statement or loop nest
+    void add(const EmitCStats& from) {
+	m_statResetArrays += from.m_statResetArrays;
+	m_statResetRuns += from.m_statResetRuns;
+	m_statResetRunVars += from.m_statResetRunVars;
+	m_statResetEach += from.m_statResetEach;
+    }
+    void addToStats() {
+	V3Stats::addStat("Reset, arrays in one call", m_statResetArrays);
+	V3Stats::addStat("Reset, scalar runs in one call", m_statResetRuns);
+	V3Stats::addStat("Reset, scalars in runs", m_statResetRunVars);
+	V3Stats::addStat("Reset, variables one at a time", m_statResetEach);
+    }
+};
+
 //######################################################################
 // Emit statements and math operators
 
+struct EmitDispState {
+    string		m_format;	// "%s" and text from user
+    vector<AstNode*>	m_argsp;	// Each argument to be printed
+    vector<string>	m_argsFunc;	// Function before each argument to be printed
+    EmitDispState() { clear(); }
+    void clear() {
+	m_format = "";
+	m_argsp.clear();
+	m_argsFunc.clear();
+    }
+    void pushFormat(const string& fmt) { m_format += fmt; }
+    void pushFormat(char fmt) { m_format += fmt; }
+    void pushArg(AstNode* nodep, const string& func) {
+	m_argsp.push_back(nodep); m_argsFunc.push_back(func);
+    }
+};
+
 class EmitCStmts : public EmitCBaseVisitor {
 private:
     bool	m_suppressSemi;
@@ -45,6 +117,7 @@ private:
     vector<AstVar*>		m_ctorVarsVec;		// All variables in constructor order
     int		m_splitSize;	// # of cfunc nodes placed into output file
     int		m_splitFilenum;	// File number being created, 0 = primary
+    EmitDispState	m_dispState;	// Display being formed; only one at once
 
 public:
     // METHODS
@@ -67,6 +140,7 @@ public:
     void displayNode(AstNode* nodep, AstScopeName* scopenamep,
 		     const string& vformat, AstNode* exprsp, bool isScan);
     void displayEmit(AstNode* nodep, bool isScan);
+    void displayFormatOps(const string& format);
     void displayArg(AstNode* dispp, AstNode** elistp, bool isScan,
 		    string vfmt, char fmtLetter);
 
@@ -348,10 +422,18 @@ public:
 	putbs(", ");
 	nodep->filenamep()->iterateAndNext(*this);
 	putbs(", ");
+	bool sparse = nodep->memp()->castVarRef() && nodep->memp()->castVarRef()->varp()->isSparse();
+	if (sparse) puts("&(");
 	nodep->memp()->iterateAndNext(*this);
+	if (sparse) puts(")");
 	putbs(","); if (nodep->lsbp()) { nodep->lsbp()->iterateAndNext(*this); }
 	else puts(cvtToStr(array_lsb));
 	putbs(","); if (nodep->msbp()) { nodep->msbp()->iterateAndNext(*this); } else puts("~0");
+	if (sparse) {
+	    putbs(", ");
+	    nodep->memp()->iterateAndNext(*this);
+	    puts(".entryCb");
+	}
 	puts(");\n");
     }
     virtual void visit(AstFClose* nodep, AstNUser*) {
@@ -363,7 +445,7 @@ public:
     }
     virtual void visit(AstFFlush* nodep, AstNUser*) {
 	if (!nodep->filep()) {
-	    puts("fflush (stdout);\n");
+	    puts("Verilated::displayFlush(); fflush (stdout);\n");
 	} else {
 	    puts("if (");
 	    nodep->filep()->iterateAndNext(*this);
@@ -534,6 +616,18 @@ public:
 	// Note ASSIGN checks for this on a LHS
 	emitOpName(nodep, nodep->emitC(), nodep->fromp(), nodep->lsbp(), nodep->thsp());
     }
+    virtual void visit(AstArraySel* nodep, AstNUser* vup) {
+	AstVarRef* varrefp = nodep->fromp()->castVarRef();
+	if (varrefp && varrefp->varp()->isSparse() && !varrefp->lvalue()) {
+	    // Reading with [] would allocate the entry's page, see VlSparseArray::read
+	    nodep->fromp()->iterateAndNext(*this);
+	    puts(".read(");
+	    nodep->bitp()->iterateAndNext(*this);
+	    puts(")");
+	} else {
+	    visit(nodep->castNodeBiop(), vup);
+	}
+    }
     virtual void visit(AstReplicate* nodep, AstNUser*) {
 	if (nodep->lhsp()->widthMin() == 1 && !nodep->isWide()) {
 	    if (((int)nodep->rhsp()->castConst()->toUInt()
@@ -652,21 +746,51 @@ public:
     virtual ~EmitCStmts() {}
 };
 
+//######################################################################
+// Find VPI visible variables a function writes
+
+class EmitCVpiDirtyVisitor : public EmitCBaseVisitor {
+    // MEMBERS
+    vector<string>	m_marks;	// Value change marks to set, in order found
+    set<string>		m_found;	// Marks already in m_marks
+
+    // VISITORS
+    virtual void visit(AstVarRef* nodep, AstNUser*) {
+	if (nodep->lvalue() && vpiDirtyVar(nodep->varp())) {
+	    string mark = nodep->hiername()+vpiDirtyName(nodep->varp());
+	    if (m_found.insert(mark).second) m_marks.push_back(mark);
+	}
+    }
+    virtual void visit(AstNode* nodep, AstNUser*) {
+	nodep->iterateChildren(*this);
+    }
+public:
+    // CONSTRUCTORS
+    explicit EmitCVpiDirtyVisitor(AstCFunc* nodep) {
+	nodep->iterateChildren(*this);
+    }
+    virtual ~EmitCVpiDirtyVisitor() {}
+    const vector<string>& marks() const { return m_marks; }
+};
+
 //######################################################################
 // Internal EmitC implementation
 
 class EmitCImp : EmitCStmts {
     // MEMBERS
+    EmitCFiles*	m_filesp;	// Files written, for the netlist
+    EmitCStats*	m_statsp;	// Statistics
     AstNodeModule*	m_modp;
+    vector<AstVar*>	m_resetRun;	// Scalars of the same width, to reset in one call
     vector<AstChangeDet*>	m_blkChangeDetVec;	// All encountered changes in block
     bool	m_slow;		// Creating __Slow file
     bool	m_fast;		// Creating non __Slow file (or both)
+    int		m_addDoubleOr;	// Terms left before next || in doubleOrDetect
 
     //---------------------------------------
     // METHODS
 
     void doubleOrDetect(AstChangeDet* changep, bool& gotOne) {
-	static int addDoubleOr = 10;	// Determined experimentally as best
 	if (!changep->rhsp()) {
 	    if (!gotOne) gotOne = true;
 	    else puts(" | ");
@@ -680,11 +804,11 @@ class EmitCImp : EmitCStmts {
 	    for (int word=0; word<changep->lhsp()->widthWords(); word++) {
 		if (!gotOne) {
 		    gotOne = true;
-		    addDoubleOr = 10;	// Determined experimentally as best
+		    m_addDoubleOr = 10;	// Determined experimentally as best
 		    puts("(");
-		} else if (--addDoubleOr == 0) {
+		} else if (--m_addDoubleOr == 0) {
 		    puts("|| (");
-		    addDoubleOr = 10;
+		    m_addDoubleOr = 10;
 		} else {
 		    puts(" | (");
 		}
@@ -707,22 +831,22 @@ class EmitCImp : EmitCStmts {
 	    // Unfortunately we have some lint checks here, so we can't just skip processing.
 	    // We should move them to a different stage.
 	    string filename = "/dev/null";
-	    newCFile(filename, slow, source);
+	    m_filesp->add(filename, slow, source);
 	    ofp = new V3OutSpFile (filename);
 	}
 	else if (optSystemPerl()) {
 	    string filename = filenameNoExt+".sp";
-	    newCFile(filename, slow, source);
+	    m_filesp->add(filename, slow, source);
 	    ofp = new V3OutSpFile (filename);
 	}
 	else if (optSystemC()) {
 	    string filename = filenameNoExt+(source?".cpp":".h");
-	    newCFile(filename, slow, source);
+	    m_filesp->add(filename, slow, source);
 	    ofp = new V3OutScFile (filename);
 	}
 	else {
 	    string filename = filenameNoExt+(source?".cpp":".h");
-	    newCFile(filename, slow, source);
+	    m_filesp->add(filename, slow, source);
 	    ofp = new V3OutCFile  (filename);
 	}
 
@@ -784,6 +908,15 @@ class EmitCImp : EmitCStmts {
 
 	nodep->initsp()->iterateAndNext(*this);
 
+	{
+	    // Callbacks run after eval, so marking before the writes is as good as after
+	    EmitCVpiDirtyVisitor dirtyVisitor (nodep);
+	    if (!dirtyVisitor.marks().empty()) puts("// VPI value change marks\n");
+	    for (vector<string>::const_iterator it = dirtyVisitor.marks().begin(); it != dirtyVisitor.marks().end(); ++it) {
+		puts(*it+" = 1;\n");
+	    }
+	}
+
 	if (nodep->stmtsp()) puts("// Body\n");
 	nodep->stmtsp()->iterateAndNext(*this);
 #ifndef NEW_ORDERING
@@ -846,11 +979,15 @@ class EmitCImp : EmitCStmts {
     // METHODS
     // Low level
     void emitVarResets(AstNodeModule* modp);
+    bool emitVarResetBulk(AstVar* varp);
+    bool emitVarResetRun(AstVar* varp);
+    void emitVarResetRunFlush();
     void emitCellCtors(AstNodeModule* modp);
     void emitSensitives();
     // Medium level
     void emitCtorImp(AstNodeModule* modp);
     void emitConfigureImp(AstNodeModule* modp);
+    void emitVpiDirtyDecl(AstNodeModule* modp);
     void emitCoverageDecl(AstNodeModule* modp);
     void emitCoverageImp(AstNodeModule* modp);
     void emitDestructorImp(AstNodeModule* modp);
@@ -865,10 +1002,13 @@ class EmitCImp : EmitCStmts {
     void writeMakefile(string filename);
 
 public:
-    EmitCImp() {
+    EmitCImp(EmitCFiles* filesp, EmitCStats* statsp) {
+	m_filesp = filesp;
+	m_statsp = statsp;
 	m_modp = NULL;
 	m_slow = false;
 	m_fast = false;
+	m_addDoubleOr = 10;
     }
     virtual ~EmitCImp() {}
     void main(AstNodeModule* modp, bool slow, bool fast);
@@ -926,6 +1066,20 @@ void EmitCStmts::emitVarDecl(AstVar* nodep, const string& prefixIfImp) {
 	puts(nodep->vlArgType(true,false));
 	emitDeclArrayBrackets(nodep);
 	puts(";\n");
+    } else if (nodep->isSparse()) {
+	// Only a table of page pointers is in the class
+	ofp()->putAlign(nodep->isStatic(), sizeof(void*));
+	if (nodep->widthMin() <= 8) puts("VL_SPARSE8(");
+	else if (nodep->widthMin() <= 16) puts("VL_SPARSE16(");
+	else if (nodep->isQuad()) puts("VL_SPARSE64(");
+	else if (!nodep->isWide()) puts("VL_SPARSE(");
+	else puts("VL_SPARSEW(");
+	puts(nodep->name());
+	puts(","+cvtToStr(nodep->dtypep()->arrayUnpackedElements()));
+	puts(","+cvtToStr(basicp->lsb()+nodep->width()-1)
+	     +","+cvtToStr(basicp->lsb()));
+	if (nodep->isWide()) puts(","+cvtToStr(nodep->widthWords()));
+	puts(");\n");
     } else {
 	// Arrays need a small alignment, but may need different padding after.
 	// For example three VL_SIG8's needs alignment 1 but size 3.
@@ -1086,30 +1240,19 @@ void EmitCStmts::emitOpName(AstNode* nodep, const string& format,
 //----------------------------------------------------------------------
 // Mid level - VISITS
 
-// We only do one display at once, so can just use static state
-
-struct EmitDispState {
-    string		m_format;	// "%s" and text from user
-    vector<AstNode*>	m_argsp;	// Each argument to be printed
-    vector<string>	m_argsFunc;	// Function before each argument to be printed
-    EmitDispState() { clear(); }
-    void clear() {
-	m_format = "";
-	m_argsp.clear();
-	m_argsFunc.clear();
-    }
-    void pushFormat(const string& fmt) { m_format += fmt; }
-    void pushFormat(char fmt) { m_format += fmt; }
-    void pushArg(AstNode* nodep, const string& func) {
-	m_argsp.push_back(nodep); m_argsFunc.push_back(func);
-    }
-} emitDispState;
 
 void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
-    if (emitDispState.m_format == ""
+    if (m_dispState.m_format == ""
 	&& nodep->castDisplay()) { // not fscanf etc, as they need to return value
 	// NOP
     } else {
+	// Statements can declare the format precompiled, so the runtime needn't parse it
+	bool precompiled = nodep->castDisplay() || nodep->castSFormat();
+	if (precompiled) {
+	    puts("{ static const VerilatedFormatOp __Vfmt[] = {");
+	    displayFormatOps(m_dispState.m_format);
+	    puts("};\n");
+	}
 	// Format
 	bool isStmt = false;
 	if (AstFScanF* dispp = nodep->castFScanF()) {
@@ -1149,12 +1292,13 @@ void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
 	    isStmt = true;
 	    nodep->v3fatalSrc("Unknown displayEmit node type");
 	}
-	ofp()->putsQuoted(emitDispState.m_format);
+	if (precompiled) puts("__Vfmt");
+	else ofp()->putsQuoted(m_dispState.m_format);
 	// Arguments
-	for (unsigned i=0; i < emitDispState.m_argsp.size(); i++) {
+	for (unsigned i=0; i < m_dispState.m_argsp.size(); i++) {
 	    puts(",");
-	    AstNode* argp = emitDispState.m_argsp[i];
-	    string   func = emitDispState.m_argsFunc[i];
+	    AstNode* argp = m_dispState.m_argsp[i];
+	    string   func = m_dispState.m_argsFunc[i];
 	    ofp()->indentInc();
 	    ofp()->putbs("");
 	    if (func!="") puts(func);
@@ -1169,9 +1313,54 @@ void EmitCStmts::displayEmit(AstNode* nodep, bool isScan) {
 	puts(")");
 	if (isStmt) puts(";\n");
 	else puts(" ");
+	if (precompiled) puts("}\n");
 	// Prep for next
-	emitDispState.clear();
+	m_dispState.clear();
+    }
+}
+
+void EmitCStmts::displayFormatOps(const string& format) {
+    // Split a _vl_vsformat style format into VerilatedFormatOp initializers,
+    // each the literal text preceding one argument's format code
+    string text;
+    string::size_type pctPos = 0;
+    bool inPct = false;
+    bool widthSet = false;
+    int width = 0;
+    for (string::size_type pos = 0; pos < format.length(); ++pos) {
+	char ch = format[pos];
+	if (!inPct && ch=='%') {
+	    pctPos = pos;
+	    inPct = true;
+	    widthSet = false;
+	    width = 0;
+	} else if (!inPct) {   // Normal text
+	    text += ch;
+	} else if (isdigit(ch)) {
+	    widthSet = true;
+	    width = width*10 + (ch - '0');
+	} else if (ch=='.') {
+	    // Precision only matters to reals, which keep the whole format
+	} else if (ch=='%') {
+	    inPct = false;
+	    text += ch;
+	} else { // Format character
+	    inPct = false;
+	    bool isReal = (ch=='e' || ch=='f' || ch=='g');
+	    puts("{"); ofp()->putsQuoted(text);
+	    puts(","+cvtToStr(text.length()));
+	    puts(",'"+string(1,ch)+"'");
+	    puts((pctPos+1 < format.length() && format[pctPos+1]=='0') ? ",true" : ",false");
+	    puts(","+cvtToStr(widthSet ? width : -1)+",");
+	    if (isReal) ofp()->putsQuoted(format.substr(pctPos, pos-pctPos+1));
+	    else puts("NULL");
+	    puts("},");
+	    ofp()->putbs("");
+	    text = "";
+	}
     }
+    puts("{"); ofp()->putsQuoted(text);
+    puts(","+cvtToStr(text.length())+",'\\0',false,-1,NULL}");
 }
 
 void EmitCStmts::displayArg(AstNode* dispp, AstNode** elistp, bool isScan,
@@ -1209,9 +1398,9 @@ void EmitCStmts::displayArg(AstNode* dispp, AstNode** elistp, bool isScan,
     } else {
 	pfmt = string("%") + vfmt + fmtLetter;
     }
-    emitDispState.pushFormat(pfmt);
-    emitDispState.pushArg(NULL,cvtToStr(argp->widthMin()));
-    emitDispState.pushArg(argp,"");
+    m_dispState.pushFormat(pfmt);
+    m_dispState.pushArg(NULL,cvtToStr(argp->widthMin()));
+    m_dispState.pushArg(argp,"");
 
     // Next parameter
     *elistp = (*elistp)->nextp();
@@ -1224,7 +1413,7 @@ void EmitCStmts::displayNode(AstNode* nodep, AstScopeName* scopenamep,
 
     // Convert Verilog display to C printf formats
     // 		"%0t" becomes "%d"
-    emitDispState.clear();
+    m_dispState.clear();
     string vfmt = "";
     string::const_iterator pos = vformat.begin();
     bool inPct = false;
@@ -1234,7 +1423,7 @@ void EmitCStmts::displayNode(AstNode* nodep, AstScopeName* scopenamep,
 	    inPct = true;
 	    vfmt = "";
 	} else if (!inPct) {   // Normal text
-	    emitDispState.pushFormat(*pos);
+	    m_dispState.pushFormat(*pos);
 	} else { // Format character
 	    inPct = false;
 	    switch (tolower(pos[0])) {
@@ -1246,7 +1435,7 @@ void EmitCStmts::displayNode(AstNode* nodep, AstScopeName* scopenamep,
 		inPct = true;  // Get more digits
 		break;
 	    case '%':
-		emitDispState.pushFormat("%%");  // We're printf'ing it, so need to quote the %
+		m_dispState.pushFormat("%%");  // We're printf'ing it, so need to quote the %
 		break;
 	    // Special codes
 	    case '~': displayArg(nodep,&elistp,isScan, vfmt,'d'); break;  // Signed decimal
@@ -1265,10 +1454,10 @@ void EmitCStmts::displayNode(AstNode* nodep, AstScopeName* scopenamep,
 	    case 'm': {
 		if (!scopenamep) nodep->v3fatalSrc("Display with %m but no AstScopeName");
 		string suffix = scopenamep->scopePrettyName();
-		if (suffix=="") emitDispState.pushFormat("%S");
-		else emitDispState.pushFormat("%N");  // Add a . when needed
-		emitDispState.pushArg(NULL, "vlSymsp->name()");
-		emitDispState.pushFormat(suffix);
+		if (suffix=="") m_dispState.pushFormat("%S");
+		else m_dispState.pushFormat("%N");  // Add a . when needed
+		m_dispState.pushArg(NULL, "vlSymsp->name()");
+		m_dispState.pushFormat(suffix);
 		break;
 	    }
 	    case 'u':
@@ -1293,7 +1482,87 @@ void EmitCStmts::displayNode(AstNode* nodep, AstScopeName* scopenamep,
 //######################################################################
 // Internal EmitC
 
+bool EmitCImp::emitVarResetBulk(AstVar* varp) {
+    // Reset a whole unpacked array with one call, instead of a loop nest
+    // calling VL_RAND_RESET per entry.  Returns false if not applicable.
+    AstBasicDType* basicp = varp->basicp();
+    if (!basicp || basicp->isOpaque()) return false;
+    if (!varp->dtypeSkipRefp()->castUnpackArrayDType()) return false;
+    if (v3Global.opt.xInitialEdge()
+	&& (varp->isUsedClock() || 0 == varp->name().find("__Vclklast__"))) return false;
+    vluint64_t entries = 1;
+    string firstp = varp->name();
+    for (AstUnpackArrayDType* arrayp=varp->dtypeSkipRefp()->castUnpackArrayDType(); arrayp;
+	 arrayp = arrayp->subDTypep()->skipRefp()->castUnpackArrayDType()) {
+	entries *= arrayp->elementsConst();
+	firstp += "[0]";
+    }
+    bool zeroit = (varp->attrFileDescr()
+		   || basicp->isZeroInit()
+		   || (varp->name().c_str()[0]=='_' && v3Global.opt.underlineZero()));
+    ++m_statsp->m_statResetArrays;
+    if (zeroit) {
+	puts("memset("+varp->name()+", 0, sizeof("+varp->name()+"));\n");
+    } else if (varp->isWide()) {
+	puts("VL_RAND_RESET_ARRAY_W("+cvtToStr(varp->widthMin())+", &"+firstp+"[0], "
+	     +cvtToStr(entries)+");\n");
+    } else {
+	puts("VL_RAND_RESET_ARRAY("+cvtToStr(varp->widthMin())+", &"+firstp+", "
+	     +cvtToStr(entries)+");\n");
+    }
+    return true;
+}
+
+bool EmitCImp::emitVarResetRun(AstVar* varp) {
+    // Add a randomly reset scalar to the run of same width scalars, which
+    // are reset with one call so the reset mode is looked at once, like
+    // VL_RAND_RESET_ARRAY.  Returns false, with the run flushed, if not applicable.
+    AstBasicDType* basicp = varp->basicp();
+    bool simple = (basicp && !basicp->isOpaque()
+		   && !varp->dtypeSkipRefp()->castUnpackArrayDType()
+		   && !varp->isWide()
+		   && !varp->attrFileDescr()
+		   && !basicp->isZeroInit()
+		   && !(varp->name().c_str()[0]=='_' && v3Global.opt.underlineZero())
+		   && !(v3Global.opt.xInitialEdge()
+			&& (varp->isUsedClock() || 0 == varp->name().find("__Vclklast__"))));
+    if (!simple || (!m_resetRun.empty() && m_resetRun.back()->widthMin() != varp->widthMin())) {
+	emitVarResetRunFlush();
+    }
+    if (!simple) return false;
+    m_resetRun.push_back(varp);
+    return true;
+}
+
+void EmitCImp::emitVarResetRunFlush() {
+    if (m_resetRun.empty()) return;
+    AstVar* firstp = m_resetRun.front();
+    string width = cvtToStr(firstp->widthMin());
+    if (m_resetRun.size() == 1) {
+	++m_statsp->m_statResetEach;
+	puts(firstp->name()+" = VL_RAND_RESET_");
+	emitIQW(firstp);
+	puts("("+width+");\n");
+    } else {
+	++m_statsp->m_statResetRuns;
+	m_statsp->m_statResetRunVars += m_resetRun.size();
+	string ctype = (firstp->widthMin() <= 8 ? "CData"
+			: firstp->widthMin() <= 16 ? "SData"
+			: firstp->isQuad() ? "QData" : "IData");
+	puts("{ "+ctype+"* const __Vresetps[] = {");
+	for (vector<AstVar*>::iterator it = m_resetRun.begin(); it != m_resetRun.end(); ++it) {
+	    if (it != m_resetRun.begin()) puts(", ");
+	    putbs("&"+(*it)->name());
+	}
+	puts("};\n");
+	puts("VL_RAND_RESET_RUN("+width+", __Vresetps, "+cvtToStr(m_resetRun.size())+"); }\n");
+    }
+    m_resetRun.clear();
+}
+
 void EmitCImp::emitVarResets(AstNodeModule* modp) {
+    puts("\nvoid "+modClassName(modp)+"::_ctor_var_reset() {\n");
+    puts("VL_DEBUG_IF(VL_PRINTF(\"        "+modClassName(modp)+"::_ctor_var_reset\\n\"); );\n");
     puts("// Reset internal values\n");
     if (modp->isTop()) {
 	if (v3Global.opt.inhibitSim()) puts("__Vm_inhibitSim = false;\n");
@@ -1303,6 +1572,7 @@ void EmitCImp::emitVarResets(AstNodeModule* modp) {
     puts("// Reset structure values\n");
     for (AstNode* nodep=modp->stmtsp(); nodep; nodep = nodep->nextp()) {
 	if (AstVar* varp = nodep->castVar()) {
+	    if (vpiDirtyVar(varp)) puts(vpiDirtyName(varp)+" = 1;\n");
 	    if (varp->isIO() && modp->isTop() && optSystemC()) {
 		// System C top I/O doesn't need loading, as the lower level subinst code does it.
 	    }
@@ -1313,6 +1583,9 @@ void EmitCImp::emitVarResets(AstNodeModule* modp) {
 		if (!varp->hasSimpleInit()) nodep->v3fatalSrc("No init for a param?");
 		//puts("// parameter "+varp->name()+" = "+varp->valuep()->name()+"\n");
 	    }
+	    else if (varp->isSparse()) {
+		// Pages are zeroed as allocated
+	    }
 	    else if (AstInitArray* initarp = varp->valuep()->castInitArray()) {
 		AstConst* constsp = initarp->initsp()->castConst();
 		if (AstUnpackArrayDType* arrayp = varp->dtypeSkipRefp()->castUnpackArrayDType()) {
@@ -1325,7 +1598,14 @@ void EmitCImp::emitVarResets(AstNodeModule* modp) {
 		    varp->v3fatalSrc("InitArray under non-arrayed var");
 		}
 	    }
+	    else if (emitVarResetRun(varp)) {
+		// Reset with the rest of its run by emitVarResetRunFlush
+	    }
+	    else if (emitVarResetBulk(varp)) {
+		// Whole array reset in one call
+	    }
 	    else {
+		++m_statsp->m_statResetEach;
 		int vects = 0;
 		// This isn't very robust and may need cleanup for other data types
 		for (AstUnpackArrayDType* arrayp=varp->dtypeSkipRefp()->castUnpackArrayDType(); arrayp;
@@ -1376,6 +1656,22 @@ void EmitCImp::emitVarResets(AstNodeModule* modp) {
 	    }
 	}
     }
+    emitVarResetRunFlush();
+    puts("}\n");
+    splitSizeInc(10);
+}
+
+void EmitCImp::emitVpiDirtyDecl(AstNodeModule* modp) {
+    bool first = true;
+    for (AstNode* nodep=modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+	if (AstVar* varp = nodep->castVar()) {
+	    if (vpiDirtyVar(varp)) {
+		if (first) puts("// Set when written, cleared by VerilatedVpi::callValueCbs\n");
+		first = false;
+		puts("CData\t"+vpiDirtyName(varp)+";\n");
+	    }
+	}
+    }
 }
 
 void EmitCImp::emitCoverageDecl(AstNodeModule* modp) {
@@ -1401,7 +1697,7 @@ void EmitCImp::emitCtorImp(AstNodeModule* modp) {
 
     emitCellCtors(modp);
     emitSensitives();
-    emitVarResets(modp);
+    puts("_ctor_var_reset();\n");
     emitTextSection(AstType::atSCCTOR);
     if (optSystemPerl()) puts("SP_AUTO_CTOR;\n");
     puts("}\n");
@@ -1495,6 +1791,9 @@ void EmitCImp::emitSavableImp(AstNodeModule* modp) {
 		    }
 		    else if (varp->isParam()) {}
 		    else if (varp->isStatic() && varp->isConst()) {}
+		    else if (varp->isSparse()) {
+			puts("os"+op+varp->name()+";\n");
+		    }
 		    else {
 			int vects = 0;
 			// This isn't very robust and may need cleanup for other data types
@@ -1525,6 +1824,13 @@ void EmitCImp::emitSavableImp(AstNodeModule* modp) {
 		}
 	    }
 
+	    if (de) {  // Restored values are all new to VPI callbacks
+		for (AstNode* nodep=modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+		    if (AstVar* varp = nodep->castVar()) {
+			if (vpiDirtyVar(varp)) puts(vpiDirtyName(varp)+" = 1;\n");
+		    }
+		}
+	    }
 	    if (modp->isTop()) {  // Save the children
 		puts(   "__VlSymsp->"+funcname+"(os);\n");
 	    }
@@ -1614,6 +1920,7 @@ void EmitCImp::emitWrapEval(AstNodeModule* modp) {
     puts("\nvoid "+modClassName(modp)+"::eval() {\n");
     puts(EmitCBaseVisitor::symClassVar()+" = this->__VlSymsp; // Setup global symbol table\n");
     puts(EmitCBaseVisitor::symTopAssign()+"\n");
+    puts("Verilated::threadContextp(vlSymsp->__Vm_contextp);\n");
     puts("// Initialize\n");
     puts("if (VL_UNLIKELY(!vlSymsp->__Vm_didInit)) _eval_initial_loop(vlSymsp);\n");
     if (v3Global.opt.inhibitSim()) {
@@ -1635,6 +1942,7 @@ void EmitCImp::emitWrapEval(AstNodeModule* modp) {
 	     +") vl_fatal(__FILE__,__LINE__,__FILE__,\"Verilated model didn't converge\");\n");
     puts("}\n");
 #endif
+    puts("Verilated::displayEvalDone();\n");
     puts("}\n");
     splitSizeInc(10);
 
@@ -1831,6 +2139,7 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
 	}
     }
     ofp()->putAlign(V3OutFile::AL_AUTO, 8);
+    emitVpiDirtyDecl(modp);
     emitCoverageDecl(modp);	// may flip public/private
     ofp()->putAlign(V3OutFile::AL_AUTO, 8);
 
@@ -1913,6 +2222,8 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
 
     ofp()->putsPrivate(false);  // public:
     puts("void __Vconfigure("+symClassName()+"* symsp, bool first);\n");
+    ofp()->putsPrivate(true);  // private:
+    puts("void _ctor_var_reset();\n");
 
     emitIntFuncDecls(modp);
 
@@ -1983,6 +2294,7 @@ void EmitCImp::emitImp(AstNodeModule* modp) {
     if (m_slow && splitFilenum()==0) {
 	puts("\n//--------------------\n");
 	emitCtorImp(modp);
+	emitVarResets(modp);
 	emitConfigureImp(modp);
 	emitDestructorImp(modp);
 	emitSavableImp(modp);
@@ -2072,6 +2384,7 @@ void EmitCImp::main(AstNodeModule* modp, bool slow, bool fast) {
 // Tracing routines
 
 class EmitCTrace : EmitCStmts {
+    EmitCFiles*	m_filesp;	// Files written, for the netlist
     AstCFunc*	m_funcp;	// Function we're in now
     bool	m_slow;		// Making slow file
 
@@ -2082,8 +2395,7 @@ class EmitCTrace : EmitCStmts {
 	if (filenum) filename += "__"+cvtToStr(filenum);
 	filename += ".cpp";
 
-	AstCFile* cfilep = newCFile(filename, m_slow, true/*source*/);
-	cfilep->support(true);
+	m_filesp->add(filename, m_slow, true/*source*/, true/*support*/);
 
 	if (m_ofp) v3fatalSrc("Previous file not closed");
 	m_ofp = new V3OutCFile (filename);
@@ -2247,9 +2559,10 @@ class EmitCTrace : EmitCStmts {
 	    varrefp->iterate(*this);	// Put var name out
 	    // Tracing only supports 1D arrays
 	    if (varp->dtypeSkipRefp()->castUnpackArrayDType()) {
-		if (arrayindex==-2) puts("[i]");
-		else if (arrayindex==-1) puts("[0]");
-		else puts("["+cvtToStr(arrayindex)+"]");
+		string index = ((arrayindex==-2) ? "i"
+				: (arrayindex==-1) ? "0" : cvtToStr(arrayindex));
+		if (varp->isSparse()) puts(".read("+index+")");  // Don't allocate
+		else puts("["+index+"]");
 	    }
 	    if (varp->isSc()) puts(".read()");
 	    if (emitTraceIsScUint(nodep)) puts(nodep->isQuad() ? ".to_uint64()" : ".to_uint()");
@@ -2269,7 +2582,10 @@ class EmitCTrace : EmitCStmts {
 	nodep->topModulep()->accept(*this);
     }
     virtual void visit(AstNodeModule* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	// Not iterateChildren, which marks each statement being iterated;
+	// the other trace file and the modules are emitted concurrently
+	nodep->stmtsp()->iterateAndNextIgnoreEdit(*this);
+	nodep->activesp()->iterateAndNextIgnoreEdit(*this);
     }
     virtual void visit(AstCFunc* nodep, AstNUser*) {
 	if (nodep->slow() != m_slow) return;
@@ -2344,7 +2660,8 @@ class EmitCTrace : EmitCStmts {
     }
 
 public:
-    EmitCTrace(bool slow) {
+    EmitCTrace(EmitCFiles* filesp, bool slow) {
+	m_filesp = filesp;
 	m_funcp = NULL;
 	m_slow = slow;
     }
@@ -2362,26 +2679,73 @@ public:
     }
 };
 
+//######################################################################
+// Emit jobs
+
+class EmitCImpJob : public V3ThreadJob {
+    // Emit one module; its fast and slow halves touch the same nodes, so stay together
+    AstNodeModule*	m_modp;
+public:
+    EmitCFiles		m_files;	// Files written
+    EmitCStats		m_stats;	// Statistics
+    explicit EmitCImpJob(AstNodeModule* modp) : m_modp(modp) {}
+    virtual void run() {
+	if (v3Global.opt.outputSplit()) {
+	    { EmitCImp imp (&m_files, &m_stats); imp.main(m_modp, false, true); }
+	    { EmitCImp imp (&m_files, &m_stats); imp.main(m_modp, true, false); }
+	} else {
+	    { EmitCImp imp (&m_files, &m_stats); imp.main(m_modp, true, true); }
+	}
+    }
+};
+
+class EmitCTraceJob : public V3ThreadJob {
+    // Emit the slow or fast trace file
+    bool		m_slow;
+public:
+    EmitCFiles		m_files;	// Files written
+    EmitCStats		m_stats;	// Statistics, none yet
+    explicit EmitCTraceJob(bool slow) : m_slow(slow) {}
+    virtual void run() {
+	EmitCTrace imp (&m_files, m_slow);
+	imp.main();
+    }
+};
+
+template <class T_Job> static void emitcRunJobs(vector<T_Job*>& jobs, EmitCStats& stats) {
+    // Write the files, then record them in the same order as emitting serially
+    V3File::createMakeDir();  // Before jobs, as not thread safe
+    vector<V3ThreadJob*> basejobs (jobs.begin(), jobs.end());
+    V3ThreadPool::runJobs(basejobs);
+    for (typename vector<T_Job*>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+	(*it)->m_files.addToNetlist();
+	stats.add((*it)->m_stats);
+	delete *it; *it=NULL;
+    }
+}
+
 //######################################################################
 // EmitC class functions
 
 void V3EmitC::emitc() {
     UINFO(2,__FUNCTION__<<": "<<endl);
-    // Process each module in turn
+    // Process each module, in parallel under --build-jobs
+    vector<EmitCImpJob*> jobs;
     for (AstNodeModule* nodep = v3Global.rootp()->modulesp(); nodep; nodep=nodep->nextp()->castNodeModule()) {
-	if (v3Global.opt.outputSplit()) {
-	    { EmitCImp imp; imp.main(nodep, false, true); }
-	    { EmitCImp imp; imp.main(nodep, true, false); }
-	} else {
-	    { EmitCImp imp; imp.main(nodep, true, true); }
-	}
+	jobs.push_back(new EmitCImpJob(nodep));
     }
+    EmitCStats stats;
+    emitcRunJobs(jobs, stats);
+    stats.addToStats();
 }
 
 void V3EmitC::emitcTrace() {
     UINFO(2,__FUNCTION__<<": "<<endl);
     if (v3Global.opt.trace()) {
-	{ EmitCTrace imp (true);  imp.main(); }
-	{ EmitCTrace imp (false); imp.main(); }
+	vector<EmitCTraceJob*> jobs;
+	jobs.push_back(new EmitCTraceJob(true));
+	jobs.push_back(new EmitCTraceJob(false));
+	EmitCStats stats;
+	emitcRunJobs(jobs, stats);
     }
 }
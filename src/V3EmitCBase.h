@@ -59,6 +59,11 @@ public:
     static string topClassName() {		// Return name of top wrapper module
 	return v3Global.opt.prefix();
     }
+    static bool vpiDirtyVar(AstVar* varp) {	// Has a VPI value change mark, see VerilatedVar::dirtyp
+	// Primary inputs are written by the application, not the model, so have none
+	return (varp->isSigUserRdPublic() && !varp->isParam() && !varp->isPrimaryIn());
+    }
+    static string vpiDirtyName(AstVar* varp) { return "__Vvpidirty__"+varp->name(); }
     AstCFile* newCFile(const string& filename, bool slow, bool source) {
 	AstCFile* cfilep = new AstCFile(v3Global.rootp()->fileline(), filename);
 	cfilep->slow(slow);
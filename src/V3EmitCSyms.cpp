@@ -303,6 +303,7 @@ void EmitCSyms::emitSymHdr() {
     puts("\n// LOCAL STATE\n");
     ofp()->putAlign(V3OutFile::AL_AUTO, sizeof(vluint64_t));
     puts("const char* __Vm_namep;\n");	// Must be before subcells, as constructor order needed before _vlCoverInsert.
+    puts("VerilatedContext* __Vm_contextp;\t///< Simulation context the model is bound to\n");  // Likewise, before subcells construct
     ofp()->putAlign(V3OutFile::AL_AUTO, sizeof(bool));
     puts("bool\t__Vm_activity;\t\t///< Used by trace routines to determine change occurred\n");
     ofp()->putAlign(V3OutFile::AL_AUTO, sizeof(bool));
@@ -373,6 +374,7 @@ void EmitCSyms::emitSymImp() {
     puts(symClassName()+"::"+symClassName()+"("+topClassName()+"* topp, const char* namep)\n");
     puts("\t// Setup locals\n");
     puts("\t: __Vm_namep(namep)\n");	// No leak, as we get destroyed when the top is destroyed
+    puts("\t, __Vm_contextp(Verilated::threadContextp())\n");
     puts("\t, __Vm_activity(false)\n");
     puts("\t, __Vm_didInit(false)\n");
     puts("\t// Setup submodule names\n");
@@ -491,6 +493,20 @@ void EmitCSyms::emitSymImp() {
 	    }
 	    puts(varp->name());
 	    puts("), ");
+	    if (vpiDirtyVar(varp)) {
+		puts("&(");
+		if (modp->isTop()) {
+		    puts(scopep->nameDotless());
+		    puts("p->");
+		} else {
+		    puts(scopep->nameDotless());
+		    puts(".");
+		}
+		puts(vpiDirtyName(varp));
+		puts("), ");
+	    } else {
+		puts("NULL, ");
+	    }
 	    puts(varp->vlEnumType());  // VLVT_UINT32 etc
 	    puts(",");
 	    puts(varp->vlEnumDir());  // VLVD_IN etc
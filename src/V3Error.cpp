@@ -22,6 +22,7 @@
 #include <cstdarg>
 #include <cstring>
 #include <set>
+#include <pthread.h>
 #include "V3Error.h"
 #ifndef _V3ERROR_NO_GLOBAL_
 # include "V3Ast.h"
@@ -51,6 +52,40 @@ struct v3errorIniter {
 };
 v3errorIniter v3errorInit;
 
+//######################################################################
+// Thread state
+
+class V3ErrorThreadState {
+    // Lock held while a message is formed, and each thread's V3ThreadPool job messages
+public:
+    pthread_mutex_t	m_mutex;
+    pthread_key_t	m_msgsKey;	// V3ErrorJobMsgs* to hold this thread's messages in
+private:
+    V3ErrorThreadState() {
+	pthread_mutexattr_t attr;
+	pthread_mutexattr_init(&attr);
+	// Recursive, as reporting one error may report another (--error-limit)
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&m_mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+	pthread_key_create(&m_msgsKey, NULL);
+    }
+public:
+    static V3ErrorThreadState& singleton() {
+	static V3ErrorThreadState s;
+	return s;
+    }
+    V3ErrorJobMsgs* msgsp() {
+	return static_cast<V3ErrorJobMsgs*>(pthread_getspecific(m_msgsKey));
+    }
+};
+
+class V3ErrorUnlocker {
+    // Release the lock v3errorPrep took, on every path out of v3errorEnd
+public:
+    ~V3ErrorUnlocker() { V3Error::unlock(); }
+};
+
 //######################################################################
 // ErrorCode class functions
 
@@ -420,6 +455,30 @@ void V3Error::vlAbort () {
 //======================================================================
 // Global Functions
 
+void V3Error::lock() {
+    pthread_mutex_lock(&V3ErrorThreadState::singleton().m_mutex);
+}
+
+void V3Error::unlock() {
+    pthread_mutex_unlock(&V3ErrorThreadState::singleton().m_mutex);
+}
+
+void V3Error::jobMsgsp(V3ErrorJobMsgs* msgsp) {
+    pthread_setspecific(V3ErrorThreadState::singleton().m_msgsKey, msgsp);
+}
+
+void V3Error::jobReplay(const V3ErrorJobMsgs& msgs) {
+    // Duplicates, first-use hints and counts are handled here rather than
+    // in the job, so they come out the same whichever job ran first
+    lock();
+    V3ErrorUnlocker unlocker;
+    for (V3ErrorJobMsgs::const_iterator it = msgs.begin(); it != msgs.end(); ++it) {
+	s_errorCode = it->m_code;
+	s_errorSuppressed = it->m_suppressed;
+	v3errorReport(it->m_msg, it->m_text);
+    }
+}
+
 void V3Error::suppressThisWarning() {
     if (s_errorCode>=V3ErrorCode::EC_MIN) {
 	V3Stats::addStatSum(string("Warnings, Suppressed ")+s_errorCode.ascii(), 1);
@@ -432,6 +491,7 @@ string V3Error::warnMore() {
 }
 
 void V3Error::v3errorEnd (ostringstream& sstr) {
+    V3ErrorUnlocker unlocker;
 #if defined(__COVERITY__) || defined(__cppcheck__)
     if (s_errorCode==V3ErrorCode::EC_FATAL) __coverity_panic__(x);
 #endif
@@ -441,6 +501,24 @@ void V3Error::v3errorEnd (ostringstream& sstr) {
 	&& (!debug() || s_errorCode.defaultsOff())) return;
     string msg = msgPrefix()+sstr.str();
     if (msg[msg.length()-1] != '\n') msg += '\n';
+    if (V3ErrorJobMsgs* jobMsgsp = V3ErrorThreadState::singleton().msgsp()) {
+	if (s_errorCode!=V3ErrorCode::EC_FATAL
+	    && s_errorCode!=V3ErrorCode::EC_FATALSRC) {
+	    jobMsgsp->push_back(V3ErrorJobMsg(s_errorCode, s_errorSuppressed, msg, sstr.str()));
+	    return;
+	}
+	// Not returning to the pool, so report what this job held first
+	V3ErrorCode code = s_errorCode;
+	bool suppressed = s_errorSuppressed;
+	V3Error::jobMsgsp(NULL);
+	jobReplay(*jobMsgsp);
+	s_errorCode = code;
+	s_errorSuppressed = suppressed;
+    }
+    v3errorReport(msg, sstr.str());
+}
+
+void V3Error::v3errorReport(const string& msg, const string& text) {
     // Suppress duplicates
     if (s_messages.find(msg) != s_messages.end()) return;
     s_messages.insert(msg);
@@ -464,7 +542,7 @@ void V3Error::v3errorEnd (ostringstream& sstr) {
 	// Not later warnings, as a internal may be caused by an earlier problem
 	if (s_tellManual == 0) {
 	    if (s_errorCode.mentionManual()
-		|| sstr.str().find("Unsupported") != string::npos) {
+		|| text.find("Unsupported") != string::npos) {
 		s_tellManual = 1;
 	    } else {
 		s_tellManual = 2;
@@ -29,6 +29,7 @@
 #include <map>
 #include <set>
 #include <deque>
+#include <vector>
 
 #include "V3LangCode.h"
 
@@ -178,6 +179,20 @@ public:
 
 //######################################################################
 
+class V3ErrorJobMsg {
+    // A message reported inside a V3ThreadPool job, held until the job is replayed
+public:
+    V3ErrorCode	m_code;		// Code it was reported with
+    bool	m_suppressed;	// Suppressed warning
+    string	m_msg;		// Message, with prefix
+    string	m_text;		// Text as given by the reporter
+    V3ErrorJobMsg(V3ErrorCode code, bool suppressed, const string& msg, const string& text)
+	: m_code(code), m_suppressed(suppressed), m_msg(msg), m_text(text) {}
+};
+typedef vector<V3ErrorJobMsg> V3ErrorJobMsgs;
+
+//######################################################################
+
 class V3Error {
     // Base class for any object that wants debugging and error reporting
 
@@ -229,11 +244,21 @@ class V3Error {
 
     // Internals for v3error()/v3fatal() macros only
     // Error end takes the string stream to output, be careful to seek() as needed
+    // Prep takes a lock that the final V3Error::v3errorEnd releases, so
+    // messages from V3ThreadPool jobs are formed one at a time
     static void v3errorPrep(V3ErrorCode code) {
-	s_errorStr.str(""); s_errorCode=code; s_errorSuppressed=false; }
+	lock(); s_errorStr.str(""); s_errorCode=code; s_errorSuppressed=false; }
     static ostringstream& v3errorStr() { return s_errorStr; }
     static void	vlAbort();
     static void	v3errorEnd(ostringstream& sstr);	// static, but often overridden in classes.
+
+    // Internals for V3ThreadPool only
+    static void	lock();
+    static void	unlock();
+    static void	jobMsgsp(V3ErrorJobMsgs* msgsp);	// Hold this thread's messages, NULL=report now
+    static void	jobReplay(const V3ErrorJobMsgs& msgs);	// Report messages a job held
+  private:
+    static void	v3errorReport(const string& msg, const string& text);
 };
 
 // Global versions, so that if the class doesn't define a operator, we get the functions anyways.
@@ -35,10 +35,12 @@
 #include <cstdarg>
 #include <unistd.h>
 #include <algorithm>
+#include <vector>
 
 #include "V3Global.h"
 #include "V3Expand.h"
 #include "V3Ast.h"
+#include "V3ThreadPool.h"
 
 //######################################################################
 // Expand state, as a visitor of each AstNode
@@ -47,7 +49,7 @@ class ExpandVisitor : public AstNVisitor {
 private:
     // NODE STATE
     //  AstNode::user1()	-> bool.  Processed
-    AstUser1InUse	m_inuser1;
+    // The AstUser1InUse is in V3Expand::expandAll, shared by every module's job
 
     // STATE
     AstNode*		m_stmtp;	// Current statement
@@ -920,7 +922,7 @@ private:
 
 public:
     // CONSTUCTORS
-    ExpandVisitor(AstNetlist* nodep) {
+    ExpandVisitor(AstNodeModule* nodep) {
 	m_stmtp=NULL;
 	nodep->accept(*this);
     }
@@ -930,10 +932,29 @@ public:
 //----------------------------------------------------------------------
 // Top loop
 
+class ExpandJob : public V3ThreadJob {
+    // Expand one module; each statement is rewritten in place
+    AstNodeModule*	m_modp;
+public:
+    explicit ExpandJob(AstNodeModule* modp) : m_modp(modp) {}
+    virtual void run() {
+	ExpandVisitor visitor (m_modp);
+    }
+};
+
 //######################################################################
 // Expand class functions
 
 void V3Expand::expandAll(AstNetlist* nodep) {
     UINFO(2,__FUNCTION__<<": "<<endl);
-    ExpandVisitor visitor (nodep);
+    AstUser1InUse	inuser1;  // For all jobs; a job may not allocate user()s
+    // Process each module, in parallel under --build-jobs
+    vector<V3ThreadJob*> jobs;
+    for (AstNodeModule* modp = nodep->modulesp(); modp; modp=modp->nextp()->castNodeModule()) {
+	jobs.push_back(new ExpandJob(modp));
+    }
+    V3ThreadPool::runJobs(jobs);
+    for (vector<V3ThreadJob*>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+	delete *it; *it=NULL;
+    }
 }
@@ -29,24 +29,31 @@
 #include <iomanip>
 #include <memory>
 #include <map>
+#include <iterator>
 
 #if defined(__unix__)
 # define INFILTER_PIPE  // Allow pipe filtering.  Needs fork()
+# define INFILTER_MMAP  // Map large input files.  Needs mmap()
 #endif
 
 #ifdef INFILTER_PIPE
 # include <sys/wait.h>
 #endif
+#ifdef INFILTER_MMAP
+# include <sys/mman.h>
+#endif
 
 #include "V3Global.h"
 #include "V3File.h"
 #include "V3PreShell.h"
 #include "V3Ast.h"
+#include "V3ThreadPool.h"
 
 // If change this code, run a test with the below size set very small
 //#define INFILTER_IPC_BUFSIZ 16
 #define INFILTER_IPC_BUFSIZ 64*1024  // For debug, try this as a small number
 #define INFILTER_CACHE_MAX  64*1024  // Maximum bytes to cache if same file read twice
+#define INFILTER_MMAP_MIN   64*1024  // Minimum bytes to map rather than read a file
 
 //######################################################################
 // V3File Internal state
@@ -84,6 +91,7 @@ class V3FileDependImp {
     // MEMBERS
     set<string>		m_filenameSet;		// Files generated (elim duplicates)
     set<DependFile>	m_filenameList;		// Files sourced/generated
+    V3Mutex		m_mutex;		// Protects above, as V3ThreadJobs write files
 
     static string stripQuotes(const string& in) {
 	string pretty = in;
@@ -95,6 +103,7 @@ class V3FileDependImp {
 public:
     // ACCESSOR METHODS
     void addSrcDepend(const string& filename) {
+	V3LockGuard lock (m_mutex);
 	if (m_filenameSet.find(filename) == m_filenameSet.end()) {
 	    m_filenameSet.insert(filename);
 	    DependFile df (filename, false);
@@ -103,6 +112,7 @@ public:
 	}
     }
     void addTgtDepend(const string& filename) {
+	V3LockGuard lock (m_mutex);
 	if (m_filenameSet.find(filename) == m_filenameSet.end()) {
 	    m_filenameSet.insert(filename);
 	    m_filenameList.insert(DependFile (filename, true));
@@ -115,6 +125,107 @@ public:
 
 V3FileDependImp  dependImp;	// Depend implementation class
 
+//######################################################################
+// V3File Incremental output
+
+class V3FileIncrImp {
+    // Size, time and hash of each file written, so the next --incremental
+    // run can leave unchanged files alone, and make won't rebuild them
+    struct Entry {
+	off_t		m_size;
+	time_t		m_mtime;
+	vluint64_t	m_hash;
+	Entry() : m_size(0), m_mtime(0), m_hash(0) {}
+    };
+    typedef map<string,Entry> EntryMap;
+
+    // MEMBERS
+    EntryMap	m_entries;	// Files written, by filename
+    bool	m_loaded;	// m_entries read from last run
+    int		m_reused;	// Files left unchanged this run
+    V3Mutex	m_mutex;	// Protects above, as V3ThreadJobs write files
+
+    static bool sameAsFile(const string& filename, const string& text) {
+	// No entry from the last run, so compare the text itself
+	ifstream is (filename.c_str(), ios::binary);
+	if (is.fail()) return false;
+	string old ((istreambuf_iterator<char>(is)), istreambuf_iterator<char>());
+	return old == text;
+    }
+    void load() {
+	m_loaded = true;
+	string filename = v3Global.opt.makeDir()+"/"+v3Global.opt.prefix()+"__verHash.dat";
+	ifstream is (filename.c_str());
+	if (is.fail()) return;
+	string line;
+	getline(is, line);  // Header
+	while (getline(is, line)) {
+	    istringstream ls (line);
+	    Entry ent;
+	    char quote;
+	    string entFilename;
+	    ls>>ent.m_size>>ent.m_mtime>>hex>>ent.m_hash>>dec>>quote;
+	    getline(ls, entFilename, '"');
+	    if (ls.fail() || quote!='"') continue;
+	    m_entries[entFilename] = ent;
+	}
+    }
+public:
+    // METHODS
+    void writeIfChanged(const string& filename, const string& text) {
+	vluint64_t hash = V3File::hashText(text);
+	struct stat st;
+	bool exists = (stat(filename.c_str(), &st) == 0
+		       && st.st_size == (off_t)text.length());
+	{
+	    V3LockGuard lock (m_mutex);
+	    if (!m_loaded) load();
+	    EntryMap::iterator it = m_entries.find(filename);
+	    if (exists && it != m_entries.end()
+		&& it->second.m_hash == hash
+		&& it->second.m_size == st.st_size
+		&& it->second.m_mtime == st.st_mtime) {
+		UINFO(4,"  Unchanged "<<filename<<endl);
+		++m_reused;
+		return;
+	    }
+	}
+	bool same = exists && sameAsFile(filename, text);
+	if (same) {
+	    UINFO(4,"  Unchanged "<<filename<<endl);
+	} else {
+	    FILE* fp = fopen(filename.c_str(), "w");
+	    if (!fp || fwrite(text.data(), 1, text.length(), fp) != text.length()) {
+		v3fatal("Cannot write "<<filename);
+	    }
+	    fclose(fp);
+	    stat(filename.c_str(), &st);
+	}
+	V3LockGuard lock (m_mutex);
+	if (same) ++m_reused;
+	Entry& ent = m_entries[filename];
+	ent.m_size = st.st_size;
+	ent.m_mtime = st.st_mtime;
+	ent.m_hash = hash;
+    }
+    void writeHashes(const string& filename) {
+	if (!m_loaded) load();  // Keep entries for files not written this run
+	const auto_ptr<ofstream> ofp (V3File::new_ofstream_nodepend(filename));
+	if (ofp->fail()) v3fatalSrc("Can't write "<<filename);
+	*ofp<<"# DESCR"<<"IPTION: Verilator output: Output hashes for --incremental.  Delete at will."<<endl;
+	for (EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+	    *ofp<<setw(8)<<it->second.m_size;
+	    *ofp<<" "<<setw(11)<<it->second.m_mtime;
+	    *ofp<<" "<<hex<<setw(16)<<setfill('0')<<it->second.m_hash<<dec<<setfill(' ');
+	    *ofp<<" \""<<it->first<<"\""<<endl;
+	}
+    }
+    int reused() const { return m_reused; }
+    V3FileIncrImp() : m_loaded(false), m_reused(0) {}
+};
+
+V3FileIncrImp  incrImp;		// Incremental output implementation class
+
 //######################################################################
 // V3FileDependImp
 
@@ -253,6 +364,26 @@ bool V3File::checkTimes(const string& filename, const string& cmdline) {
     return dependImp.checkTimes(filename, cmdline);
 }
 
+void V3File::writeIfChanged(const string& filename, const string& text) {
+    incrImp.writeIfChanged(filename, text);
+}
+void V3File::writeHashes(const string& filename) {
+    incrImp.writeHashes(filename);
+}
+int V3File::outputsReused() {
+    return incrImp.reused();
+}
+
+vluint64_t V3File::hashText(const char* datap, size_t size) {
+    // FNV-1a
+    vluint64_t hash = VL_ULL(0xcbf29ce484222325);
+    for (const char* cp = datap; cp < datap+size; ++cp) {
+	hash ^= (unsigned char)(*cp);
+	hash *= VL_ULL(0x100000001b3);
+    }
+    return hash;
+}
+
 void V3File::createMakeDir() {
     static bool created = false;
     if (!created) {
@@ -501,6 +632,30 @@ protected:
 	}
 	return true;
     }
+    V3InFileMap* mapWholefile(const string& filename) {
+#ifdef INFILTER_MMAP
+	if (m_pid) return NULL;  // Contents come from the filter
+	int fd = open (filename.c_str(), O_RDONLY);
+	if (fd<0) return NULL;
+	V3InFileMap* mapp = NULL;
+	struct stat st;
+	if (fstat(fd, &st)==0 && S_ISREG(st.st_mode) && st.st_size >= INFILTER_MMAP_MIN) {
+	    void* datap = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	    if (datap != MAP_FAILED) {
+# ifdef MADV_SEQUENTIAL
+		madvise(datap, st.st_size, MADV_SEQUENTIAL);
+# endif
+		UINFO(4,"Mapped "<<filename<<" "<<st.st_size<<" bytes"<<endl);
+		mapp = new V3InFileMap((const char*)datap, st.st_size);
+	    }
+	}
+	close(fd);
+	return mapp;
+#else
+	if (filename=="") {}  // Prevent unused
+	return NULL;
+#endif
+    }
     size_t listSize(StrList& sl) {
 	size_t out = 0;
 	for (StrList::iterator it=sl.begin(); it!=sl.end(); ++it) {
@@ -539,6 +694,16 @@ bool V3InFilter::readWholefile(const string& filename, V3InFilter::StrList& outl
     if (!m_impp) v3fatalSrc("readWholefile on invalid filter");
     return m_impp->readWholefile(filename, outl);
 }
+V3InFileMap* V3InFilter::mapWholefile(const string& filename) {
+    if (!m_impp) v3fatalSrc("mapWholefile on invalid filter");
+    return m_impp->mapWholefile(filename);
+}
+
+V3InFileMap::~V3InFileMap() {
+#ifdef INFILTER_MMAP
+    munmap((void*)m_datap, m_size);
+#endif
+}
 
 //######################################################################
 // V3OutFormatter: A class for printing to a file, with automatic indentation of C++ code.
@@ -554,8 +719,7 @@ V3OutFormatter::V3OutFormatter(const string& filename, V3OutFormatter::Language
 
 const char* V3OutFormatter::indentStr(int num) {
     // Indent the specified number of spaces.  Use tabs as possible.
-    static char str[MAXSPACE+20];
-    char* cp = str;
+    char* cp = m_indentStr;
     if (num>MAXSPACE) num=MAXSPACE;
     if (!m_lang==LA_VERILOG) {  // verilogPrefixedTree doesn't want tabs
 	while (num>=8) {
@@ -568,12 +732,12 @@ const char* V3OutFormatter::indentStr(int num) {
 	num --;
     }
     *cp++ = '\0';
-    return (str);
+    return (m_indentStr);
 }
 
 const string V3OutFormatter::indentSpaces(int num) {
     // Indent the specified number of spaces.  Use spaces.
-    static char str[MAXSPACE+20];
+    char str[MAXSPACE+20];
     char* cp = str;
     if (num>MAXSPACE) num=MAXSPACE;
     while (num>0) {
@@ -743,7 +907,7 @@ void V3OutFormatter::putBreak () {
     }
 }
 
-void V3OutFormatter::putsQuoted(const char* strg) {
+void V3OutFormatter::putsQuoted(const string& strg) {
     // Quote \ and " for use inside C programs
     // Don't use to quote a filename for #include - #include doesn't \ escape.
     putcNoTracking('"');
@@ -819,12 +983,20 @@ void V3OutFormatter::printf (const char *fmt...) {
 
 V3OutFile::V3OutFile(const string& filename, V3OutFormatter::Language lang)
     : V3OutFormatter(filename, lang) {
-    if ((m_fp = V3File::new_fopen_w(filename.c_str())) == NULL) {
+    if (v3Global.opt.incremental() && filename != "/dev/null") {
+	// Written when closed, only if different from the last run
+	m_fp = NULL;
+	m_filename = filename;
+	V3File::createMakeDir();
+	V3File::addTgtDepend(filename);
+    }
+    else if ((m_fp = V3File::new_fopen_w(filename.c_str())) == NULL) {
 	v3fatal("Cannot write "<<filename);
     }
 }
 
 V3OutFile::~V3OutFile() {
     if (m_fp) fclose(m_fp);
+    else V3File::writeIfChanged(m_filename, m_text);
     m_fp = NULL;
 }
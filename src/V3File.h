@@ -66,10 +66,35 @@ public:
     static void writeTimes(const string& filename, const string& cmdline);
     static bool checkTimes(const string& filename, const string& cmdline);
 
+    // Incremental output (--incremental)
+    static void writeIfChanged(const string& filename, const string& text);
+    static void writeHashes(const string& filename);
+    static int outputsReused();
+
+    // Hash of file contents (--incremental, --parse-cache)
+    static vluint64_t hashText(const char* datap, size_t size);
+    static vluint64_t hashText(const string& text) { return hashText(text.data(), text.length()); }
+
     // Directory utilities
     static void createMakeDir();
 };
 
+//============================================================================
+// V3InFileMap: Read-only memory mapping of a whole input file
+
+class V3InFileMap {
+    const char*	m_datap;	// Mapped contents
+    size_t	m_size;		// Bytes at m_datap
+public:
+    // ACCESSORS
+    const char* data() const { return m_datap; }
+    size_t size() const { return m_size; }
+
+    // CONSTRUCTORS
+    V3InFileMap(const char* datap, size_t size) : m_datap(datap), m_size(size) {}
+    ~V3InFileMap();
+};
+
 //============================================================================
 // V3InFilter: Read a input file, possibly filtering it, and caching contents
 
@@ -84,6 +109,9 @@ public:
     // METHODS
     // Read file contents and return it.  Return true on success.
     bool readWholefile(const string& filename, StrList& outl);
+    // Map a large unfiltered file instead of reading it.  Return NULL if
+    // not mapped, in which case use readWholefile.  Caller deletes.
+    V3InFileMap* mapWholefile(const string& filename);
 
     // CONSTRUCTORS
     V3InFilter(const string& command);
@@ -123,6 +151,7 @@ private:
     int		m_declNSAlign;	// Byte alignment of next declaration, nonstatics
     int		m_declPadNum;	// Pad variable number
     stack<int>	m_parenVec;	// Stack of columns where last ( was
+    char	m_indentStr[MAXSPACE+20];	// Result of indentStr
 
     int		endLevels(const char* strg);
     const char* indentStr(int levels);
@@ -139,8 +168,7 @@ public:
     void puts(const string& strg) { puts(strg.c_str()); }
     void putsNoTracking(const char* strg);
     void putsNoTracking(const string& strg) { putsNoTracking(strg.c_str()); }
-    void putsQuoted(const char* strg);
-    void putsQuoted(const string& strg) { putsQuoted(strg.c_str()); }
+    void putsQuoted(const string& strg);
     void putBreak();  // Print linebreak if line is too wide
     void putBreakExpr();  // Print linebreak in expression if line is too wide
     void putAlign(bool isstatic/*AlignClass*/, int align, int size=0/*=align*/, const char* prefix=""); // Declare a variable, with natural alignment
@@ -169,12 +197,17 @@ public:
 class V3OutFile : public V3OutFormatter {
     // MEMBERS
     FILE*	m_fp;
+    string	m_filename;	// Filename, if buffering for --incremental
+    string	m_text;		// Text, if buffering for --incremental
 public:
     V3OutFile(const string& filename, V3OutFormatter::Language lang);
     virtual ~V3OutFile();
 private:
     // CALLBACKS
-    virtual void putcOutput(char chr) { fputc(chr, m_fp); }
+    virtual void putcOutput(char chr) {
+	if (VL_LIKELY(m_fp)) fputc(chr, m_fp);
+	else m_text += chr;
+    }
 };
 
 //######################################################################
@@ -167,7 +167,8 @@ public:
 //######################################################################
 // Is this a simple math expression with a single input and single output?
 
-class GateOkVisitor : public GateBaseVisitor {
+class GateOkVisitor : public AstNVisitorStatic<GateOkVisitor, GateBaseVisitor> {
+    friend class AstNVisitorStatic<GateOkVisitor, GateBaseVisitor>;
 private:
     // RETURN STATE
     bool		m_isSimple;	// Set false when we know it isn't simple
@@ -187,7 +188,7 @@ private:
     }
     // VISITORS
     virtual void visit(AstNodeVarRef* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	// We only allow a LHS ref for the var being set, and a RHS ref for something else being read.
 	if (nodep->varScopep()->varp()->isSc()) {
 	    clearSimple("SystemC sig");  // Don't want to eliminate the VL_ASSIGN_SI's
@@ -216,7 +217,7 @@ private:
 	m_substTreep = nodep->rhsp();
 	if (!nodep->lhsp()->castNodeVarRef())
 	    clearSimple("ASSIGN(non-VARREF)");
-	else nodep->iterateChildren(*this);
+	else iterateChildren(nodep);
 	// We don't push logic other then assignments/NOTs into SenItems
 	// This avoids a mess in computing what exactly a POSEDGE is
 	// V3Const cleans up any NOTs by flipping the edges for us
@@ -242,7 +243,7 @@ private:
 	    UINFO(5, "Non optimizable type: "<<nodep<<endl);
 	    clearSimple("Non optimizable type");
 	}
-	else nodep->iterateChildren(*this);
+	else iterateChildren(nodep);
     }
 public:
     // CONSTUCTORS
@@ -253,7 +254,7 @@ public:
 	m_lhsVarRef = NULL;
 	m_dedupe = dedupe;
 	// Iterate
-	nodep->accept(*this);
+	accept(nodep);
 	// Check results
 	if (!m_substTreep) {
 	    clearSimple("No assignment found\n");
@@ -280,7 +281,8 @@ public:
 //######################################################################
 // Gate class functions
 
-class GateVisitor : public GateBaseVisitor {
+class GateVisitor : public AstNVisitorStatic<GateVisitor, GateBaseVisitor> {
+    friend class AstNVisitorStatic<GateVisitor, GateBaseVisitor>;
 private:
     // NODE STATE
     //Entire netlist:
@@ -317,7 +319,7 @@ private:
 	    }
 	    if (consumeReason) m_logicVertexp->setConsumed(consumeReason);
 	    if (nodep->castSenItem()) m_logicVertexp->setConsumed("senItem");
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	    m_logicVertexp = NULL;
 	}
     }
@@ -355,7 +357,7 @@ private:
 
     // VISITORS
     virtual void visit(AstNetlist* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	//if (debug()>6) m_graph.dump();
 	if (debug()>6) m_graph.dumpDotFilePrefixed("gate_pre");
 	m_graph.removeRedundantEdgesSum(&V3GraphEdge::followAlwaysTrue);
@@ -379,14 +381,14 @@ private:
     virtual void visit(AstNodeModule* nodep, AstNUser*) {
 	m_modp = nodep;
 	m_activeReducible = true;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_modp = NULL;
     }
     virtual void visit(AstScope* nodep, AstNUser*) {
 	UINFO(4," SCOPE "<<nodep<<endl);
 	m_scopep = nodep;
 	m_logicVertexp = NULL;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_scopep = NULL;
     }
     virtual void visit(AstActive* nodep, AstNUser*) {
@@ -395,7 +397,7 @@ private:
 	m_activeReducible = !(nodep->hasClocked());  // Seq logic outputs aren't reducible
 	m_activep = nodep;
 	AstNode::user2ClearTree();
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	AstNode::user2ClearTree();
 	m_activep = NULL;
 	m_activeReducible = true;
@@ -443,7 +445,7 @@ private:
 	// The gating term of a AstSenGate is normal logic
 	m_inSenItem = true;
 	if (m_logicVertexp) {  // Already under logic; presumably a SenGate
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	} else {  // Standalone item, probably right under a SenTree
 	    iterateNewStmt(nodep, NULL, NULL);
 	}
@@ -479,13 +481,13 @@ private:
 	if (nodep->backp()->castNodeAssign() && nodep->backp()->castNodeAssign()->lhsp()==nodep) {
 	    nodep->v3fatalSrc("Concat on LHS of assignment; V3Const should have deleted it\n");
 	}
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 
     //--------------------
     // Default
     virtual void visit(AstNode* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (nodep->isOutputter() && m_logicVertexp) m_logicVertexp->setConsumed("outputter");
     }
 
@@ -500,7 +502,7 @@ public:
 	m_activeReducible = true;
 	m_inSenItem = false;
 	m_inSlow = false;
-	nodep->accept(*this);
+	accept(nodep);
     }
     virtual ~GateVisitor() {
 	V3Stats::addStat("Optimizations, Gate sigs deleted", m_statSigs);
@@ -744,7 +746,8 @@ void GateVisitor::warnSignals() {
 //######################################################################
 // Push constant into expressions and reevaluate
 
-class GateElimVisitor : public GateBaseVisitor {
+class GateElimVisitor : public AstNVisitorStatic<GateElimVisitor, GateBaseVisitor> {
+    friend class AstNVisitorStatic<GateElimVisitor, GateBaseVisitor>;
 private:
     // NODE STATE
     // STATE
@@ -779,7 +782,7 @@ private:
 	}
     }
     virtual void visit(AstNode* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 public:
     // CONSTUCTORS
@@ -788,7 +791,7 @@ public:
 	m_didReplace = false;
 	m_elimVarScp = varscp;
 	m_replaceTreep = replaceTreep;
-	nodep->accept(*this);
+	accept(nodep);
     }
     bool didReplace() const { return m_didReplace; }
 };
@@ -866,7 +869,8 @@ public:
 //######################################################################
 // Have we seen the rhs of this assign before?
 
-class GateDedupeVarVisitor : public GateBaseVisitor {
+class GateDedupeVarVisitor : public AstNVisitorStatic<GateDedupeVarVisitor, GateBaseVisitor> {
+    friend class AstNVisitorStatic<GateDedupeVarVisitor, GateBaseVisitor>;
     // Given a node, it is visited to try to find the AstNodeAssign under it that can used for dedupe.
     // Right now, only the following node trees are supported for dedupe.
     // 1. AstNodeAssign
@@ -899,7 +903,7 @@ private:
 	if (m_dedupable) {
 	    if (!m_always) {
 		m_always = true;
-		alwaysp->bodysp()->iterateAndNext(*this);
+		iterateAndNext(alwaysp->bodysp());
 	    } else {
 		m_dedupable = false;
 	    }
@@ -913,7 +917,7 @@ private:
 	if (m_dedupable) {
 	    if (m_always && !m_ifCondp && !ifp->elsesp()) {  //we're under an always, this is the first IF,  and there's no else
 		m_ifCondp = ifp->condp();
-		ifp->ifsp()->iterateAndNext(*this);
+		iterateAndNext(ifp->ifsp());
 	    } else {
 		m_dedupable = false;
 	    }
@@ -936,7 +940,7 @@ public:
 	m_ifCondp = NULL;
 	m_always = false;
 	m_dedupable = true;
-	nodep->accept(*this);
+	accept(nodep);
 	if (m_dedupable && m_assignp) {
 	    AstNode* lhsp = m_assignp->lhsp();
 	    // Possible todo, handle more complex lhs expressions
@@ -1060,7 +1064,8 @@ void GateVisitor::dedupe() {
 //######################################################################
 // Convert VARSCOPE(ASSIGN(default, VARREF)) to just VARSCOPE(default)
 
-class GateDeassignVisitor : public GateBaseVisitor {
+class GateDeassignVisitor : public AstNVisitorStatic<GateDeassignVisitor, GateBaseVisitor> {
+    friend class AstNVisitorStatic<GateDeassignVisitor, GateBaseVisitor>;
 private:
     // VISITORS
     virtual void visit(AstVarScope* nodep, AstNUser*) {
@@ -1076,13 +1081,13 @@ private:
     virtual void visit(AstVar* nodep, AstNUser*) {}
     virtual void visit(AstActive* nodep, AstNUser*) {}
     virtual void visit(AstNode* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 
 public:
     // CONSTUCTORS
     GateDeassignVisitor(AstNode* nodep) {
-	nodep->accept(*this);
+	accept(nodep);
     }
     virtual ~GateDeassignVisitor() {}
 };
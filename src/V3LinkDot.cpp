@@ -513,7 +513,8 @@ LinkDotState* LinkDotState::s_errorThisp = NULL;
 
 //======================================================================
 
-class LinkDotFindVisitor : public AstNVisitor {
+class LinkDotFindVisitor : public AstNVisitorStatic<LinkDotFindVisitor> {
+    friend class AstNVisitorStatic<LinkDotFindVisitor>;
     // STATE
     LinkDotState*	m_statep;	// State to pass between visitors, including symbol table
     AstPackage*		m_packagep;	// Current package
@@ -553,7 +554,7 @@ class LinkDotFindVisitor : public AstNVisitor {
 	    m_scope = "TOP";
 	    m_curSymp = m_modSymp = m_statep->insertTopCell(topmodp, m_scope);
 	    {
-		topmodp->accept(*this);
+		accept(topmodp);
 	    }
 	    m_scope = "";
 	    m_curSymp = m_modSymp = NULL;
@@ -595,7 +596,7 @@ class LinkDotFindVisitor : public AstNVisitor {
 	    m_modBeginNum = 0;
 	    // m_modSymp/m_curSymp for non-packages set by AstCell above this module
 	    // Iterate
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	    nodep->user4(true);
 	    // Interfaces need another pass when signals are resolved
 	    if (AstIface* ifacep = nodep->castIface()) {
@@ -622,7 +623,7 @@ class LinkDotFindVisitor : public AstNVisitor {
     virtual void visit(AstCell* nodep, AstNUser*) {
 	UINFO(5,"   CELL under "<<m_scope<<" is "<<nodep<<endl);
 	// Process XREFs/etc inside pins
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	// Recurse in, preserving state
 	string oldscope = m_scope;
 	AstBegin* oldbeginp = m_beginp;
@@ -647,7 +648,7 @@ class LinkDotFindVisitor : public AstNVisitor {
 	    m_scope = m_scope+"."+nodep->name();
 	    m_curSymp = m_modSymp = m_statep->insertCell(aboveSymp, m_modSymp, nodep, m_scope);
 	    m_beginp = NULL;
-	    if (nodep->modp()) nodep->modp()->accept(*this);
+	    if (nodep->modp()) accept(nodep->modp());
 	}
 	m_scope = oldscope;
 	m_beginp = oldbeginp;
@@ -677,7 +678,7 @@ class LinkDotFindVisitor : public AstNVisitor {
     }
     virtual void visit(AstDefParam* nodep, AstNUser*) {
 	nodep->user1p(m_curSymp);
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstGenerate* nodep, AstNUser*) {
 	// Begin: ... blocks often replicate under genif/genfor, so simply suppress duplicate checks
@@ -685,7 +686,7 @@ class LinkDotFindVisitor : public AstNVisitor {
 	bool lastInGen = m_inGenerate;
 	{
 	    m_inGenerate = true;
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
 	m_inGenerate = lastInGen;
     }
@@ -725,7 +726,7 @@ class LinkDotFindVisitor : public AstNVisitor {
 	    m_curSymp = m_statep->insertBlock(m_curSymp, nodep->name(), nodep, m_packagep);
 	    m_curSymp->fallbackp(oldCurSymp);
 	    // Iterate
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
 	m_curSymp = oldCurSymp;
 	m_beginp = oldbegin;
@@ -761,7 +762,7 @@ class LinkDotFindVisitor : public AstNVisitor {
 		m_statep->insertSym(m_curSymp, newvarp->name(), newvarp, NULL/*packagep*/);
 	    }
 	    m_ftaskp = nodep;
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	    m_ftaskp = NULL;
 	}
 	m_curSymp = oldCurSymp;
@@ -769,7 +770,7 @@ class LinkDotFindVisitor : public AstNVisitor {
     virtual void visit(AstVar* nodep, AstNUser*) {
 	// Var: Remember its name for later resolution
 	if (!m_curSymp || !m_modSymp) nodep->v3fatalSrc("Var not under module??\n");
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (!m_statep->forScopeCreation()) {
 	    // Find under either a task or the module's vars
 	    VSymEnt* foundp = m_curSymp->findIdFallback(nodep->name());
@@ -833,7 +834,7 @@ class LinkDotFindVisitor : public AstNVisitor {
     virtual void visit(AstTypedef* nodep, AstNUser*) {
 	// Remember its name for later resolution
 	if (!m_curSymp) nodep->v3fatalSrc("Typedef not under module??\n");
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_statep->insertSym(m_curSymp, nodep->name(), nodep, m_packagep);
     }
     virtual void visit(AstCFunc* nodep, AstNUser*) {
@@ -842,7 +843,7 @@ class LinkDotFindVisitor : public AstNVisitor {
     }
     virtual void visit(AstEnumItem* nodep, AstNUser*) {
 	// EnumItem: Remember its name for later resolution
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	// Find under either a task or the module's vars
 	VSymEnt* foundp = m_curSymp->findIdFallback(nodep->name());
 	if (!foundp && m_modSymp && nodep->name() == m_modSymp->nodep()->name()) foundp = m_modSymp;  // Conflicts with modname?
@@ -886,7 +887,7 @@ class LinkDotFindVisitor : public AstNVisitor {
 
     virtual void visit(AstNode* nodep, AstNUser*) {
 	// Default: Just iterate
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 
 public:
@@ -903,14 +904,15 @@ public:
 	m_beginNum = 0;
 	m_modBeginNum = 0;
 	//
-	rootp->accept(*this);
+	accept(rootp);
     }
     virtual ~LinkDotFindVisitor() {}
 };
 
 //======================================================================
 
-class LinkDotParamVisitor : public AstNVisitor {
+class LinkDotParamVisitor : public AstNVisitorStatic<LinkDotParamVisitor> {
+    friend class AstNVisitorStatic<LinkDotParamVisitor>;
 private:
     // NODE STATE
     // Cleared on global
@@ -960,7 +962,7 @@ private:
 	    nodep->dead(true);
 	} else {
 	    m_modp = nodep;
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	    m_modp = NULL;
 	}
     }
@@ -973,7 +975,7 @@ private:
 	}
     }
     virtual void visit(AstDefParam* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	nodep->v3warn(DEFPARAM,"Suggest replace defparam with Verilog 2001 #(."<<nodep->prettyName()<<"(...etc...))");
 	VSymEnt* foundp = m_statep->getNodeSym(nodep)->findIdFallback(nodep->path());
 	AstCell* cellp = foundp->nodep()->castCell();
@@ -1017,7 +1019,7 @@ private:
 	// We used to nodep->allowImplicit() here, but it turns out
 	// normal "assigns" can also make implicit wires.  Yuk.
 	pinImplicitExprRecurse(nodep->lhsp());
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstAssignAlias* nodep, AstNUser*) {
 	// tran gates need implicit creation
@@ -1029,7 +1031,7 @@ private:
 	if (AstVarRef* forrefp = nodep->rhsp()->castVarRef()) {
 	    pinImplicitExprRecurse(forrefp);
 	}
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstImplicit* nodep, AstNUser*) {
 	// Unsupported gates need implicit creation
@@ -1039,7 +1041,7 @@ private:
     }
     virtual void visit(AstNode* nodep, AstNUser*) {
 	// Default: Just iterate
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 
 public:
@@ -1049,7 +1051,7 @@ public:
 	m_statep = statep;
 	m_modp = NULL;
 	//
-	rootp->accept(*this);
+	accept(rootp);
     }
     virtual ~LinkDotParamVisitor() {}
 };
@@ -1057,7 +1059,8 @@ public:
 
 //======================================================================
 
-class LinkDotScopeVisitor : public AstNVisitor {
+class LinkDotScopeVisitor : public AstNVisitorStatic<LinkDotScopeVisitor> {
+    friend class AstNVisitorStatic<LinkDotScopeVisitor>;
 
     // STATE
     LinkDotState*	m_statep;	// State to pass between visitors, including symbol table
@@ -1078,7 +1081,7 @@ class LinkDotScopeVisitor : public AstNVisitor {
 	// up with the hierarchy created by the CELL names.
 	m_modSymp = m_statep->getScopeSym(nodep);
 	m_scopep = nodep;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_modSymp = NULL;
 	m_scopep = NULL;
     }
@@ -1122,7 +1125,7 @@ class LinkDotScopeVisitor : public AstNVisitor {
 	AstVarScope* toVscp   = nodep->rhsp()->castVarRef()->varScopep();
 	if (!fromVscp || !toVscp) nodep->v3fatalSrc("Bad alias scopes");
 	fromVscp->user2p(toVscp);
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstAssignVarScope* nodep, AstNUser*) {
 	UINFO(5,"ASSIGNVARSCOPE  "<<nodep<<endl);
@@ -1162,7 +1165,7 @@ class LinkDotScopeVisitor : public AstNVisitor {
     virtual void visit(AstNodeMath*, AstNUser*) {}
     virtual void visit(AstNode* nodep, AstNUser*) {
 	// Default: Just iterate
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 
 public:
@@ -1173,7 +1176,7 @@ public:
 	m_scopep = NULL;
 	m_statep = statep;
 	//
-	rootp->accept(*this);
+	accept(rootp);
     }
     virtual ~LinkDotScopeVisitor() {}
 };
@@ -1181,7 +1184,8 @@ public:
 //======================================================================
 
 // Iterate an interface to resolve modports
-class LinkDotIfaceVisitor : public AstNVisitor {
+class LinkDotIfaceVisitor : public AstNVisitorStatic<LinkDotIfaceVisitor> {
+    friend class AstNVisitorStatic<LinkDotIfaceVisitor>;
     // STATE
     LinkDotState*	m_statep;	// State to pass between visitors, including symbol table
     VSymEnt*		m_curSymp;	// Symbol Entry for current table, where to lookup/insert
@@ -1198,13 +1202,13 @@ class LinkDotIfaceVisitor : public AstNVisitor {
 	    // Create symbol table for the vars
 	    m_curSymp = m_statep->insertBlock(m_curSymp, nodep->name(), nodep, NULL);
 	    m_curSymp->fallbackp(oldCurSymp);
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
 	m_curSymp = oldCurSymp;
     }
     virtual void visit(AstModportVarRef* nodep, AstNUser*) {
 	UINFO(5,"   fiv: "<<nodep<<endl);
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	VSymEnt* symp = m_curSymp->findIdFallback(nodep->name());
 	if (!symp) {
 	    nodep->v3error("Modport item not found: "<<nodep->prettyName());
@@ -1227,7 +1231,7 @@ class LinkDotIfaceVisitor : public AstNVisitor {
     }
     virtual void visit(AstNode* nodep, AstNUser*) {
 	// Default: Just iterate
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 
 public:
@@ -1236,7 +1240,7 @@ public:
 	UINFO(4,__FUNCTION__<<": "<<endl);
 	m_curSymp = curSymp;
 	m_statep = statep;
-	nodep->accept(*this);
+	accept(nodep);
     }
     virtual ~LinkDotIfaceVisitor() {}
 };
@@ -1252,7 +1256,8 @@ void LinkDotState::computeIfaceModSyms() {
 
 //======================================================================
 
-class LinkDotResolveVisitor : public AstNVisitor {
+class LinkDotResolveVisitor : public AstNVisitorStatic<LinkDotResolveVisitor> {
+    friend class AstNVisitorStatic<LinkDotResolveVisitor>;
 private:
     // NODE STATE
     // Cleared on global
@@ -1362,7 +1367,7 @@ private:
 	m_cellp = NULL;
 	m_modp = nodep;
 	m_modportNum = 0;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_modp = NULL;
 	m_ds.m_dotSymp = m_curSymp = m_modSymp = NULL;
     }
@@ -1372,7 +1377,7 @@ private:
 	VSymEnt* oldCurSymp = m_curSymp;
 	checkNoDot(nodep);
 	m_ds.m_dotSymp = m_curSymp = m_modSymp = m_statep->getScopeSym(nodep);
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_ds.m_dotSymp = m_curSymp = m_modSymp = NULL;
 	m_modSymp = oldModSymp;
 	m_curSymp = oldCurSymp;
@@ -1404,7 +1409,7 @@ private:
 		UINFO(4,"(Backto) Link Cell: "<<nodep<<endl);
 		//if (debug()) { nodep->dumpTree(cout,"linkcell:"); }
 		//if (debug()) { nodep->modp()->dumpTree(cout,"linkcemd:"); }
-		nodep->iterateChildren(*this);
+		iterateChildren(nodep);
 		m_pinSymp = NULL;
 	    }
 	}
@@ -1438,7 +1443,7 @@ private:
 		    refp->user5p(nodep);
 		}
 	    }
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
 	// Early return() above when deleted
     }
@@ -1465,12 +1470,12 @@ private:
 		m_ds.m_dotPos = DP_PACKAGE;
 	    } else {
 		m_ds.m_dotPos = DP_SCOPE;
-		nodep->lhsp()->iterateAndNext(*this);
+		iterateAndNext(nodep->lhsp());
 		//if (debug()>=9) nodep->dumpTree("-dot-lho: ");
 	    }
 	    if (!m_ds.m_dotErr) {  // Once something wrong, give up
 		if (start && m_ds.m_dotPos==DP_SCOPE) m_ds.m_dotPos = DP_FINAL;  // Top 'final' dot RHS is final RHS, else it's a DOT(DOT(x,*here*),real-rhs) which we consider a RHS
-		nodep->rhsp()->iterateAndNext(*this);
+		iterateAndNext(nodep->rhsp());
 		//if (debug()>=9) nodep->dumpTree("-dot-rho: ");
 	    }
 	    if (start) {
@@ -1694,7 +1699,7 @@ private:
 	// ParseRefs are used the first pass (forPrimary) so we shouldn't get can't find
 	// errors here now that we have a VarRef.
 	// No checkNoDot; created and iterated from a parseRef
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (!nodep->varp()) {
 	    UINFO(9," linkVarRef se"<<(void*)m_curSymp<<"  n="<<nodep<<endl);
 	    if (!m_curSymp) nodep->v3fatalSrc("NULL lookup symbol table");
@@ -1766,11 +1771,11 @@ private:
     }
     virtual void visit(AstEnumItemRef* nodep, AstNUser*) {
 	// EnumItemRef may be under a dot.  Should already be resolved.
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstVar* nodep, AstNUser*) {
 	checkNoDot(nodep);
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (m_statep->forPrimary() && nodep->isIO() && !m_ftaskp && !nodep->user4()) {
 	    nodep->v3error("Input/output/inout does not appear in port list: "<<nodep->prettyName());
 	}
@@ -1844,13 +1849,13 @@ private:
 	DotStates lastStates = m_ds;
 	{
 	    m_ds.init(m_curSymp);
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
 	m_ds = lastStates;
     }
     virtual void visit(AstSelBit* nodep, AstNUser*) {
 	if (nodep->user3SetOnce()) return;
-	nodep->lhsp()->iterateAndNext(*this);
+	iterateAndNext(nodep->lhsp());
 	if (m_ds.m_dotPos == DP_SCOPE) { // Already under dot, so this is {modulepart} DOT {modulepart}
 	    if (AstConst* constp = nodep->rhsp()->castConst()) {
 		string index = AstNode::encodeNumber(constp->toSInt());
@@ -1861,12 +1866,12 @@ private:
 	    // And pass up m_ds.m_dotText
 	}
 	// Pass dot state down to fromp()
-	nodep->fromp()->iterateAndNext(*this);
+	iterateAndNext(nodep->fromp());
 	DotStates lastStates = m_ds;
 	{
 	    m_ds.init(m_curSymp);
-	    nodep->bitp()->iterateAndNext(*this);
-	    nodep->attrp()->iterateAndNext(*this);
+	    iterateAndNext(nodep->bitp());
+	    iterateAndNext(nodep->attrp());
 	}
 	m_ds = lastStates;
     }
@@ -1878,19 +1883,19 @@ private:
 	    m_ds.m_dotErr = true;
 	    return;
 	}
-	nodep->lhsp()->iterateAndNext(*this);
+	iterateAndNext(nodep->lhsp());
 	DotStates lastStates = m_ds;
 	{
 	    m_ds.init(m_curSymp);
-	    nodep->rhsp()->iterateAndNext(*this);
-	    nodep->thsp()->iterateAndNext(*this);
-	    nodep->attrp()->iterateAndNext(*this);
+	    iterateAndNext(nodep->rhsp());
+	    iterateAndNext(nodep->thsp());
+	    iterateAndNext(nodep->attrp());
 	}
 	m_ds = lastStates;
     }
     virtual void visit(AstMemberSel* nodep, AstNUser*) {
 	// checkNoDot not appropriate, can be under a dot
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstBegin* nodep, AstNUser*) {
 	UINFO(5,"   "<<nodep<<endl);
@@ -1899,7 +1904,7 @@ private:
 	{
 	    m_ds.m_dotSymp = m_curSymp = m_statep->getNodeSym(nodep);
 	    UINFO(5,"   cur=se"<<(void*)m_curSymp<<endl);
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
 	m_ds.m_dotSymp = m_curSymp = oldCurSymp;
 	UINFO(5,"   cur=se"<<(void*)m_curSymp<<endl);
@@ -1911,7 +1916,7 @@ private:
 	{
 	    m_ftaskp = nodep;
 	    m_ds.m_dotSymp = m_curSymp = m_statep->getNodeSym(nodep);
-	    nodep->iterateChildren(*this);
+	    iterateChildren(nodep);
 	}
 	m_ds.m_dotSymp = m_curSymp = oldCurSymp;
 	m_ftaskp = NULL;
@@ -1942,11 +1947,11 @@ private:
 		nodep->v3error("Can't find typedef: "<<nodep->prettyName());
 	    }
 	}
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstDpiExport* nodep, AstNUser*) {
 	// AstDpiExport: Make sure the function referenced exists, then dump it
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	checkNoDot(nodep);
 	VSymEnt* foundp = m_curSymp->findIdFallback(nodep->name());
 	AstNodeFTask* taskp = foundp->nodep()->castNodeFTask();
@@ -1967,7 +1972,7 @@ private:
     virtual void visit(AstNode* nodep, AstNUser*) {
 	// Default: Just iterate
 	checkNoDot(nodep);
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 public:
     // CONSTUCTORS
@@ -1982,7 +1987,7 @@ public:
 	m_ftaskp = NULL;
 	m_modportNum = 0;
 	//
-	rootp->accept(*this);
+	accept(rootp);
     }
     virtual ~LinkDotResolveVisitor() {}
 };
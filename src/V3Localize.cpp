@@ -37,6 +37,7 @@
 #include "V3Localize.h"
 #include "V3Stats.h"
 #include "V3Ast.h"
+#include "V3ThreadPool.h"
 
 //######################################################################
 // Localize base class
@@ -93,7 +94,7 @@ private:
     }
 public:
     // CONSTRUCTORS
-    LocalizeDehierVisitor(AstNetlist* nodep) {
+    LocalizeDehierVisitor(AstNodeModule* nodep) {
 	nodep->accept(*this);
     }
     virtual ~LocalizeDehierVisitor() {}
@@ -106,14 +107,16 @@ class LocalizeVisitor : public LocalizeBaseVisitor {
 private:
     // NODE STATE/TYPES
     // See above
-    AstUser1InUse	m_inuser1;
-    AstUser2InUse	m_inuser2;
-    AstUser4InUse	m_inuser4;
+    // The AstUser*InUse are in V3Localize::localizeAll, shared by every module's job.
+    // A job only changes the state of its own module's variables.  References
+    // through another scope are the only ones that can reach another module's
+    // variable, so those are listed for localizeAll to apply afterwards.
 
     // STATE
     V3Double0	m_statLocVars;	// Statistic tracking
     AstCFunc*	m_cfuncp;	// Current active function
     vector<AstVar*> m_varps;	// List of variables to consider for deletion
+    vector<AstVar*> m_hierVarps;	// Variables referenced through another scope
 
     // METHODS
     void clearOptimizable(AstVar* nodep, const char* reason) {
@@ -128,6 +131,7 @@ private:
 	flags.m_notStd = true;
 	flags.setNodeFlags(nodep);
     }
+public:
     void moveVars() {
 	for (vector<AstVar*>::iterator it = m_varps.begin(); it != m_varps.end(); ++it) {
 	    AstVar* nodep = *it;
@@ -153,12 +157,9 @@ private:
 	}
 	m_varps.clear();
     }
+private:
 
     // VISITORS
-    virtual void visit(AstNetlist* nodep, AstNUser*) {
-	nodep->iterateChildren(*this);
-	moveVars();
-    }
     virtual void visit(AstCFunc* nodep, AstNUser*) {
 	UINFO(4,"  CFUNC "<<nodep<<endl);
 	m_cfuncp = nodep;
@@ -178,7 +179,9 @@ private:
 	    if (nodep->castNodeAssign()) {
 		if (AstVarRef* varrefp = nodep->castNodeAssign()->lhsp()->castVarRef()) {
 		    if (!varrefp->lvalue()) varrefp->v3fatalSrc("LHS assignment not lvalue");
-		    if (!varrefp->varp()->user4p()) {
+		    if (!varrefp->hierThis()) {
+			// Another scope's variable; the visit below lists it as not optimizable
+		    } else if (!varrefp->varp()->user4p()) {
 			UINFO(4,"      FuncAsn "<<varrefp<<endl);
 			varrefp->varp()->user4p(varrefp);
 			VarFlags flags (varrefp->varp());
@@ -200,13 +203,16 @@ private:
 	// No iterate; Don't want varrefs under it
     }
     virtual void visit(AstVarRef* nodep, AstNUser*) {
-	if (!VarFlags(nodep->varp()).m_notOpt) {
+	if (!nodep->hierThis()) {
+	    // If we're scoping down to it, it isn't really in the same block.
+	    // May be another module's variable, so leave it to localizeAll
+	    m_hierVarps.push_back(nodep->varp());
+	}
+	else if (!VarFlags(nodep->varp()).m_notOpt) {
 	    if (!m_cfuncp) {	// Not in function, can't optimize
 		clearOptimizable(nodep->varp(), "BVnofunc");
 	    }
 	    else {
-		// If we're scoping down to it, it isn't really in the same block
-		if (!nodep->hierThis()) clearOptimizable(nodep->varp(),"HierRef");
 		// Allow a variable to appear in only a single function
 		AstNode* oldfunc = nodep->varp()->user1p()->castNode();
 		if (!oldfunc) {
@@ -233,21 +239,65 @@ private:
     }
 public:
     // CONSTRUCTORS
-    LocalizeVisitor(AstNetlist* nodep) {
+    LocalizeVisitor(AstNodeModule* nodep) {
 	m_cfuncp = NULL;
 	nodep->accept(*this);
     }
-    virtual ~LocalizeVisitor() {
-	V3Stats::addStat("Optimizations, Vars localized", m_statLocVars);
+    virtual ~LocalizeVisitor() {}
+    V3Double0 statLocVars() const { return m_statLocVars; }
+    const vector<AstVar*>& hierVarps() const { return m_hierVarps; }
+    static void clearHierOptimizable(AstVar* nodep) {
+	UINFO(4,"       NoOpt HierRef "<<nodep<<endl);
+	VarFlags flags (nodep);
+	flags.m_notOpt = true;
+	flags.setNodeFlags(nodep);
     }
 };
 
+class LocalizeJob : public V3ThreadJob {
+    // Find one module's candidate variables; they are moved once every job is done
+    AstNodeModule*	m_modp;
+    LocalizeVisitor*	m_visitorp;	// Results, once run
+public:
+    explicit LocalizeJob(AstNodeModule* modp) : m_modp(modp), m_visitorp(NULL) {}
+    virtual ~LocalizeJob() { delete m_visitorp; m_visitorp=NULL; }
+    virtual void run() {
+	m_visitorp = new LocalizeVisitor(m_modp);
+    }
+    AstNodeModule* modp() const { return m_modp; }
+    LocalizeVisitor* visitorp() const { return m_visitorp; }
+};
+
 //######################################################################
 // Localize class functions
 
 void V3Localize::localizeAll(AstNetlist* nodep) {
     UINFO(2,__FUNCTION__<<": "<<endl);
-    LocalizeVisitor visitor (nodep);
+    AstUser1InUse	inuser1;  // For all jobs; a job may not allocate user()s
+    AstUser2InUse	inuser2;
+    AstUser4InUse	inuser4;
+    // Search each module, in parallel under --build-jobs
+    vector<LocalizeJob*> jobs;
+    for (AstNodeModule* modp = nodep->modulesp(); modp; modp=modp->nextp()->castNodeModule()) {
+	jobs.push_back(new LocalizeJob(modp));
+    }
+    V3ThreadPool::runJobs(vector<V3ThreadJob*>(jobs.begin(), jobs.end()));
+    // Every job's references through another scope are known only now
+    for (vector<LocalizeJob*>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+	const vector<AstVar*>& hierVarps = (*it)->visitorp()->hierVarps();
+	for (vector<AstVar*>::const_iterator vit = hierVarps.begin(); vit != hierVarps.end(); ++vit) {
+	    LocalizeVisitor::clearHierOptimizable(*vit);
+	}
+    }
+    V3Double0 statLocVars;
+    for (vector<LocalizeJob*>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+	(*it)->visitorp()->moveVars();
+	statLocVars += (*it)->visitorp()->statLocVars();
+    }
+    V3Stats::addStat("Optimizations, Vars localized", statLocVars);
     // Fix up hiernames
-    LocalizeDehierVisitor dvisitor (nodep);
+    for (vector<LocalizeJob*>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+	LocalizeDehierVisitor dvisitor ((*it)->modp());
+	delete *it; *it=NULL;
+    }
 }
@@ -731,14 +731,17 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 	    else if ( onoff   (sw, "-debug-check", flag/*ref*/) ){ m_debugCheck = flag; }
 	    else if ( !strcmp (sw, "-debug-sigsegv") )		{ throwSigsegv(); }  // Undocumented, see also --debug-abort
 	    else if ( !strcmp (sw, "-debug-fatalsrc") )		{ v3fatalSrc("--debug-fatal-src"); }  // Undocumented, see also --debug-abort
+	    else if ( onoff   (sw, "-dpi-static-dispatch", flag/*ref*/) ){ m_dpiStaticDispatch = flag; }
 	    else if ( onoff   (sw, "-dump-tree", flag/*ref*/) )	{ m_dumpTree = flag ? 3 : 0; }  // Also see --dump-treei
 	    else if ( onoff   (sw, "-exe", flag/*ref*/) )	{ m_exe = flag; }
 	    else if ( onoff   (sw, "-ignc", flag/*ref*/) )	{ m_ignc = flag; }
+	    else if ( onoff   (sw, "-incremental", flag/*ref*/)){ m_incremental = flag; }
 	    else if ( onoff   (sw, "-inhibit-sim", flag/*ref*/)){ m_inhibitSim = flag; }
 	    else if ( onoff   (sw, "-l2name", flag/*ref*/) )	{ m_l2Name = flag; }
 	    else if ( onoff   (sw, "-lint-only", flag/*ref*/) )	{ m_lintOnly = flag; }
 	    else if ( !strcmp (sw, "-no-pins64") )		{ m_pinsBv = 33; }
 	    else if ( onoff   (sw, "-order-clock-delay", flag/*ref*/) )	{ m_orderClockDly = flag; }
+	    else if ( onoff   (sw, "-parse-cache", flag/*ref*/) )	{ m_parseCache = flag; }
 	    else if ( !strcmp (sw, "-pins64") )			{ m_pinsBv = 65; }
 	    else if ( onoff   (sw, "-pins-sc-uint", flag/*ref*/) ){ m_pinsScUint = flag; if (!m_pinsScBigUint) m_pinsBv = 65; }
 	    else if ( onoff   (sw, "-pins-sc-biguint", flag/*ref*/) ){ m_pinsScBigUint = flag; m_pinsBv = 513; }
@@ -753,6 +756,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 	    else if ( onoff   (sw, "-skip-identical", flag/*ref*/) )	{ m_skipIdentical = flag; }
 	    else if ( !strcmp (sw, "-sp") )				{ m_outFormatOk = true; m_systemC = true; m_systemPerl = true; }
 	    else if ( onoff   (sw, "-stats", flag/*ref*/) )		{ m_stats = flag; }
+	    else if ( onoff   (sw, "-stats-trace", flag/*ref*/) )	{ m_statsTrace = flag; if (flag) m_stats = true; }
 	    else if ( !strcmp (sw, "-sv") )				{ m_defaultLanguage = V3LangCode::L1800_2005; }
 	    else if ( onoff   (sw, "-trace", flag/*ref*/) )		{ m_trace = flag; }
 	    else if ( onoff   (sw, "-trace-dups", flag/*ref*/) )	{ m_traceDups = flag; }
@@ -792,6 +796,11 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 		}
 	    }
 	    // Parameterized switches
+	    else if ( !strcmp (sw, "-build-jobs") && (i+1)<argc ) {
+		shift;
+		m_buildJobs = atoi(argv[i]);
+		if (m_buildJobs < 1) fl->v3fatal("--build-jobs must be >= 1: "<<argv[i]);
+	    }
 	    else if ( !strcmp (sw, "-CFLAGS") && (i+1)<argc ) {
 		shift;
 		addCFlags(argv[i]);
@@ -871,6 +880,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 		shift;
 		m_outputSplitCTrace = atoi(argv[i]);
 	    }
+	    else if ( !strcmp (sw, "-sparse-memory") && (i+1)<argc ) {
+		shift;
+		m_sparseMemory = atoi(argv[i]);
+	    }
 	    else if ( !strcmp (sw, "-trace-depth") && (i+1)<argc ) {
 		shift;
 		m_traceDepth = atoi(argv[i]);
@@ -1198,14 +1211,17 @@ V3Options::V3Options() {
     m_coverageUnderscore = false;
     m_coverageUser = false;
     m_debugCheck = false;
+    m_dpiStaticDispatch = false;
     m_exe = false;
     m_ignc = false;
+    m_incremental = false;
     m_l2Name = true;
     m_lintOnly = false;
     m_makeDepend = true;
     m_makePhony = false;
     m_orderClockDly = true;
     m_outFormatOk = false;
+    m_parseCache = false;
     m_warnFatal = true;
     m_pinsBv = 65;
     m_profileCFuncs = false;
@@ -1215,6 +1231,7 @@ V3Options::V3Options() {
     m_savable = false;
     m_skipIdentical = true;
     m_stats = false;
+    m_statsTrace = false;
     m_systemC = false;
     m_systemPerl = false;
     m_trace = false;
@@ -1225,6 +1242,7 @@ V3Options::V3Options() {
     m_xInitialEdge = false;
     m_xmlOnly = false;
 
+    m_buildJobs = 1;
     m_convergeLimit = 100;
     m_dumpTree = 0;
     m_errorLimit = 50;
@@ -1233,6 +1251,7 @@ V3Options::V3Options() {
     m_outputSplit = 0;
     m_outputSplitCFuncs = 0;
     m_outputSplitCTrace = 0;
+    m_sparseMemory = 0;
     m_traceDepth = 0;
     m_traceMaxArray = 32;
     m_traceMaxWidth = 256;
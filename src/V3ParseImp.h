@@ -80,6 +80,7 @@ struct V3ParseBisonYYSType {
 	AstPatMember*	patmemberp;
 	AstPattern*	patternp;
 	AstPin*		pinp;
+	AstNodeRange*	noderangep;
 	AstRange*	rangep;
 	AstSenTree*	sentreep;
 	AstVar*		varp;
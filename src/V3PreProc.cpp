@@ -38,6 +38,7 @@
 #include "V3PreLex.h"
 #include "V3PreProc.h"
 #include "V3PreShell.h"
+#include "V3String.h"
 
 //======================================================================
 // Build in LEX script
@@ -57,13 +58,27 @@ class V3Define {
     string	m_value;	// Value of define
     string	m_params;	// Parameters
     bool	m_cmdline;	// Set on command line, don't `undefineall
+    // Parsed m_params and m_value, set by V3PreProcImp::defineParse on first use
+    bool	m_parsed;	// Below are valid
+    vector<string> m_formals;	// Argument names
+    vector<string> m_defaults;	// Default value of each argument, or ""
+    vector<bool> m_hasDefaults;	// Argument has a default
+    vector<string> m_bodyText;	// Literal text, each but the last followed by an argument
+    vector<int>	m_bodyArgs;	// Argument number following each m_bodyText
 public:
     V3Define(FileLine* fl, const string& value, const string& params, bool cmdline)
-	: m_fileline(fl), m_value(value), m_params(params), m_cmdline(cmdline) {}
+	: m_fileline(fl), m_value(value), m_params(params), m_cmdline(cmdline), m_parsed(false) {}
     FileLine* fileline() const { return m_fileline; }
     string value() const { return m_value; }
     string params() const { return m_params; }
     bool cmdline() const { return m_cmdline; }
+    bool parsed() const { return m_parsed; }
+    void parsed(bool flag) { m_parsed = flag; }
+    vector<string>& formals() { return m_formals; }
+    vector<string>& defaults() { return m_defaults; }
+    vector<bool>& hasDefaults() { return m_hasDefaults; }
+    vector<string>& bodyText() { return m_bodyText; }
+    vector<int>& bodyArgs() { return m_bodyArgs; }
 };
 
 //*************************************************************************
@@ -117,6 +132,7 @@ public:
 
     // Defines list
     DefinesMap	m_defines;	///< Map of defines
+    VCStrHash<V3Define*> m_defineHash;	///< Index of m_defines, keyed by the map's own key storage
 
     // STATE
     V3PreProc*	m_preprocp;	///< Object we're holding data for
@@ -183,8 +199,10 @@ public:
 private:
     // Internal methods
     void endOfOneFile();
+    void defineParse(V3Define* defp);
     string defineSubst(V3DefineRef* refp);
 
+    V3Define* defFind(const string& name);
     bool defExists(const string& name);
     string defValue(const string& name);
     string defParams(const string& name);
@@ -237,6 +255,7 @@ public:
     virtual void define (FileLine* fl, const string& name, const string& value,
 			 const string& params, bool cmdline);
     virtual string removeDefines(const string& text);	// Remove defines in a text string
+    virtual void definesState(DefinesState& defs) const;
 
     // CONSTRUCTORS
     V3PreProcImp() : V3PreProc() {
@@ -290,39 +309,45 @@ bool V3PreProc::optPsl() {
 // Defines
 
 void V3PreProcImp::undef(const string& name) {
+    m_defineHash.erase(name.c_str());
     m_defines.erase(name);
 }
 void V3PreProcImp::undefineall() {
     for (DefinesMap::iterator nextit, it = m_defines.begin(); it != m_defines.end(); it=nextit) {
 	nextit = it; ++nextit;
-	if (!it->second.cmdline()) m_defines.erase(it);
+	if (!it->second.cmdline()) {
+	    m_defineHash.erase(it->first.c_str());
+	    m_defines.erase(it);
+	}
     }
 }
+V3Define* V3PreProcImp::defFind(const string& name) {
+    V3Define* const* defpp = m_defineHash.find(name.c_str());
+    return defpp ? *defpp : NULL;
+}
 bool V3PreProcImp::defExists(const string& name) {
-    DefinesMap::iterator iter = m_defines.find(name);
-    if (iter == m_defines.end()) return false;
-    return true;
+    return defFind(name) != NULL;
 }
 string V3PreProcImp::defValue(const string& name) {
-    DefinesMap::iterator iter = m_defines.find(name);
-    if (iter == m_defines.end()) {
+    V3Define* defp = defFind(name);
+    if (!defp) {
 	fileline()->v3error("Define or directive not defined: `"+name);
 	return "";
     }
-    return iter->second.value();
+    return defp->value();
 }
 string V3PreProcImp::defParams(const string& name) {
-    DefinesMap::iterator iter = m_defines.find(name);
-    if (iter == m_defines.end()) {
+    V3Define* defp = defFind(name);
+    if (!defp) {
 	fileline()->v3error("Define or directive not defined: `"+name);
 	return "";
     }
-    return iter->second.params();
+    return defp->params();
 }
 FileLine* V3PreProcImp::defFileline(const string& name) {
-    DefinesMap::iterator iter = m_defines.find(name);
-    if (iter == m_defines.end()) return NULL;
-    return iter->second.fileline();
+    V3Define* defp = defFind(name);
+    if (!defp) return NULL;
+    return defp->fileline();
 }
 void V3PreProcImp::define(FileLine* fl, const string& name, const string& value,
 			  const string& params, bool cmdline) {
@@ -334,7 +359,16 @@ void V3PreProcImp::define(FileLine* fl, const string& name, const string& value,
 	}
 	undef(name);
     }
-    m_defines.insert(make_pair(name, V3Define(fl, value, params, cmdline)));
+    DefinesMap::iterator it = m_defines.insert(make_pair(name, V3Define(fl, value, params, cmdline))).first;
+    m_defineHash.insert(it->first.c_str(), &(it->second));
+}
+
+void V3PreProcImp::definesState(DefinesState& defs) const {
+    defs.clear();
+    for (DefinesMap::const_iterator it = m_defines.begin(); it != m_defines.end(); ++it) {
+	defs.insert(make_pair(it->first, DefineState(it->second.fileline(), it->second.value(),
+						     it->second.params(), it->second.cmdline())));
+    }
 }
 
 string V3PreProcImp::removeDefines(const string& sym) {
@@ -540,56 +574,35 @@ string V3PreProcImp::trimWhitespace(const string& strg, bool trailing) {
     return out;
 }
 
-string V3PreProcImp::defineSubst(V3DefineRef* refp) {
-    // Substitute out defines in a define reference.
-    // (We also need to call here on non-param defines to handle `")
-    // We could push the define text back into the lexer, but that's slow
-    // and would make recursive definitions and parameter handling nasty.
-    //
-    // Note we parse the definition parameters and value here.  If a
-    // parametrized define is used many, many times, we could cache the
-    // parsed result.
-    UINFO(4,"defineSubstIn  `"<<refp->name()<<" "<<refp->params()<<endl);
-    for (unsigned i=0; i<refp->args().size(); i++) {
-	UINFO(4,"defineArg["<<i<<"] = '"<<refp->args()[i]<<"'"<<endl);
-    }
-    // Grab value
-    string value = defValue(refp->name());
-    UINFO(4,"defineValue    '"<<V3PreLex::cleanDbgStrg(value)<<"'"<<endl);
-
-    map<string,string> argValueByName;
-    {   // Parse argument list into map
-	unsigned numArgs=0;
+void V3PreProcImp::defineParse(V3Define* defp) {
+    // Parse the definition parameters and value into the argument names
+    // and the literal text between argument references.  This is done once
+    // per define, so each substitution only needs to paste in arguments.
+    UINFO(4,"defineParse    `"<<defp->params()<<endl);
+    defp->parsed(true);
+    {   // Parse argument list
 	string argName;
 	int paren = 1;  // (), {} and [] can use same counter, as must be matched pair per spec
 	string token;
 	bool quote = false;
 	bool haveDefault = false;
 	// Note there's a leading ( and trailing ), so parens==1 is the base parsing level
-	const char* cp=refp->params().c_str();
+	string params = defp->params();
+	const char* cp=params.c_str();
 	if (*cp == '(') cp++;
 	for (; *cp; cp++) {
-	    //UINFO(4,"   Parse  Paren="<<paren<<"  Arg="<<numArgs<<"  token='"<<token<<"'  Parse="<<cp<<endl);
+	    //UINFO(4,"   Parse  Paren="<<paren<<"  Arg="<<defp->formals().size()<<"  token='"<<token<<"'  Parse="<<cp<<endl);
 	    if (!quote && paren==1) {
 		if (*cp==')' || *cp==',') {
 		    string value;
 		    if (haveDefault) { value=token; } else { argName=token; }
 		    argName = trimWhitespace(argName,true);
-		    UINFO(4,"    Got Arg="<<numArgs<<"  argName='"<<argName<<"'  default='"<<value<<"'"<<endl);
-		    // Parse it
+		    UINFO(4,"    Got Arg="<<defp->formals().size()<<"  argName='"<<argName<<"'  default='"<<value<<"'"<<endl);
 		    if (argName!="") {
-			if (refp->args().size() > numArgs) {
-			    // A call `def( a ) must be equivelent to `def(a ), so trimWhitespace
-			    // At one point we didn't trim trailing whitespace, but this confuses `"
-			    string arg = trimWhitespace(refp->args()[numArgs], true);
-			    if (arg != "") value = arg;
-			} else if (!haveDefault) {
-			    error("Define missing argument '"+argName+"' for: "+refp->name()+"\n");
-			    return " `"+refp->name()+" ";
-			}
-			numArgs++;
+			defp->formals().push_back(argName);
+			defp->defaults().push_back(value);
+			defp->hasDefaults().push_back(haveDefault);
 		    }
-		    argValueByName[argName] = value;
 		    // Prepare for next
 		    argName = "";
 		    token = "";
@@ -616,16 +629,15 @@ string V3PreProcImp::defineSubst(V3DefineRef* refp) {
 	    if (*cp=='"') quote=!quote;
 	    if (*cp) token += *cp;
 	}
-	if (refp->args().size() > numArgs
-	    // `define X() is ok to call with nothing
-	    && !(refp->args().size()==1 && numArgs==0 && trimWhitespace(refp->args()[0],false)=="")) {
-	    error("Define passed too many arguments: "+refp->name()+"\n");
-	    return " `"+refp->name()+" ";
-	}
     }
 
-    string out = "";
-    {   // Parse substitution define using arguments
+    {   // Parse substitution into literal text and argument references
+	map<string,int> argNumByName;
+	for (unsigned i=0; i<defp->formals().size(); i++) {
+	    argNumByName[defp->formals()[i]] = i;  // Last of duplicate names wins
+	}
+	string value = defp->value();
+	string out = "";
 	string argName;
 	string prev;
 	bool quote = false;
@@ -637,18 +649,19 @@ string V3PreProcImp::defineSubst(V3DefineRef* refp) {
 	    else if (isspace(*cp)) { backslashesc = false; }
 	    // We don't check for quotes; some simulators expand even inside quotes
 	    if ( isalpha(*cp) || *cp=='_'
-		 || *cp=='$' // Won't replace system functions, since no $ in argValueByName
+		 || *cp=='$' // Won't replace system functions, since no $ in argNumByName
 		 || (argName!="" && (isdigit(*cp) || *cp=='$'))) {
 		argName += *cp;
 		continue;
 	    }
 	    if (argName != "") {
 		// Found a possible variable substitution
-		map<string,string>::iterator iter = argValueByName.find(argName);
-		if (iter != argValueByName.end()) {
-		    // Substitute
-		    string subst = iter->second;
-		    out += subst;
+		map<string,int>::iterator iter = argNumByName.find(argName);
+		if (iter != argNumByName.end()) {
+		    // Substitute at expansion time
+		    defp->bodyText().push_back(out);
+		    defp->bodyArgs().push_back(iter->second);
+		    out = "";
 		} else {
 		    out += argName;
 		}
@@ -707,6 +720,58 @@ string V3PreProcImp::defineSubst(V3DefineRef* refp) {
 	    if (*cp=='"') quote=!quote;
 	    if (*cp) out += *cp;
 	}
+	defp->bodyText().push_back(out);
+    }
+}
+
+string V3PreProcImp::defineSubst(V3DefineRef* refp) {
+    // Substitute out defines in a define reference.
+    // (We also need to call here on non-param defines to handle `")
+    // We could push the define text back into the lexer, but that's slow
+    // and would make recursive definitions and parameter handling nasty.
+    UINFO(4,"defineSubstIn  `"<<refp->name()<<" "<<refp->params()<<endl);
+    for (unsigned i=0; i<refp->args().size(); i++) {
+	UINFO(4,"defineArg["<<i<<"] = '"<<refp->args()[i]<<"'"<<endl);
+    }
+    // Grab value
+    V3Define* defp = defFind(refp->name());
+    if (!defp) {
+	fileline()->v3error("Define or directive not defined: `"+refp->name());
+	return "";
+    }
+    UINFO(4,"defineValue    '"<<V3PreLex::cleanDbgStrg(defp->value())<<"'"<<endl);
+    if (!defp->parsed()) defineParse(defp);
+
+    vector<string> argValues;
+    {   // Match arguments to the parsed argument list
+	unsigned numArgs = defp->formals().size();
+	argValues.reserve(numArgs);
+	for (unsigned i=0; i<numArgs; i++) {
+	    string value = defp->defaults()[i];
+	    if (refp->args().size() > i) {
+		// A call `def( a ) must be equivelent to `def(a ), so trimWhitespace
+		// At one point we didn't trim trailing whitespace, but this confuses `"
+		string arg = trimWhitespace(refp->args()[i], true);
+		if (arg != "") value = arg;
+	    } else if (!defp->hasDefaults()[i]) {
+		error("Define missing argument '"+defp->formals()[i]+"' for: "+refp->name()+"\n");
+		return " `"+refp->name()+" ";
+	    }
+	    argValues.push_back(value);
+	}
+	if (refp->args().size() > numArgs
+	    // `define X() is ok to call with nothing
+	    && !(refp->args().size()==1 && numArgs==0 && trimWhitespace(refp->args()[0],false)=="")) {
+	    error("Define passed too many arguments: "+refp->name()+"\n");
+	    return " `"+refp->name()+" ";
+	}
+    }
+
+    // Paste arguments between the literal text
+    string out = defp->bodyText()[0];
+    for (unsigned i=0; i<defp->bodyArgs().size(); i++) {
+	out += argValues[defp->bodyArgs()[i]];
+	out += defp->bodyText()[i+1];
     }
 
     UINFO(4,"defineSubstOut '"<<V3PreLex::cleanDbgStrg(out)<<"'"<<endl);
@@ -720,12 +785,16 @@ void V3PreProcImp::openFile(FileLine* fl, V3InFilter* filterp, const string& fil
     // Open a new file, possibly overriding the current one which is active.
     V3File::addSrcDepend(filename);
 
-    // Read a list<string> with the whole file.
+    // Large files are mapped and lexed in place, saving a copy of the contents.
+    // Else read a list<string> with the whole file.
+    V3InFileMap* mapp = filterp->mapWholefile(filename);
     StrList wholefile;
-    bool ok = filterp->readWholefile(filename, wholefile/*ref*/);
-    if (!ok) {
-	error("File not found: "+filename+"\n");
-	return;
+    if (!mapp) {
+	bool ok = filterp->readWholefile(filename, wholefile/*ref*/);
+	if (!ok) {
+	    error("File not found: "+filename+"\n");
+	    return;
+	}
     }
 
     if (!m_preprocp->isEof()) {  // IE not the first file.
@@ -733,6 +802,7 @@ void V3PreProcImp::openFile(FileLine* fl, V3InFilter* filterp, const string& fil
 	// up, with guards preventing a real recursion.
 	if (m_lexp->m_streampStack.size()>V3PreProc::INCLUDE_DEPTH_MAX) {
 	    error("Recursive inclusion of file: "+filename);
+	    if (mapp) { delete mapp; mapp=NULL; }
 	    return;
 	}
 	// There's already a file active.  Push it to work on the new one.
@@ -743,6 +813,12 @@ void V3PreProcImp::openFile(FileLine* fl, V3InFilter* filterp, const string& fil
     m_lexp->scanNewFile(m_preprocp->fileline()->create(filename, 1));
     addLineComment(1); // Enter
 
+    if (mapp) {
+	// The lexer filters DOS CR's as it copies from the mapping
+	m_lexp->scanMappedBack(mapp);
+	return;
+    }
+
     // Filter all DOS CR's en-mass.  This avoids bugs with lexing CRs in the wrong places.
     // This will also strip them from strings, but strings aren't supposed to be multi-line without a "\"
     for (StrList::iterator it=wholefile.begin(); it!=wholefile.end(); ++it) {
@@ -1270,7 +1346,8 @@ int V3PreProcImp::getStateToken() {
 		goto next_tok;
 	    }
 	    // substitute
-	    if (!defExists(name)) {   // Not found, return original string as-is
+	    V3Define* defp = defFind(name);
+	    if (!defp) {   // Not found, return original string as-is
 		m_defDepth = 0;
 		UINFO(4,"Defref `"<<name<<" => not_defined"<<endl);
 		if (m_off) {
@@ -1280,7 +1357,7 @@ int V3PreProcImp::getStateToken() {
 		}
 	    }
 	    else {
-		string params = defParams(name);
+		string params = defp->params();
 		if (params=="0" || params=="") {  // Found, as simple substitution
 		    if (m_off) {
 			goto next_tok;
@@ -89,6 +89,21 @@ public:
     }
     virtual string removeDefines(const string& text)=0;	// Remove defines in a text string
 
+    // Define table snapshot, so the parse cache can key on and replay define changes
+    class DefineState {
+    public:
+	string		m_value;	// Value of define
+	string		m_params;	// Parameters
+	FileLine*	m_fileline;	// Where it was declared
+	bool		m_cmdline;	// Set on command line
+	DefineState(FileLine* fl, const string& value, const string& params, bool cmdline)
+	    : m_value(value), m_params(params), m_fileline(fl), m_cmdline(cmdline) {}
+	bool sameValue(const DefineState& rh) const {
+	    return m_value==rh.m_value && m_params==rh.m_params && m_cmdline==rh.m_cmdline; }
+    };
+    typedef std::map<string,DefineState> DefinesState;
+    virtual void definesState(DefinesState& defs) const=0;	// Return all current defines
+
     // UTILITIES
     void error(string msg) { fileline()->v3error(msg); }	///< Report a error
     void fatal(string msg) { fileline()->v3fatalSrc(msg); }	///< Report a fatal error
@@ -27,6 +27,9 @@
 #include <algorithm>
 #include <list>
 #include <set>
+#include <map>
+#include <fstream>
+#include <iomanip>
 
 #include "V3Global.h"
 #include "V3PreShell.h"
@@ -34,6 +37,146 @@
 #include "V3File.h"
 #include "V3Parse.h"
 
+//######################################################################
+// Parse cache (--parse-cache)
+
+class V3PreCacheEntry {
+    // Preprocessor output of one file, along with the files it read and
+    // the define changes it made.  Saved in {prefix}__verParse_{key}.dat,
+    // where the key hashes the command line, the file name and the defines
+    // in effect when the file was opened.
+public:
+    // TYPES
+    typedef map<string,vluint64_t> FileHashMap;
+    typedef V3PreProc::DefinesState DefinesState;
+
+    // MEMBERS
+    FileHashMap		m_files;	// Files read, and hash of their contents
+    list<string>	m_text;		// Preprocessor output, as returned by getline()
+    DefinesState	m_defines;	// Defines created or changed
+    list<string>	m_undefs;	// Defines removed or changed
+
+private:
+    static void putStr(ostream& os, const string& str) {
+	os<<" "<<str.length()<<":"<<str;
+    }
+    static bool getStr(istream& is, string& str) {
+	size_t len = 0;
+	is>>len;
+	if (is.get()!=':') return false;
+	str.resize(len);
+	if (len) is.read(&str[0], len);
+	return !is.fail();
+    }
+    static vluint64_t hashFile(V3InFilter* filterp, const string& filename) {
+	if (V3InFileMap* mapp = filterp->mapWholefile(filename)) {
+	    vluint64_t hash = V3File::hashText(mapp->data(), mapp->size());
+	    delete mapp; mapp=NULL;
+	    return hash;
+	}
+	V3InFilter::StrList outl;
+	if (!filterp->readWholefile(filename, outl)) return 0;
+	string text;
+	for (V3InFilter::StrList::iterator it=outl.begin(); it!=outl.end(); ++it) text += *it;
+	return V3File::hashText(text);
+    }
+
+public:
+    static string filename(const string& srcFilename, const DefinesState& defs) {
+	string key = (string)DTVERSION+"\n"+v3Global.opt.allArgsString()+"\n"+srcFilename+"\n";
+	for (DefinesState::const_iterator it = defs.begin(); it != defs.end(); ++it) {
+	    key += it->first+'\0'+it->second.m_params+'\0'+it->second.m_value
+		+'\0'+(it->second.m_cmdline?"1":"0")+"\n";
+	}
+	ostringstream os;
+	os<<v3Global.opt.makeDir()<<"/"<<v3Global.opt.prefix()<<"__verParse_"
+	  <<hex<<setw(16)<<setfill('0')<<V3File::hashText(key)<<".dat";
+	return os.str();
+    }
+    void addFile(V3InFilter* filterp, const string& filename) {
+	m_files[filename] = hashFile(filterp, filename);
+    }
+    void addDefineChanges(const DefinesState& beforeDefs, const DefinesState& afterDefs) {
+	for (DefinesState::const_iterator it = beforeDefs.begin(); it != beforeDefs.end(); ++it) {
+	    DefinesState::const_iterator ait = afterDefs.find(it->first);
+	    if (ait == afterDefs.end() || !ait->second.sameValue(it->second)) {
+		m_undefs.push_back(it->first);
+	    }
+	}
+	for (DefinesState::const_iterator it = afterDefs.begin(); it != afterDefs.end(); ++it) {
+	    DefinesState::const_iterator bit = beforeDefs.find(it->first);
+	    if (bit == beforeDefs.end() || !bit->second.sameValue(it->second)) {
+		m_defines.insert(*it);
+	    }
+	}
+    }
+    bool upToDate(V3InFilter* filterp) {
+	// Any file read changed since the entry was written?
+	for (FileHashMap::iterator it = m_files.begin(); it != m_files.end(); ++it) {
+	    if (hashFile(filterp, it->first) != it->second) {
+		UINFO(2,"    Parse cache stale: "<<it->first<<endl);
+		return false;
+	    }
+	}
+	return true;
+    }
+    bool read(const string& filename) {
+	ifstream is (filename.c_str(), ios::binary);
+	if (is.fail()) return false;
+	string ignore;
+	getline(is, ignore);  // Header comment
+	char tag;
+	while (is>>tag) {
+	    string name;
+	    if (!getStr(is, name)) return false;
+	    switch (tag) {
+	    case 'F': {
+		vluint64_t hash;
+		is>>hex>>hash>>dec;
+		m_files[name] = hash;
+		break;
+	    }
+	    case 'D': {
+		string params, value, flname;
+		int lineno; bool cmdline;
+		if (!getStr(is, params) || !getStr(is, value) || !getStr(is, flname)) return false;
+		is>>lineno>>cmdline;
+		m_defines.insert(make_pair(name, V3PreProc::DefineState(new FileLine(flname, lineno),
+									 value, params, cmdline)));
+		break;
+	    }
+	    case 'U': m_undefs.push_back(name); break;
+	    case 'T': m_text.push_back(name); break;
+	    default: return false;
+	    }
+	    if (is.fail()) return false;
+	}
+	return is.eof();
+    }
+    void write(const string& filename) {
+	ofstream* ofp = V3File::new_ofstream_nodepend(filename);
+	if (ofp->fail()) v3fatal("Cannot write "<<filename);
+	*ofp<<"# DESCR"<<"IPTION: Verilator output: Parse cache entry.  Delete at will."<<endl;
+	for (FileHashMap::iterator it = m_files.begin(); it != m_files.end(); ++it) {
+	    *ofp<<"F"; putStr(*ofp, it->first);
+	    *ofp<<" "<<hex<<it->second<<dec<<"\n";
+	}
+	for (list<string>::iterator it = m_undefs.begin(); it != m_undefs.end(); ++it) {
+	    *ofp<<"U"; putStr(*ofp, *it); *ofp<<"\n";
+	}
+	for (DefinesState::iterator it = m_defines.begin(); it != m_defines.end(); ++it) {
+	    *ofp<<"D"; putStr(*ofp, it->first);
+	    putStr(*ofp, it->second.m_params); putStr(*ofp, it->second.m_value);
+	    putStr(*ofp, it->second.m_fileline->filename());
+	    *ofp<<" "<<it->second.m_fileline->lineno()<<" "<<it->second.m_cmdline<<"\n";
+	}
+	for (list<string>::iterator it = m_text.begin(); it != m_text.end(); ++it) {
+	    *ofp<<"T"; putStr(*ofp, *it); *ofp<<"\n";
+	}
+	delete ofp; ofp=NULL;
+    }
+};
+
 //######################################################################
 
 class V3PreShellImp {
@@ -43,6 +186,9 @@ protected:
     static V3PreShellImp s_preImp;
     static V3PreProc*	s_preprocp;
     static V3InFilter*	s_filterp;
+    static V3PreCacheEntry* s_cacheEntryp;	// Entry being recorded, or NULL
+    static int		s_cacheHits;	// Parse cache statistics
+    static int		s_cacheMisses;
 
     //---------------------------------------
     // METHODS
@@ -102,37 +248,93 @@ protected:
 
 	// Preprocess
 	s_filterp = filterp;
-	bool ok = preprocOpen(fl, s_filterp, modname, errmsg);
-	if (!ok) return false;
+	string filename = preprocFilename(fl, modname, errmsg);
+	if (filename=="") return false;  // Not found
+	if (!v3Global.opt.parseCache()) {
+	    preprocFile(fl, filename, parsep);
+	    return true;
+	}
+
+	V3PreProc::DefinesState beforeDefs;
+	s_preprocp->definesState(beforeDefs);
+	string cacheFilename = V3PreCacheEntry::filename(filename, beforeDefs);
+	{
+	    V3PreCacheEntry entry;
+	    if (entry.read(cacheFilename) && entry.upToDate(filterp)) {
+		UINFO(2,"    Parse cache hit "<<cacheFilename<<endl);
+		s_cacheHits++;
+		cacheReplay(entry, parsep);
+		return true;
+	    }
+	}
+	s_cacheMisses++;
 
+	V3PreCacheEntry entry;
+	int errsBefore = V3Error::errorOrWarnCount();
+	s_cacheEntryp = &entry;
+	preprocFile(fl, filename, parsep);
+	s_cacheEntryp = NULL;
+	if (V3Error::errorOrWarnCount() == errsBefore) {  // Else messages would be lost on a hit
+	    V3PreProc::DefinesState afterDefs;
+	    s_preprocp->definesState(afterDefs);
+	    entry.addDefineChanges(beforeDefs, afterDefs);
+	    entry.write(cacheFilename);
+	}
+	return true;
+    }
+
+    void preprocFile (FileLine* fl, const string& filename, V3ParseImp* parsep) {
+	preprocOpenFile(fl, filename);
 	while (!s_preprocp->isEof()) {
 	    string line = s_preprocp->getline();
 	    V3Parse::ppPushText(parsep, line);
+	    if (s_cacheEntryp) s_cacheEntryp->m_text.push_back(line);
+	}
+    }
+
+    void cacheReplay (const V3PreCacheEntry& entry, V3ParseImp* parsep) {
+	// Same side effects as preprocFile, without running the preprocessor
+	for (V3PreCacheEntry::FileHashMap::const_iterator it = entry.m_files.begin();
+	     it != entry.m_files.end(); ++it) {
+	    V3File::addSrcDepend(it->first);
+	}
+	for (list<string>::const_iterator it = entry.m_undefs.begin(); it != entry.m_undefs.end(); ++it) {
+	    s_preprocp->undef(*it);
+	}
+	for (V3PreProc::DefinesState::const_iterator it = entry.m_defines.begin();
+	     it != entry.m_defines.end(); ++it) {
+	    s_preprocp->define(it->second.m_fileline, it->first, it->second.m_value,
+			       it->second.m_params, it->second.m_cmdline);
+	}
+	for (list<string>::const_iterator it = entry.m_text.begin(); it != entry.m_text.end(); ++it) {
+	    V3Parse::ppPushText(parsep, *it);
 	}
-	return true;
     }
 
     void preprocInclude (FileLine* fl, const string& modname) {
 	if (modname[0]=='/' || modname[0]=='\\') {
 	    fl->v3warn(INCABSPATH,"Suggest `include with absolute path be made relative, and use +include: "<<modname);
 	}
-	preprocOpen(fl, s_filterp, modname, "Cannot find include file: ");
+	string filename = preprocFilename(fl, modname, "Cannot find include file: ");
+	if (filename=="") return;  // Not found
+	preprocOpenFile(fl, filename);
     }
 
-    bool preprocOpen (FileLine* fl, V3InFilter* filterp, const string& modname,
-		      const string& errmsg) {  // Error message or "" to suppress
-	// Returns true if successful
+    string preprocFilename (FileLine* fl, const string& modname,
+			    const string& errmsg) {  // Error message or "" to suppress
+	// Returns filename, or "" if not found
 	// Allow user to put `defined names on the command line instead of filenames,
 	// then convert them properly.
 	string ppmodname = s_preprocp->removeDefines (modname);
 
 	// Open include or master file
-	string filename = v3Global.opt.filePath (fl, ppmodname, errmsg);
-	if (filename=="") return false;  // Not found
+	return v3Global.opt.filePath (fl, ppmodname, errmsg);
+    }
 
+    void preprocOpenFile (FileLine* fl, const string& filename) {
 	UINFO(2,"    Reading "<<filename<<endl);
-	s_preprocp->openFile(fl, filterp, filename);
-	return true;
+	if (s_cacheEntryp) s_cacheEntryp->addFile(s_filterp, filename);
+	s_preprocp->openFile(fl, s_filterp, filename);
     }
 
     // CONSTRUCTORS
@@ -143,6 +345,9 @@ protected:
 V3PreShellImp V3PreShellImp::s_preImp;
 V3PreProc* V3PreShellImp::s_preprocp = NULL;
 V3InFilter* V3PreShellImp::s_filterp = NULL;
+V3PreCacheEntry* V3PreShellImp::s_cacheEntryp = NULL;
+int V3PreShellImp::s_cacheHits = 0;
+int V3PreShellImp::s_cacheMisses = 0;
 
 //######################################################################
 // Perl class functions
@@ -157,6 +362,12 @@ bool V3PreShell::preproc(FileLine* fl, const string& modname, V3InFilter* filter
 void V3PreShell::preprocInclude(FileLine* fl, const string& modname) {
     V3PreShellImp::s_preImp.preprocInclude(fl, modname);
 }
+int V3PreShell::cacheHits() {
+    return V3PreShellImp::s_cacheHits;
+}
+int V3PreShell::cacheMisses() {
+    return V3PreShellImp::s_cacheMisses;
+}
 void V3PreShell::defineCmdLine(const string& name, const string& value) {
     FileLine* prefl = new FileLine("COMMAND_LINE_DEFINE",0);
     V3PreShellImp::s_preprocp->defineCmdLine(prefl, name, value);
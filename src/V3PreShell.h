@@ -40,6 +40,8 @@ public:
     static string dependFiles() { return ""; }   // Perl only
     static void defineCmdLine(const string& name, const string& value);
     static void undef(const string& name);
+    static int cacheHits();	// --parse-cache statistics
+    static int cacheMisses();
 };
 
 #endif // Guard
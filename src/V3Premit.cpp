@@ -35,10 +35,12 @@
 #include <unistd.h>
 #include <algorithm>
 #include <list>
+#include <vector>
 
 #include "V3Global.h"
 #include "V3Premit.h"
 #include "V3Ast.h"
+#include "V3ThreadPool.h"
 
 //######################################################################
 // Premit state, as a visitor of each AstNode
@@ -49,8 +51,7 @@ private:
     //  AstNodeMath::user()	-> bool.  True if iterated already
     //  AstShiftL::user2()	-> bool.  True if converted to conditional
     //  AstShiftR::user2()	-> bool.  True if converted to conditional
-    AstUser1InUse	m_inuser1;
-    AstUser2InUse	m_inuser2;
+    // The AstUser*InUse are in V3Premit::premitAll, shared by every module's job
 
     // STATE
     AstNodeModule*	m_modp;		// Current module
@@ -306,7 +307,7 @@ private:
 
 public:
     // CONSTUCTORS
-    PremitVisitor(AstNetlist* nodep) {
+    PremitVisitor(AstNodeModule* nodep) {
 	m_modp = NULL;
 	m_funcp = NULL;
 	m_stmtp = NULL;
@@ -320,10 +321,30 @@ public:
 //----------------------------------------------------------------------
 // Top loop
 
+class PremitJob : public V3ThreadJob {
+    // Premit one module; temporaries are only added to the module's own functions
+    AstNodeModule*	m_modp;
+public:
+    explicit PremitJob(AstNodeModule* modp) : m_modp(modp) {}
+    virtual void run() {
+	PremitVisitor visitor (m_modp);
+    }
+};
+
 //######################################################################
 // Premit class functions
 
 void V3Premit::premitAll(AstNetlist* nodep) {
     UINFO(2,__FUNCTION__<<": "<<endl);
-    PremitVisitor visitor (nodep);
+    AstUser1InUse	inuser1;  // For all jobs; a job may not allocate user()s
+    AstUser2InUse	inuser2;
+    // Process each module, in parallel under --build-jobs
+    vector<V3ThreadJob*> jobs;
+    for (AstNodeModule* modp = nodep->modulesp(); modp; modp=modp->nextp()->castNodeModule()) {
+	jobs.push_back(new PremitJob(modp));
+    }
+    V3ThreadPool::runJobs(jobs);
+    for (vector<V3ThreadJob*>::iterator it = jobs.begin(); it != jobs.end(); ++it) {
+	delete *it; *it=NULL;
+    }
 }
@@ -0,0 +1,121 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Store large memories sparsely
+//
+// Code available from: http://www.veripool.org/verilator
+//
+//*************************************************************************
+//
+// Copyright 2003-2013 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+// V3Sparse's Transformations:
+//
+// Each Var:
+//	If a one dimensional unpacked memory marked /*verilator sparse*/
+//	or larger than --sparse-memory, it's a candidate.
+// Each VarRef:
+//	If referencing a candidate other than as the memory of an
+//	ArraySel, ReadMem or TraceInc, the memory must remain a C array.
+// Each candidate var left:
+//	Mark as sparse, for V3EmitC to declare as a VlSparseArray.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+#include <cstdio>
+#include <cstdarg>
+#include <unistd.h>
+
+#include "V3Global.h"
+#include "V3Sparse.h"
+#include "V3Ast.h"
+#include "V3Stats.h"
+
+//######################################################################
+
+class SparseVisitor : public AstNVisitor {
+private:
+    // NODE STATE
+    // Cleared on Netlist
+    //  AstVar::user1()		-> bool.  Set true if must remain a C array
+    AstUser1InUse	m_inuser1;
+
+    // STATE
+    vector<AstVar*>	m_varps;	// Candidate variables
+    V3Double0		m_statSparse;	// Statistic tracking
+
+    // METHODS
+    static int debug() {
+	static int level = -1;
+	if (VL_UNLIKELY(level < 0)) level = v3Global.opt.debugSrcLevel(__FILE__);
+	return level;
+    }
+
+    bool isCandidate(AstVar* varp) {
+	AstUnpackArrayDType* arrayp = varp->dtypeSkipRefp()->castUnpackArrayDType();
+	if (!arrayp) return false;
+	AstBasicDType* basicp = arrayp->subDTypep()->skipRefp()->castBasicDType();
+	if (!basicp || basicp->isOpaque()) return false;  // Multidimensional, strings, reals
+	if (varp->isIO() || varp->isSc() || varp->isStatic() || varp->isParam()
+	    || varp->isSigPublic() || varp->valuep()) return false;
+	if (varp->attrSparse()) return true;
+	double bytes = (double)arrayp->elementsConst() * basicp->widthTotalBytes();
+	return (v3Global.opt.sparseMemory() && bytes >= v3Global.opt.sparseMemory());
+    }
+
+    // VISITORS
+    virtual void visit(AstVar* nodep, AstNUser*) {
+	if (isCandidate(nodep)) m_varps.push_back(nodep);
+    }
+    virtual void visit(AstVarRef* nodep, AstNUser*) {
+	AstNode* backp = nodep->backp();
+	if ((backp->castArraySel() && backp->castArraySel()->fromp() == nodep)
+	    || (backp->castReadMem() && backp->castReadMem()->memp() == nodep)
+	    || (backp->castTraceInc() && backp->castTraceInc()->valuep() == nodep)) {
+	    // Entries are only accessed by index
+	} else {
+	    nodep->varp()->user1(true);
+	}
+    }
+    virtual void visit(AstNode* nodep, AstNUser*) {
+	nodep->iterateChildren(*this);
+    }
+
+public:
+    // CONSTUCTORS
+    SparseVisitor(AstNetlist* nodep) {
+	AstNode::user1ClearTree();
+	nodep->accept(*this);
+	for (vector<AstVar*>::iterator it = m_varps.begin(); it != m_varps.end(); ++it) {
+	    AstVar* varp = *it;
+	    if (varp->user1()) {
+		UINFO(4,"  Not sparse, referenced as whole: "<<varp<<endl);
+	    } else {
+		UINFO(4,"  Sparse: "<<varp<<endl);
+		varp->sparse(true);
+		++m_statSparse;
+	    }
+	}
+    }
+    virtual ~SparseVisitor() {
+	V3Stats::addStat("Optimizations, Sparse memories", m_statSparse);
+    }
+};
+
+//######################################################################
+// Sparse class functions
+
+void V3Sparse::sparseAll(AstNetlist* nodep) {
+    UINFO(2,__FUNCTION__<<": "<<endl);
+    SparseVisitor visitor (nodep);
+}
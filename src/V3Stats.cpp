@@ -47,6 +47,7 @@ private:
     double	m_instrs;		// Current instr count
 
     vector<V3Double0>	m_statTypeCount;	// Nodes of given type
+    vector<V3Double0>	m_statTypeBytes;	// Bytes in nodes of given type
     V3Double0		m_statAbove[AstType::_ENUM_END][AstType::_ENUM_END];	// Nodes of given type
     V3Double0		m_statPred[AstBranchPred::_ENUM_END];	// Nodes of given type
     V3Double0		m_statInstr;		// Instruction count
@@ -62,6 +63,7 @@ private:
 	m_instrs += nodep->instrCount();
 	if (m_counting) {
 	    ++m_statTypeCount[nodep->type()];
+	    m_statTypeBytes[nodep->type()] += nodep->nodeSize();
 	    if (nodep->firstAbovep()) { // Grab only those above, not those "back"
 		++m_statAbove[nodep->firstAbovep()->type()][nodep->type()];
 	    }
@@ -189,6 +191,7 @@ public:
 	m_instrs = 0;
 	// Initialize arrays
 	m_statTypeCount.resize(AstType::_ENUM_END);
+	m_statTypeBytes.resize(AstType::_ENUM_END);
 	// Process
 	nodep->accept(*this);
     }
@@ -215,6 +218,15 @@ public:
 		V3Stats::addStat(m_stage, string("Node count, ")+AstType(type).ascii(), count);
 	    }
 	}
+	for (int type=0; type<AstType::_ENUM_END; type++) {
+	    if (double count = double(m_statTypeBytes.at(type))) {
+		V3Stats::addStat(m_stage, string("Node bytes, ")+AstType(type).ascii(), count);
+	    }
+	}
+	if (!m_fast) {
+	    V3Stats::addStat(m_stage, "Node memory, arena bytes", AstNode::memArenaBytes());
+	    V3Stats::addStat(m_stage, "Node memory, live bytes", AstNode::memLiveBytes());
+	}
 	for (int type=0; type<AstType::_ENUM_END; type++) {
 	    for (int type2=0; type2<AstType::_ENUM_END; type2++) {
 		if (double count = double(m_statAbove[type][type2])) {
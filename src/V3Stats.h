@@ -91,6 +91,11 @@ public:
     static void statsFinalAll(AstNetlist* nodep);
     /// Called by the top level to dump the statistics
     static void statsReport();
+    /// Wall clock seconds, for timing stages
+    static double wallTime();
+    /// Called by the top level around each pass, to time it and measure memory
+    static void statsPassBegin();
+    static void statsPassEnd(const string& name);
 };
 
 
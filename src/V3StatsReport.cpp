@@ -25,22 +25,98 @@
 #include <unistd.h>
 #include <map>
 #include <iomanip>
+#include <fstream>
+#include <sys/time.h>
+#include <sys/resource.h>
 
 #include "V3Global.h"
 #include "V3Stats.h"
 #include "V3Ast.h"
 #include "V3File.h"
 
+//######################################################################
+// Pass timing
+
+class StatsPass {
+    // Resources used by one pass, or the passes between two tree dumps
+public:
+    string	m_name;		// Pass name
+    double	m_start;	// Wall seconds at start, relative to first pass
+    double	m_wall;		// Wall seconds
+    double	m_cpu;		// CPU seconds, all threads
+    double	m_rss;		// Resident bytes at end
+    double	m_rssDelta;	// Change in resident bytes
+    double	m_peakRss;	// Peak resident bytes at end
+    double	m_nodes;	// Live nodes at end
+    StatsPass(const string& name)
+	: m_name(name), m_start(0), m_wall(0), m_cpu(0)
+	, m_rss(0), m_rssDelta(0), m_peakRss(0), m_nodes(0) {}
+};
+
+class StatsPassTimer {
+    // Samples taken at the start of the current pass
+    double	m_origin;	// Wall seconds at first statsPassBegin
+    double	m_wall;		// Wall seconds
+    double	m_cpu;		// CPU seconds
+    double	m_rss;		// Resident bytes
+public:
+    // METHODS
+    static double cpuTime() {
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru)) return 0;
+	return (ru.ru_utime.tv_sec + ru.ru_utime.tv_usec*1.0e-6
+		+ ru.ru_stime.tv_sec + ru.ru_stime.tv_usec*1.0e-6);
+    }
+    static double peakRss() {
+	struct rusage ru;
+	if (getrusage(RUSAGE_SELF, &ru)) return 0;
+#if defined(__APPLE__)
+	return ru.ru_maxrss;		// Bytes
+#else
+	return ru.ru_maxrss * 1024.0;	// Kilobytes
+#endif
+    }
+    static double currentRss() {
+	// Linux only; elsewhere report the peak
+	ifstream is ("/proc/self/statm");
+	double pages = 0, residentPages = 0;
+	if (is>>pages>>residentPages) return residentPages * sysconf(_SC_PAGESIZE);
+	return peakRss();
+    }
+    void begin() {
+	m_wall = V3Stats::wallTime();
+	if (!m_origin) m_origin = m_wall;
+	m_cpu = cpuTime();
+	m_rss = currentRss();
+    }
+    StatsPass end(const string& name) {
+	StatsPass pass (name);
+	if (!m_origin) begin();  // Never began, so empty
+	pass.m_start = m_wall - m_origin;
+	pass.m_wall = V3Stats::wallTime() - m_wall;
+	pass.m_cpu = cpuTime() - m_cpu;
+	pass.m_rss = currentRss();
+	pass.m_rssDelta = pass.m_rss - m_rss;
+	pass.m_peakRss = peakRss();
+	pass.m_nodes = AstNode::memLiveNodes();
+	return pass;
+    }
+    // CONSTRUCTORS
+    StatsPassTimer() : m_origin(0), m_wall(0), m_cpu(0), m_rss(0) {}
+};
+
 //######################################################################
 // Stats dumping
 
 class StatsReport {
     // TYPES
     typedef vector<V3Statistic> StatColl;
+    typedef vector<StatsPass> PassColl;
 
     // STATE
     ofstream&	os;		// Output stream
     static StatColl	s_allStats;	///< All statistics
+    static PassColl	s_passes;	///< Timing of each pass, in order
 
     void header() {
 	os<<"Verilator Statistics Report\n";
@@ -170,11 +246,73 @@ class StatsReport {
 	os<<endl;
     }
 
+    void passes() {
+	if (s_passes.empty()) return;
+	os<<endl;
+	os<<"Pass Statistics:\n";
+	os<<endl;
+
+	size_t maxWidth = strlen("Total");
+	for (PassColl::iterator it = s_passes.begin(); it!=s_passes.end(); ++it) {
+	    if (maxWidth < it->m_name.length()) maxWidth = it->m_name.length();
+	}
+	os<<"  "<<left<<setw(maxWidth)<<"Pass"<<right
+	  <<"  "<<setw(9)<<"Wall ms"<<"  "<<setw(9)<<"CPU ms"
+	  <<"  "<<setw(9)<<"RSS MB"<<"  "<<setw(9)<<"Delta MB"<<"  "<<setw(9)<<"Peak MB"
+	  <<"  "<<setw(9)<<"Nodes"<<endl;
+	os<<"  "<<left<<setw(maxWidth)<<"--------"<<right;
+	for (int col=0; col<6; col++) os<<"  "<<setw(9)<<"-------";
+	os<<endl;
+
+	double wallTotal = 0;
+	double cpuTotal = 0;
+	for (PassColl::iterator it = s_passes.begin(); it!=s_passes.end(); ++it) {
+	    passLine(maxWidth, it->m_name, it->m_wall, it->m_cpu);
+	    os<<fixed<<setprecision(1)
+	      <<"  "<<setw(9)<<it->m_rss/(1024.0*1024.0)
+	      <<"  "<<setw(9)<<it->m_rssDelta/(1024.0*1024.0)
+	      <<"  "<<setw(9)<<it->m_peakRss/(1024.0*1024.0)
+	      <<setprecision(0)<<"  "<<setw(9)<<it->m_nodes<<endl;
+	    wallTotal += it->m_wall;
+	    cpuTotal += it->m_cpu;
+	}
+	passLine(maxWidth, "Total", wallTotal, cpuTotal);
+	os<<endl;
+    }
+    void passLine(size_t width, const string& name, double wall, double cpu) {
+	os<<"  "<<left<<setw(width)<<name<<right<<fixed<<setprecision(0);
+	os<<"  "<<setw(9)<<wall*1000.0<<"  "<<setw(9)<<cpu*1000.0;
+    }
+
 public:
     // METHODS
     static void addStat(const V3Statistic& stat) {
 	s_allStats.push_back(stat);
     }
+    static void addPass(const StatsPass& pass) {
+	s_passes.push_back(pass);
+    }
+    static void traceReport(ofstream* ofp) {
+	// Chrome trace event format, see "Trace Event Format" in the Catapult project
+	ofstream& os = *ofp;
+	os<<"{\"displayTimeUnit\": \"ms\", \"traceEvents\": ["<<endl;
+	os<<fixed<<setprecision(0);
+	for (PassColl::iterator it = s_passes.begin(); it!=s_passes.end(); ++it) {
+	    double startUs = it->m_start*1.0e6;
+	    double endUs = (it->m_start+it->m_wall)*1.0e6;
+	    if (it != s_passes.begin()) os<<","<<endl;
+	    os<<"{\"name\": \""<<it->m_name<<"\", \"cat\": \"pass\", \"ph\": \"X\""
+	      <<", \"pid\": 1, \"tid\": 1, \"ts\": "<<startUs<<", \"dur\": "<<it->m_wall*1.0e6
+	      <<", \"args\": {\"cpu_ms\": "<<it->m_cpu*1000.0<<", \"nodes\": "<<it->m_nodes<<"}},"<<endl;
+	    os<<"{\"name\": \"RSS MB\", \"ph\": \"C\", \"pid\": 1, \"ts\": "<<endUs
+	      <<setprecision(1)
+	      <<", \"args\": {\"rss\": "<<it->m_rss/(1024.0*1024.0)
+	      <<", \"peak\": "<<it->m_peakRss/(1024.0*1024.0)<<"}},"<<endl<<setprecision(0);
+	    os<<"{\"name\": \"Nodes\", \"ph\": \"C\", \"pid\": 1, \"ts\": "<<endUs
+	      <<", \"args\": {\"nodes\": "<<it->m_nodes<<"}}";
+	}
+	os<<endl<<"]}"<<endl;
+    }
 
     // CONSTRUCTORS
     StatsReport(ofstream* aofp)
@@ -183,11 +321,14 @@ public:
 	sumit();
 	stars();
 	stages();
+	passes();
     }
     ~StatsReport() {}
 };
 
 StatsReport::StatColl	StatsReport::s_allStats;
+StatsReport::PassColl	StatsReport::s_passes;
+static StatsPassTimer	s_passTimer;
 
 //######################################################################
 // V3Statstic class
@@ -203,6 +344,12 @@ void V3Stats::addStat(const V3Statistic& stat) {
     StatsReport::addStat(stat);
 }
 
+double V3Stats::wallTime() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec*1.0e-6;
+}
+
 void V3Stats::statsReport() {
     UINFO(2,__FUNCTION__<<": "<<endl);
 
@@ -215,4 +362,22 @@ void V3Stats::statsReport() {
 
     // Cleanup
     ofp->close(); delete ofp; ofp = NULL;
+
+    if (v3Global.opt.statsTrace()) {
+	string tracename = v3Global.opt.makeDir()+"/"+v3Global.opt.prefix()+"__stats_trace.json";
+	ofstream* tofp (V3File::new_ofstream(tracename));
+	if (tofp->fail()) v3fatalSrc("Can't write "<<tracename);
+	StatsReport::traceReport(tofp);
+	tofp->close(); delete tofp; tofp = NULL;
+    }
+}
+
+void V3Stats::statsPassBegin() {
+    if (!v3Global.opt.stats()) return;
+    s_passTimer.begin();
+}
+
+void V3Stats::statsPassEnd(const string& name) {
+    if (!v3Global.opt.stats()) return;
+    StatsReport::addPass(s_passTimer.end(name));
 }
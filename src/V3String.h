@@ -24,6 +24,8 @@
 #include "config_build.h"
 #include "verilatedos.h"
 #include <string>
+#include <vector>
+#include <cstring>
 
 //######################################################################
 // VString - String manipulation
@@ -86,6 +88,84 @@ public:
     VHashFnv& hash(int n) { hashC((vluint64_t)n); return *this; }
 };
 
+//######################################################################
+// VCStrHash - Hash index keyed by const char*'s
+//
+//	Used beside an ordered map so name lookups are O(name length) while
+//	iteration stays sorted.  Same scheme as VerilatedCStrHash; open
+//	addressing with tombstones, load kept under 3/4.  Keys are not
+//	copied; the caller must keep each key's storage alive until erased.
+
+template <class T> class VCStrHash {
+    struct Entry {
+	const char*	m_keyp;		// Key, NULL if empty or erased
+	vluint64_t	m_hash;		// Hash of key
+	bool		m_erased;	// Tombstone
+	T		m_value;
+	Entry() : m_keyp(NULL), m_hash(0), m_erased(false), m_value() {}
+    };
+    vector<Entry>	m_table;	// Open addressed, size power of two
+    size_t		m_used;		// Entries in use, including tombstones
+
+    const Entry* findEntry(const char* keyp, vluint64_t h) const {
+	if (VL_UNLIKELY(m_table.empty())) return NULL;
+	size_t mask = m_table.size()-1;
+	for (size_t i=h & mask; ; i=(i+1) & mask) {
+	    const Entry& ent = m_table[i];
+	    if (!ent.m_keyp) {
+		if (!ent.m_erased) return NULL;
+	    } else if (ent.m_hash==h && 0==strcmp(ent.m_keyp, keyp)) {
+		return &ent;
+	    }
+	}
+    }
+    void rehash(size_t size) {
+	vector<Entry> old;
+	old.swap(m_table);
+	m_table.resize(size);
+	m_used = 0;
+	for (typename vector<Entry>::iterator it=old.begin(); it!=old.end(); ++it) {
+	    if (it->m_keyp) insertNew(it->m_keyp, it->m_hash, it->m_value);
+	}
+    }
+    void insertNew(const char* keyp, vluint64_t h, const T& value) {
+	size_t mask = m_table.size()-1;
+	size_t i = h & mask;
+	while (m_table[i].m_keyp || m_table[i].m_erased) i=(i+1) & mask;
+	m_table[i].m_keyp = keyp;
+	m_table[i].m_hash = h;
+	m_table[i].m_value = value;
+	++m_used;
+    }
+public:
+    VCStrHash() : m_used(0) {}
+    ~VCStrHash() {}
+    // METHODS
+    void insert(const char* keyp, const T& value) {  // Insert, or replace existing key's value
+	vluint64_t h = VHashFnv().hash(keyp).value();
+	if (Entry* entp = const_cast<Entry*>(findEntry(keyp, h))) {
+	    entp->m_value = value;
+	    return;
+	}
+	if ((m_used+1)*4 >= m_table.size()*3) {  // Keep load under 3/4
+	    rehash(m_table.empty() ? 64 : m_table.size()*2);
+	}
+	insertNew(keyp, h, value);
+    }
+    const T* find(const char* keyp) const {  // Pointer to value, or NULL if not found
+	const Entry* entp = findEntry(keyp, VHashFnv().hash(keyp).value());
+	return entp ? &(entp->m_value) : NULL;
+    }
+    void erase(const char* keyp) {
+	if (Entry* entp = const_cast<Entry*>(findEntry(keyp, VHashFnv().hash(keyp).value()))) {
+	    entp->m_keyp = NULL;
+	    entp->m_erased = true;
+	    entp->m_value = T();
+	}
+    }
+    void clear() { m_table.clear(); m_used = 0; }
+};
+
 //######################################################################
 
 #endif // guard
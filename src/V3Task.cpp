@@ -109,8 +109,10 @@ private:
 
     // TYPES
     typedef std::map<pair<AstScope*,AstVar*>,AstVarScope*> VarToScopeMap;
+    typedef std::map<string,int> DpiExportCounts;
     // MEMBERS
     VarToScopeMap	m_varToScopeMap;	// Map for Var -> VarScope mappings
+    DpiExportCounts	m_dpiExportCounts;	// Number of scopes exporting each DPI cname
     AstAssignW*		m_assignwp;		// Current assignment
     V3Graph		m_callGraph;		// Task call graph
     TaskBaseVertex*	m_curVxp;		// Current vertex we're adding to
@@ -136,6 +138,10 @@ public:
     void ftaskCFuncp(AstNodeFTask* nodep, AstCFunc* cfuncp) {
 	getFTaskVertex(nodep)->cFuncp(cfuncp);
     }
+    int dpiExportCount(const string& cname) const {
+	DpiExportCounts::const_iterator it = m_dpiExportCounts.find(cname);
+	return (it == m_dpiExportCounts.end()) ? 0 : it->second;
+    }
 
     void checkPurity(AstNodeFTask* nodep) {
 	checkPurity(nodep, getFTaskVertex(nodep));
@@ -201,6 +207,7 @@ private:
 	TaskBaseVertex* lastVxp = m_curVxp;
 	m_curVxp = getFTaskVertex(nodep);
 	if (nodep->dpiImport()) m_curVxp->noInline(true);
+	if (nodep->dpiExport() && nodep->user3p()) m_dpiExportCounts[nodep->cname()]++;
 	nodep->iterateChildren(*this);
 	m_curVxp = lastVxp;
     }
@@ -474,6 +481,7 @@ private:
 	AstCCall* ccallp = new AstCCall(refp->fileline(), cfuncp, NULL);
 	beginp->addNext(ccallp);
 	// Convert complicated outputs to temp signals
+	map<AstNode*,AstVar*> openArgs;	// Arg for each open array, which also passes the array bounds
 
 	V3TaskConnects tconnects = V3Task::taskConnects(refp, refp->taskp()->stmtsp());
 	for (V3TaskConnects::iterator it=tconnects.begin(); it!=tconnects.end(); ++it) {
@@ -487,6 +495,11 @@ private:
 		if ((portp->isInout()||portp->isOutput()) && pinp->castConst()) {
 		    pinp->v3error("Function/task output connected to constant instead of variable: "+portp->prettyName());
 		}
+		else if (portp->isDpiOpenArray()) {
+		    // Connect to this exact array; the callee accesses its storage directly
+		    if (portp->isOutput()) V3LinkLValue::linkLValueSet(pinp);
+		    openArgs.insert(make_pair(it->second, portp));
+		}
 		else if (portp->isInout()) {
 		    if (pinp->castVarRef()) {
 			// Connect to this exact variable
@@ -538,6 +551,13 @@ private:
 	    AstNode* exprp = pinp->castArg()->exprp();
 	    exprp->unlinkFrBack();
 	    ccallp->addArgsp(exprp);
+	    if (openArgs.find(pinp) != openArgs.end()) {
+		// __Vleft, __Vright; V3Width checked it's an unpacked array
+		VNumRange range = exprp->castVarRef()->varp()->dtypeSkipRefp()->castUnpackArrayDType()->declRange();
+		// Sized, as widths are already final; the wrapper's int arguments restore the sign
+		ccallp->addArgsp(new AstConst(exprp->fileline(), (uint32_t)range.left()));
+		ccallp->addArgsp(new AstConst(exprp->fileline(), (uint32_t)range.right()));
+	    }
 	}
 
 	if (outvscp) {
@@ -644,8 +664,12 @@ private:
 	return newp;
     }
 
-    AstCFunc* makeDpiExportWrapper(AstNodeFTask* nodep, AstVar* rtnvarp) {
+    AstCFunc* makeDpiExportWrapper(AstNodeFTask* nodep, AstVar* rtnvarp, AstCFunc* cfuncp) {
 	string dpiproto = dpiprotoName(nodep,rtnvarp);
+	// With a single exporting scope there is only one function to call,
+	// so there is no need to look it up through the scope's export table
+	bool direct = (v3Global.opt.dpiStaticDispatch()
+		       && m_statep->dpiExportCount(nodep->cname()) == 1);
 
 	AstCFunc* dpip = new AstCFunc(nodep->fileline(),
 				      nodep->cname(),
@@ -659,7 +683,16 @@ private:
 	// Add DPI reference to top, since it's a global function
 	m_topScopep->scopep()->addActivep(dpip);
 
-	{// Create dispatch wrapper
+	if (direct) {
+	    string stmt;
+	    stmt += "const VerilatedScope* __Vscopep = Verilated::dpiScope();\n";
+	    // Without a scope there's no model to call into; exportFind reports the error
+	    stmt += "if (VL_UNLIKELY(!__Vscopep)) __Vscopep->exportFind(Verilated::exportFuncNum(\""+nodep->cname()+"\"));\n";
+	    stmt += EmitCBaseVisitor::symClassName()+"* __restrict vlSymsp = ("
+		+EmitCBaseVisitor::symClassName()+"*)(__Vscopep->symsp());\n";  // Upcast w/o overhead
+	    stmt += EmitCBaseVisitor::symTopAssign()+"\n";
+	    dpip->addStmtsp(new AstCStmt(nodep->fileline(), stmt));
+	} else {// Create dispatch wrapper
 	    // Note this function may dispatch to myfunc on a different class.
 	    // Thus we need to be careful not to assume a particular function layout.
 	    //
@@ -683,14 +716,14 @@ private:
 
 	// Convert input/inout DPI arguments to Internal types
 	string args;
-	args += "("+v3Global.opt.prefix()+"__Syms*)(__Vscopep->symsp())";  // Upcast w/o overhead
+	if (!direct) args += "("+v3Global.opt.prefix()+"__Syms*)(__Vscopep->symsp())";  // Upcast w/o overhead
 	AstNode* argnodesp = NULL;
 	for (AstNode* stmtp = nodep->stmtsp(); stmtp; stmtp=stmtp->nextp()) {
 	    if (AstVar* portp = stmtp->castVar()) {
 		if (portp->isIO() && !portp->isFuncReturn() && portp != rtnvarp) {
 		    // No createDpiTemp; we make a real internal variable instead
 		    // SAME CODE BELOW
-		    args+= ", ";
+		    if (!direct) args+= ", ";
 		    if (args != "") { argnodesp = argnodesp->addNext(new AstText(portp->fileline(), args, true)); args=""; }
 		    AstVarScope* outvscp = createFuncVar (dpip, portp->name()+"__Vcvt", portp);
 		    AstVarRef* refp = new AstVarRef(portp->fileline(), outvscp, portp->isOutput());
@@ -706,14 +739,18 @@ private:
 	if (rtnvarp) {
 	    AstVar* portp = rtnvarp;
 	    // SAME CODE ABOVE
-	    args+= ", ";
+	    if (!direct) args+= ", ";
 	    if (args != "") { argnodesp = argnodesp->addNext(new AstText(portp->fileline(), args, true)); args=""; }
 	    AstVarScope* outvscp = createFuncVar (dpip, portp->name()+"__Vcvt", portp);
 	    AstVarRef* refp = new AstVarRef(portp->fileline(), outvscp, portp->isOutput());
 	    argnodesp = argnodesp->addNextNull(refp);
 	}
 
-	{// Call the user function
+	if (direct) {
+	    AstCCall* callp = new AstCCall(nodep->fileline(), cfuncp, argnodesp); argnodesp=NULL;
+	    callp->argTypes("vlSymsp");
+	    dpip->addStmtsp(callp);
+	} else {// Call the user function
 	    // Add the variables referenced as VarRef's so that lifetime analysis
 	    // doesn't rip up the variables on us
 	    string stmt;
@@ -778,6 +815,19 @@ private:
 		    bool bitvec = (portp->basicp()->isBitLogic() && portp->width() > 32);
 
 		    if (args != "") { args+= ", "; }
+		    if (portp->isDpiOpenArray()) {
+			// Describe the caller's array, which the callee then reads or writes in place
+			AstVar* leftp = portp->nextp()->castVar();  // Bounds directly follow, see makeUserFunc
+			AstVar* rightp = leftp ? leftp->nextp()->castVar() : NULL;
+			if (!rightp) portp->v3fatalSrc("Open array argument without bounds");
+			string stmt = ("VerilatedDpiOpenVar "+portp->name()+"__Vcvt ("+portp->name()
+				       +", "+leftp->name()+", "+rightp->name()
+				       +", "+cvtToStr(portp->width())+");\n");
+			cfuncp->addStmtsp(new AstCStmt(portp->fileline(), stmt));
+			args += "&"+portp->name()+"__Vcvt";
+			stmtp = rightp;
+			continue;
+		    }
 		    if (bitvec) {}
 		    else if (portp->isOutput()) args += "&";
 		    else if (portp->basicp() && portp->basicp()->isBitLogic() && portp->width() != 1) args += "&";  // it's a svBitVecVal
@@ -810,7 +860,8 @@ private:
 	// Convert output/inout arguments back to internal type
 	for (AstNode* stmtp = cfuncp->argsp(); stmtp; stmtp=stmtp->nextp()) {
 	    if (AstVar* portp = stmtp->castVar()) {
-		if (portp->isIO() && (portp->isOutput() || portp->isFuncReturn())) {
+		if (portp->isIO() && (portp->isOutput() || portp->isFuncReturn())
+		    && !portp->isDpiOpenArray()) {  // Written in place
 		    AstVarScope* portvscp = portp->user2p()->castNode()->castVarScope();  // Remembered when we created it earlier
 		    cfuncp->addStmtsp(createAssignDpiToInternal(portvscp,portp->name()+"__Vcvt",true));
 		}
@@ -908,7 +959,7 @@ private:
 		if (nodep->dpiImport()) {
 		    dpip = makeDpiImportWrapper(nodep, rtnvarp);
 		} else if (nodep->dpiExport()) {
-		    dpip = makeDpiExportWrapper(nodep, rtnvarp);
+		    dpip = makeDpiExportWrapper(nodep, rtnvarp, cfuncp);
 		    cfuncp->addInitsp(new AstComment(dpip->fileline(), (string)("Function called from: ")+dpip->cname()));
 		}
 
@@ -937,6 +988,11 @@ private:
 					   <<portp->warnMore()<<"... For best portability, use bit, byte, int, or longint");
 			}
 		    }
+		    if (portp->isDpiOpenArray()) {
+			// The wrapper is shared by every call, so each passes its array's bounds after the array
+			createInputVar(cfuncp, portp->name()+"__Vleft", AstBasicDTypeKwd::INT);
+			createInputVar(cfuncp, portp->name()+"__Vright", AstBasicDTypeKwd::INT);
+		    }
 		} else {
 		    // "Normal" variable, mark inside function
 		    portp->funcLocal(true);
@@ -0,0 +1,112 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Run independent jobs on worker threads
+//
+// Code available from: http://www.veripool.org/verilator
+//
+//*************************************************************************
+//
+// Copyright 2003-2013 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+// V3ThreadPool:
+//	Each worker, including the calling thread, takes the next job
+//	index in turn and runs it with V3Error holding its messages.
+//	After all workers join, the held messages are reported in job
+//	order.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+
+#include "V3Global.h"
+#include "V3ThreadPool.h"
+
+bool V3ThreadPool::s_running = false;
+
+//######################################################################
+
+class ThreadPoolWork {
+    // State shared by the workers of one V3ThreadPool::runJobs call
+    const vector<V3ThreadJob*>&	m_jobs;		// Jobs to run
+    vector<V3ErrorJobMsgs>	m_msgs;		// Messages held by each job
+    size_t			m_nextJob;	// Next job index to start
+    V3Mutex			m_mutex;	// Protects m_nextJob
+public:
+    // METHODS
+    void work() {
+	while (true) {
+	    size_t job;
+	    {
+		V3LockGuard lock (m_mutex);
+		job = m_nextJob++;
+	    }
+	    if (job >= m_jobs.size()) break;
+	    V3Error::jobMsgsp(&m_msgs[job]);
+	    m_jobs[job]->run();
+	    V3Error::jobMsgsp(NULL);
+	}
+    }
+    static void* workThread(void* workp) {
+	static_cast<ThreadPoolWork*>(workp)->work();
+	return NULL;
+    }
+    void replay() {
+	for (size_t job=0; job<m_msgs.size(); ++job) {
+	    V3Error::jobReplay(m_msgs[job]);
+	}
+    }
+    // CONSTRUCTORS
+    ThreadPoolWork(const vector<V3ThreadJob*>& jobs)
+	: m_jobs(jobs), m_msgs(jobs.size()), m_nextJob(0) {}
+    ~ThreadPoolWork() {}
+};
+
+//######################################################################
+// ThreadPool class functions
+
+void V3ThreadPool::runJobs(const vector<V3ThreadJob*>& jobs) {
+    UASSERT(!s_running, "V3ThreadPool::runJobs called from a job");
+    size_t threads = v3Global.opt.buildJobs();
+    if (threads > jobs.size()) threads = jobs.size();
+    if (threads <= 1) {
+	// Same as before threads existed; no buffering needed
+	for (vector<V3ThreadJob*>::const_iterator it = jobs.begin(); it != jobs.end(); ++it) {
+	    (*it)->run();
+	}
+	return;
+    }
+    UINFO(4,"  Running "<<jobs.size()<<" jobs on "<<threads<<" threads"<<endl);
+    ThreadPoolWork work (jobs);
+    s_running = true;
+    // The calling thread is one of the workers
+    vector<pthread_t> workers;
+    for (size_t t=1; t<threads; ++t) {
+	pthread_t thread;
+	int err = pthread_create(&thread, NULL, &ThreadPoolWork::workThread, &work);
+	if (err) {
+	    // Fewer threads than requested; the remaining workers absorb the jobs
+	    UINFO(1,"  pthread_create failed: "<<strerror(err)<<endl);
+	    break;
+	}
+	workers.push_back(thread);
+    }
+    work.work();
+    for (vector<pthread_t>::iterator it = workers.begin(); it != workers.end(); ++it) {
+	pthread_join(*it, NULL);
+    }
+    s_running = false;
+    work.replay();
+}
@@ -0,0 +1,86 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Run independent jobs on worker threads
+//
+// Code available from: http://www.veripool.org/verilator
+//
+//*************************************************************************
+//
+// Copyright 2003-2013 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#ifndef _V3THREADPOOL_H_
+#define _V3THREADPOOL_H_ 1
+#include "config_build.h"
+#include "verilatedos.h"
+#include <vector>
+#include <pthread.h>
+#include "V3Error.h"
+
+//============================================================================
+
+// Storage class for state that each V3ThreadPool worker keeps its own copy of
+#define V3THREAD_LOCAL __thread
+
+class V3Mutex {
+    // Mutex for state that V3ThreadJobs share
+    pthread_mutex_t	m_mutex;
+public:
+    V3Mutex() { pthread_mutex_init(&m_mutex, NULL); }
+    ~V3Mutex() { pthread_mutex_destroy(&m_mutex); }
+    void lock() { pthread_mutex_lock(&m_mutex); }
+    void unlock() { pthread_mutex_unlock(&m_mutex); }
+};
+
+class V3LockGuard {
+    // Hold a V3Mutex for the guard's scope
+    V3Mutex&	m_mutex;
+public:
+    explicit V3LockGuard(V3Mutex& mutex) : m_mutex(mutex) { m_mutex.lock(); }
+    ~V3LockGuard() { m_mutex.unlock(); }
+};
+
+class V3ThreadJob {
+    // One unit of work for V3ThreadPool, typically covering a single module
+public:
+    virtual ~V3ThreadJob() {}
+    virtual void run() = 0;
+};
+
+class V3ThreadPool {
+    static bool	s_running;	// Jobs are executing on worker threads
+public:
+    // Run every job, on up to --build-jobs threads, returning when all are done.
+    // Messages reported by a job are held and printed in job order afterwards,
+    // so output does not depend on the number of threads.
+    // Jobs may create, delete and relink nodes under the part of the netlist
+    // they were given, and read the rest.  They must not use AstUser*InUse or
+    // clear user()s, so the caller holds any user()s the jobs need, nor add
+    // V3Stats, so the caller totals them once the jobs finish.
+    static void runJobs(const vector<V3ThreadJob*>& jobs);
+    static bool running() { return s_running; }
+};
+
+class V3JobLockGuard {
+    // Hold a V3Mutex for the guard's scope, but only while V3ThreadPool jobs
+    // are running, so single threaded callers don't pay for the lock
+    V3Mutex&	m_mutex;
+    bool	m_locked;
+public:
+    explicit V3JobLockGuard(V3Mutex& mutex)
+	: m_mutex(mutex), m_locked(V3ThreadPool::running()) {
+	if (m_locked) m_mutex.lock();
+    }
+    ~V3JobLockGuard() { if (m_locked) m_mutex.unlock(); }
+};
+
+#endif // Guard
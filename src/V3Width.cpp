@@ -112,12 +112,14 @@ ostream& operator<<(ostream& str, const WidthVP* vup) {
 
 //######################################################################
 
-class WidthVisitor : public AstNVisitor {
+class WidthVisitor : public AstNVisitorStatic<WidthVisitor> {
+    friend class AstNVisitorStatic<WidthVisitor>;
 private:
     // STATE
     bool	m_paramsOnly;	// Computing parameter value; limit operation
     AstRange*	m_cellRangep;	// Range for arrayed instantiations, NULL for normal instantiations
     AstFunc*	m_funcp;	// Current function
+    AstNodeFTask* m_ftaskp;	// Current function/task
     AstInitial*	m_initialp;	// Current initial block
     AstAttrOf*	m_attrp;	// Current attribute
     bool	m_doGenerate;	// Do errors later inside generate statement
@@ -266,11 +268,11 @@ private:
 	// Real: Output real if either expression is real, signed if both signed
 	if (vup->c()->prelim()) {  // First stage evaluation
 	    // Just once, do the conditional, expect one bit out.
-	    nodep->condp()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
+	    iterateAndNext(nodep->condp(), WidthVP(1,1,BOTH).p());
 	    spliceCvtCmpD0(nodep->condp()); // auto-compares with zero
 	    // Determine sub expression widths only relying on what's in the subops
-	    nodep->expr1p()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
-	    nodep->expr2p()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->expr1p(), WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->expr2p(), WidthVP(ANYSIZE,0,PRELIM).p());
 	}
 	// Calculate width of this expression.
 	// First call (prelim()) vup->c()->width() is probably zero, so we'll return
@@ -292,8 +294,8 @@ private:
 	    // Final width known, so make sure children recompute & check their sizes
 	    int width  = nodep->width();
 	    int mwidth = nodep->widthMin();
-	    nodep->expr1p()->iterateAndNext(*this,WidthVP(width,mwidth,FINAL).p());
-	    nodep->expr2p()->iterateAndNext(*this,WidthVP(width,mwidth,FINAL).p());
+	    iterateAndNext(nodep->expr1p(), WidthVP(width,mwidth,FINAL).p());
+	    iterateAndNext(nodep->expr2p(), WidthVP(width,mwidth,FINAL).p());
 	    // Error report and change sizes for suboperands of this node.
 	    widthCheckReduce(nodep,"Conditional Test",nodep->condp());
 	    widthCheck(nodep,"Conditional True",nodep->expr1p(),width,mwidth);
@@ -304,8 +306,8 @@ private:
 	// Real: Not allowed
 	// Signed: unsigned output, input either
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->lhsp());
 	    checkCvtUS(nodep->rhsp());
 	    nodep->dtypeSetLogicSized(nodep->lhsp()->width() + nodep->rhsp()->width(),
@@ -337,8 +339,8 @@ private:
     }
     virtual void visit(AstReplicate* nodep, AstNUser* vup) {
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->lhsp());
 	    checkCvtUS(nodep->rhsp());
 	    V3Const::constifyParamsEdit(nodep->rhsp()); // rhsp may change
@@ -380,8 +382,8 @@ private:
 	    nodep->msbp()->swapWith(nodep->lsbp());
 	}
 	if (vup->c()->prelim()) {
-	    nodep->msbp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	    nodep->lsbp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->msbp(), WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lsbp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->msbp());
 	    checkCvtUS(nodep->lsbp());
 	    int width = nodep->elementsConst();
@@ -398,9 +400,9 @@ private:
 	if (nodep->didWidth()) return;
 	if (vup->c()->prelim()) {
 	    if (debug()>=9) nodep->dumpTree(cout,"-selWidth: ");
-	    nodep->fromp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
-	    nodep->lsbp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
-	    nodep->widthp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->fromp(), WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->lsbp(), WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->widthp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->fromp());
 	    checkCvtUS(nodep->lsbp());
 	    checkCvtUS(nodep->widthp());
@@ -442,8 +444,8 @@ private:
 		//nodep->v3fatalSrc("Should have been declRanged in V3WidthSel");
 	    }
 	    int selwidth = V3Number::log2b(frommsb+1-1)+1;	// Width to address a bit
-	    nodep->fromp()->iterateAndNext(*this,WidthVP(selwidth,selwidth,FINAL).p());
-	    nodep->lsbp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,FINAL).p());
+	    iterateAndNext(nodep->fromp(), WidthVP(selwidth,selwidth,FINAL).p());
+	    iterateAndNext(nodep->lsbp(), WidthVP(ANYSIZE,0,FINAL).p());
 	    if (widthBad(nodep->lsbp(),selwidth,selwidth)
 		&& nodep->lsbp()->width()!=32) {
 		if (!nodep->fileline()->warnIsOff(V3ErrorCode::WIDTH)) {
@@ -490,10 +492,10 @@ private:
 	// Signed/Real: Output signed iff LHS signed/real; binary operator
 	// Note by contrast, bit extract selects are unsigned
 	if (vup->c()->prelim()) {
-	    nodep->bitp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->bitp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->bitp());
 	    //
-	    nodep->fromp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->fromp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	    //
 	    int frommsb;
 	    int fromlsb;
@@ -513,7 +515,7 @@ private:
 		frommsb = fromlsb = 0;
 	    }
 	    int selwidth = V3Number::log2b(frommsb+1-1)+1;	// Width to address a bit
-	    nodep->fromp()->iterateAndNext(*this,WidthVP(selwidth,selwidth,FINAL).p());
+	    iterateAndNext(nodep->fromp(), WidthVP(selwidth,selwidth,FINAL).p());
 	    if (widthBad(nodep->bitp(),selwidth,selwidth)
 		&& nodep->bitp()->width()!=32) {
 		nodep->v3warn(WIDTH,"Bit extraction of array["<<frommsb<<":"<<fromlsb<<"] requires "
@@ -533,36 +535,36 @@ private:
 
     virtual void visit(AstSelBit* nodep, AstNUser* vup) {
 	// Just a quick check as after V3Param these nodes instead are AstSel's
-	nodep->fromp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->rhsp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->thsp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->attrp()->iterateAndNext(*this,WidthVP(0,0,FINAL).p());
-	AstNode* selp = V3Width::widthSelNoIterEdit(nodep); if (selp!=nodep) { nodep=NULL; selp->iterate(*this,vup); return; }
+	iterateAndNext(nodep->fromp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->rhsp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->thsp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->attrp(), WidthVP(0,0,FINAL).p());
+	AstNode* selp = V3Width::widthSelNoIterEdit(nodep); if (selp!=nodep) { nodep=NULL; accept(selp, vup); return; }
 	nodep->v3fatalSrc("AstSelBit should disappear after widthSel");
     }
     virtual void visit(AstSelExtract* nodep, AstNUser* vup) {
 	// Just a quick check as after V3Param these nodes instead are AstSel's
-	nodep->fromp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->rhsp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->thsp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->attrp()->iterateAndNext(*this,WidthVP(0,0,FINAL).p());
-	AstNode* selp = V3Width::widthSelNoIterEdit(nodep); if (selp!=nodep) { nodep=NULL; selp->iterate(*this,vup); return; }
+	iterateAndNext(nodep->fromp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->rhsp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->thsp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->attrp(), WidthVP(0,0,FINAL).p());
+	AstNode* selp = V3Width::widthSelNoIterEdit(nodep); if (selp!=nodep) { nodep=NULL; accept(selp, vup); return; }
 	nodep->v3fatalSrc("AstSelExtract should disappear after widthSel");
     }
     virtual void visit(AstSelPlus* nodep, AstNUser* vup) {
-	nodep->fromp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->rhsp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->thsp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->attrp()->iterateAndNext(*this,WidthVP(0,0,FINAL).p());
-	AstNode* selp = V3Width::widthSelNoIterEdit(nodep); if (selp!=nodep) { nodep=NULL; selp->iterate(*this,vup); return; }
+	iterateAndNext(nodep->fromp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->rhsp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->thsp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->attrp(), WidthVP(0,0,FINAL).p());
+	AstNode* selp = V3Width::widthSelNoIterEdit(nodep); if (selp!=nodep) { nodep=NULL; accept(selp, vup); return; }
 	nodep->v3fatalSrc("AstSelPlus should disappear after widthSel");
     }
     virtual void visit(AstSelMinus* nodep, AstNUser* vup) {
-	nodep->fromp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->rhsp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->thsp()->iterateAndNext(*this,WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
-	nodep->attrp()->iterateAndNext(*this,WidthVP(0,0,FINAL).p());
-	AstNode* selp = V3Width::widthSelNoIterEdit(nodep); if (selp!=nodep) { nodep=NULL; selp->iterate(*this,vup); return; }
+	iterateAndNext(nodep->fromp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->rhsp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->thsp(), WidthVP(0,0,PRELIM).p()); //FINAL in AstSel
+	iterateAndNext(nodep->attrp(), WidthVP(0,0,FINAL).p());
+	AstNode* selp = V3Width::widthSelNoIterEdit(nodep); if (selp!=nodep) { nodep=NULL; accept(selp, vup); return; }
 	nodep->v3fatalSrc("AstSelMinus should disappear after widthSel");
     }
 
@@ -604,11 +606,11 @@ private:
 	    if (nodep->width()>64) nodep->v3error("Unsupported: $c can't generate wider than 64 bits");
 	}
 	// Just let all arguments seek their natural sizes
-	nodep->iterateChildren(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateChildren(nodep, WidthVP(ANYSIZE,0,BOTH).p());
     }
     virtual void visit(AstCLog2* nodep, AstNUser* vup) {
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->lhsp());
 	    nodep->dtypeSetSigned32();
 	}
@@ -640,7 +642,7 @@ private:
     }
     virtual void visit(AstCountOnes* nodep, AstNUser* vup) {
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->lhsp());
 	    // If it's a 32 bit number, we need a 6 bit number as we need to return '32'.
 	    int selwidth = V3Number::log2b(nodep->lhsp()->width())+1;
@@ -649,12 +651,12 @@ private:
     }
     virtual void visit(AstCvtPackString* nodep, AstNUser* vup) {
 	// Opaque returns, so arbitrary
-	nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
     }
     virtual void visit(AstAttrOf* nodep, AstNUser*) {
 	AstAttrOf* oldAttr = m_attrp;
 	m_attrp = nodep;
-	nodep->fromp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->fromp(), WidthVP(ANYSIZE,0,BOTH).p());
 	// Don't iterate children, don't want to lose VarRef.
 	if (nodep->attrType()==AstAttrType::VAR_BASE) {
 	    // Soon to be handled in V3LinkWidth SEL generation, under attrp() and newSubLsbOf
@@ -709,7 +711,7 @@ private:
 	// Iterate into subDTypep() to resolve that type and update pointer.
 	nodep->refDTypep(iterateEditDTypep(nodep, nodep->subDTypep()));
 	// Cleanup array size
-	nodep->rangep()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->rangep(), WidthVP(ANYSIZE,0,BOTH).p());
 	nodep->dtypep(nodep);  // The array itself, not subDtype
 	if (nodep->castUnpackArrayDType()) {
 	    // Historically array elements have width of the ref type not the full array
@@ -720,11 +722,20 @@ private:
 	}
 	UINFO(4,"dtWidthed "<<nodep<<endl);
     }
+    virtual void visit(AstUnsizedArrayDType* nodep, AstNUser*) {
+	if (nodep->didWidthAndSet()) return;  // This node is a dtype & not both PRELIMed+FINALed
+	if (nodep->childDTypep()) nodep->refDTypep(moveChildDTypeEdit(nodep));
+	// Iterate into subDTypep() to resolve that type and update pointer.
+	nodep->refDTypep(iterateEditDTypep(nodep, nodep->subDTypep()));
+	nodep->dtypep(nodep);  // The array itself, not subDtype
+	nodep->widthFromSub(nodep->subDTypep());
+	UINFO(4,"dtWidthed "<<nodep<<endl);
+    }
     virtual void visit(AstBasicDType* nodep, AstNUser*) {
 	if (nodep->didWidthAndSet()) return;  // This node is a dtype & not both PRELIMed+FINALed
 	if (nodep->generic()) return;  // Already perfect
 	if (nodep->rangep()) {
-	    nodep->rangep()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->rangep(), WidthVP(ANYSIZE,0,BOTH).p());
 	    // Because this DType has a unique child range, we know it's not pointed at by
 	    // other nodes unless they are referencing this type.  Furthermore the width()
 	    // calculation would return identical values.  Therefore we can directly replace the width
@@ -749,14 +760,14 @@ private:
 	if (nodep->childDTypep()) nodep->refDTypep(moveChildDTypeEdit(nodep));
 	// Iterate into subDTypep() to resolve that type and update pointer.
 	nodep->refDTypep(iterateEditDTypep(nodep, nodep->subDTypep()));
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	nodep->dtypep(nodep);  // Should already be set, but be clear it's not the subDType
 	nodep->widthFromSub(nodep->subDTypep());
 	UINFO(4,"dtWidthed "<<nodep<<endl);
     }
     virtual void visit(AstRefDType* nodep, AstNUser*) {
 	if (nodep->didWidthAndSet()) return;  // This node is a dtype & not both PRELIMed+FINALed
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	if (nodep->subDTypep()) nodep->refDTypep(iterateEditDTypep(nodep, nodep->subDTypep()));
 	nodep->dtypeFrom(nodep->dtypeSkipRefp());
 	nodep->widthFromSub(nodep->subDTypep());
@@ -765,14 +776,14 @@ private:
     virtual void visit(AstTypedef* nodep, AstNUser*) {
 	if (nodep->didWidthAndSet()) return;  // This node is a dtype & not both PRELIMed+FINALed
 	if (nodep->childDTypep()) nodep->dtypep(moveChildDTypeEdit(nodep));
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	nodep->dtypep(iterateEditDTypep(nodep, nodep->subDTypep()));
     }
     virtual void visit(AstCast* nodep, AstNUser* vup) {
 	if (nodep->childDTypep()) nodep->dtypep(moveChildDTypeEdit(nodep));
 	nodep->dtypep(iterateEditDTypep(nodep, nodep->dtypep()));
 	//if (debug()) nodep->dumpTree(cout,"  CastPre: ");
-	nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	// When more general casts are supported, the cast elimination will be done later.
 	// For now, replace it ASAP, so widthing can propagate easily
 	// The cast may change signing, but we don't know the sign yet.  Make it so.
@@ -810,7 +821,7 @@ private:
 	//if (debug()) nodep->dumpTree(cout,"  CastPre: ");
 	int width = nodep->rhsp()->castConst()->toSInt();
 	if (width < 1) { nodep->v3error("Size-changing cast to zero or negative size"); width=1; }
-	nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	AstBasicDType* underDtp = nodep->lhsp()->dtypep()->castBasicDType();
 	if (!underDtp) {
 	    nodep->v3error("Unsupported: Size-changing cast on non-basic data type");
@@ -849,9 +860,14 @@ private:
 	if (!nodep->dtypep()) nodep->v3fatalSrc("No dtype determined for var");
 	if (nodep->isIO() && !(nodep->dtypeSkipRefp()->castBasicDType()
 			       || nodep->dtypeSkipRefp()->castNodeArrayDType()
+			       || nodep->dtypeSkipRefp()->castUnsizedArrayDType()
 			       || nodep->dtypeSkipRefp()->castNodeClassDType())) {
 	    nodep->v3error("Unsupported: Inputs and outputs must be simple data types");
 	}
+	if (nodep->isDpiOpenArray()
+	    && !(nodep->isIO() && m_ftaskp && m_ftaskp->dpiImport())) {
+	    nodep->v3error("Unsupported: Unsized array dimension except on DPI import arguments: "<<nodep->prettyName());
+	}
 	if (nodep->dtypep()->skipRefToConstp()->castConstDType()) {
 	    nodep->isConst(true);
 	}
@@ -862,14 +878,14 @@ private:
 	if (implicitParam) {
 	    if (nodep->valuep()) {
 		int width=0;
-		nodep->valuep()->iterateAndNext(*this,WidthVP(width,0,PRELIM).p());
+		iterateAndNext(nodep->valuep(), WidthVP(width,0,PRELIM).p());
 		UINFO(9,"implicitParamPRELIMIV "<<nodep->valuep()<<endl);
 		// Although nodep will get a different width for parameters just below,
 		// we want the init numbers to retain their width/minwidth until parameters are replaced.
 		// This prevents width warnings at the location the parameter is substituted in
 		if (nodep->valuep()->isDouble()) {
 		    nodep->dtypeSetDouble(); bdtypep=NULL;
-		    nodep->valuep()->iterateAndNext(*this,WidthVP(width,0,FINAL).p());
+		    iterateAndNext(nodep->valuep(), WidthVP(width,0,FINAL).p());
 		} else {
 		    AstBasicDType* valueBdtypep = nodep->valuep()->dtypep()->basicp();
 		    bool issigned = false;
@@ -897,7 +913,7 @@ private:
 						   issigned?AstNumeric::SIGNED : AstNumeric::UNSIGNED);
 		    }
 		    didchk = true;
-		    nodep->valuep()->iterateAndNext(*this,WidthVP(width,nodep->widthMin(),FINAL).p());
+		    iterateAndNext(nodep->valuep(), WidthVP(width,nodep->widthMin(),FINAL).p());
 		}
 		UINFO(9,"implicitParamFromIV "<<nodep->valuep()<<endl);
 		//UINFO below will print variable nodep
@@ -911,7 +927,7 @@ private:
 	}
 	if (nodep->valuep()) {
 	    //if (debug()) nodep->dumpTree(cout,"  final: ");
-	    if (!didchk) nodep->valuep()->iterateAndNext(*this,WidthVP(nodep->dtypep()->width(),0,BOTH).p());
+	    if (!didchk) iterateAndNext(nodep->valuep(), WidthVP(nodep->dtypep()->width(),0,BOTH).p());
 	    if (!nodep->valuep()->castInitArray()) { // No dtype at present, perhaps TODO
 		widthCheck(nodep,"Initial value",nodep->valuep(),nodep->width(),nodep->widthMin());
 	    }
@@ -929,7 +945,7 @@ private:
 	if (!nodep->varp()) nodep->v3fatalSrc("Unlinked varref");
 	if (!nodep->varp()->didWidth()) {
 	    // Var hasn't been widthed, so make it so.
-	    nodep->varp()->iterate(*this);
+	    accept(nodep->varp());
 	}
 	//if (debug()>=9) { nodep->dumpTree(cout,"  VRin  "); nodep->varp()->dumpTree(cout,"   forvar "); }
 	// Note genvar's are also entered as integers
@@ -955,7 +971,7 @@ private:
 	nodep->dtypep(nodep);
 	nodep->widthFromSub(nodep->subDTypep());
 	// Assign widths
-	nodep->itemsp()->iterateAndNext(*this,WidthVP(nodep->dtypep(),BOTH).p());
+	iterateAndNext(nodep->itemsp(), WidthVP(nodep->dtypep(),BOTH).p());
 	// Assign missing values
 	V3Number num (nodep->fileline(), nodep->width(), 0);
 	V3Number one (nodep->fileline(), nodep->width(), 1);
@@ -1000,7 +1016,7 @@ private:
 	nodep->dtypep(vdtypep);
 	if (nodep->valuep()) {  // else the value will be assigned sequentially
 	    int width = vdtypep->width();  // Always from parent type
-	    nodep->valuep()->iterateAndNext(*this,WidthVP(width,0,BOTH).p());
+	    iterateAndNext(nodep->valuep(), WidthVP(width,0,BOTH).p());
 	    int mwidth = nodep->valuep()->widthMin();  // Value determines minwidth
 	    nodep->dtypeChgWidth(width, mwidth);
 	    widthCheck(nodep,"Enum value",nodep->valuep(),width,mwidth);
@@ -1015,19 +1031,19 @@ private:
 		if (enump->castEnumDType()) break;
 	    }
 	    if (!enump) nodep->v3fatalSrc("EnumItemRef can't deref back to an Enum");
-	    enump->iterate(*this,vup);
+	    accept(enump, vup);
 	}
 	nodep->dtypeFrom(nodep->itemp());
     }
     virtual void visit(AstInitArray* nodep, AstNUser* vup) {
 	// Should be correct by construction, so we'll just loop through all types
-	nodep->iterateChildren(*this, vup);
+	iterateChildren(nodep, vup);
     }
     virtual void visit(AstInside* nodep, AstNUser* vup) {
-	nodep->exprp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	iterateAndNext(nodep->exprp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	for (AstNode* nextip, *itemp = nodep->itemsp(); itemp; itemp=nextip) {
 	    nextip = itemp->nextp(); // Prelim may cause the node to get replaced
-	    itemp->iterate(*this,WidthVP(ANYSIZE,0,PRELIM).p()); itemp=NULL;
+	    accept(itemp, WidthVP(ANYSIZE,0,PRELIM).p()); itemp=NULL;
 	}
 	// Take width as maximum across all items
 	int width = nodep->exprp()->width();
@@ -1037,7 +1053,7 @@ private:
 	    mwidth = max(mwidth,itemp->widthMin());
 	}
 	// Apply width
-	nodep->exprp()->iterateAndNext(*this,WidthVP(width,mwidth,FINAL).p());
+	iterateAndNext(nodep->exprp(), WidthVP(width,mwidth,FINAL).p());
 	for (AstNode* itemp = nodep->itemsp(); itemp; itemp=itemp->nextp()) {
 	    widthCheck(nodep,"Inside Item",itemp,width,mwidth);
 	}
@@ -1071,15 +1087,15 @@ private:
     }
     virtual void visit(AstInsideRange* nodep, AstNUser* vup) {
 	// Just do each side; AstInside will rip these nodes out later
-	nodep->lhsp()->iterateAndNext(*this,vup);
-	nodep->rhsp()->iterateAndNext(*this,vup);
+	iterateAndNext(nodep->lhsp(), vup);
+	iterateAndNext(nodep->rhsp(), vup);
 	nodep->dtypeFrom(nodep->lhsp());
     }
 
     virtual void visit(AstIfaceRefDType* nodep, AstNUser* vup) {
 	if (nodep->didWidthAndSet()) return;  // This node is a dtype & not both PRELIMed+FINALed
 	UINFO(5,"   IFACEREF "<<nodep<<endl);
-	nodep->iterateChildren(*this, vup);
+	iterateChildren(nodep, vup);
 	nodep->dtypep(nodep);
 	nodep->widthForce(1, 1); // Not really relevant
 	UINFO(4,"dtWidthed "<<nodep<<endl);
@@ -1091,7 +1107,7 @@ private:
 	if (!nodep->packed()) {
 	    nodep->v3warn(UNPACKED, "Unsupported: Unpacked struct/union");
 	}
-	nodep->iterateChildren(*this);  // First size all members
+	iterateChildren(nodep);  // First size all members
 	nodep->repairMemberCache();
 	// Determine bit assignments and width
 	nodep->dtypep(nodep);
@@ -1124,7 +1140,7 @@ private:
     virtual void visit(AstMemberSel* nodep, AstNUser* vup) {
 	UINFO(5,"   MEMBERSEL "<<nodep<<endl);
 	if (debug()>=9) nodep->dumpTree("-ms-in-");
-	nodep->iterateChildren(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateChildren(nodep, WidthVP(ANYSIZE,0,BOTH).p());
 	// Find the fromp dtype - should be a class
 	AstNodeDType* fromDtp = nodep->fromp()->dtypep()->skipRefp();
 	UINFO(9,"     from dt "<<fromDtp<<endl);
@@ -1252,7 +1268,7 @@ private:
 		    // Determine initial values
 		    vdtypep = memp;
 		    patp->dtypep(memp);
-		    patp->accept(*this,WidthVP(memp,BOTH).p());
+		    accept(patp, WidthVP(memp,BOTH).p());
 		    // Convert to concat for now
 		    if (!newp) newp = patp->lhsp()->unlinkFrBack();
 		    else {
@@ -1277,13 +1293,13 @@ private:
 	if (!vdtypep) nodep->v3fatalSrc("Pattern member type not assigned by AstPattern visitor");
 	nodep->dtypep(vdtypep);
 	nodep->lhsp()->dtypeFrom(nodep);
-	nodep->iterateChildren(*this,WidthVP(nodep->dtypep(),BOTH).p());
+	iterateChildren(nodep, WidthVP(nodep->dtypep(),BOTH).p());
 	widthCheck(nodep,"LHS",nodep->lhsp(),nodep->width(),nodep->width());
     }
     int visitPatMemberRep(AstPatMember* nodep) {
 	uint32_t times = 1;
 	if (nodep->repp()) { // else repp()==NULL shorthand for rep count 1
-	    nodep->repp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->repp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->repp());
 	    V3Const::constifyParamsEdit(nodep->repp()); // repp may change
 	    AstConst* constp = nodep->repp()->castConst();
@@ -1296,10 +1312,10 @@ private:
     }
 
     virtual void visit(AstPslClocked* nodep, AstNUser*) {
-	nodep->propp()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
-	nodep->sensesp()->iterateAndNext(*this);
+	iterateAndNext(nodep->propp(), WidthVP(1,1,BOTH).p());
+	iterateAndNext(nodep->sensesp());
 	if (nodep->disablep()) {
-	    nodep->disablep()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
+	    iterateAndNext(nodep->disablep(), WidthVP(1,1,BOTH).p());
 	    widthCheckReduce(nodep,"Disable",nodep->disablep()); // it's like an if() condition.
 	}
 	widthCheckReduce(nodep,"Property",nodep->propp());	// it's like an if() condition.
@@ -1311,13 +1327,13 @@ private:
 
     virtual void visit(AstNodeCase* nodep, AstNUser*) {
 	// TOP LEVEL NODE
-	nodep->exprp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	iterateAndNext(nodep->exprp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	for (AstCaseItem* nextip, *itemp = nodep->itemsp(); itemp; itemp=nextip) {
 	    nextip = itemp->nextp()->castCaseItem(); // Prelim may cause the node to get replaced
-	    if (!nodep->castGenCase()) itemp->bodysp()->iterateAndNext(*this);
+	    if (!nodep->castGenCase()) iterateAndNext(itemp->bodysp());
 	    for (AstNode* nextcp, *condp = itemp->condsp(); condp; condp=nextcp) {
 		nextcp = condp->nextp(); // Prelim may cause the node to get replaced
-		condp->iterate(*this,WidthVP(ANYSIZE,0,PRELIM).p()); condp=NULL;
+		accept(condp, WidthVP(ANYSIZE,0,PRELIM).p()); condp=NULL;
 	    }
 	}
 	// Take width as maximum across all items
@@ -1330,10 +1346,10 @@ private:
 	    }
 	}
 	// Apply width
-	nodep->exprp()->iterateAndNext(*this,WidthVP(width,mwidth,FINAL).p());
+	iterateAndNext(nodep->exprp(), WidthVP(width,mwidth,FINAL).p());
 	for (AstCaseItem* itemp = nodep->itemsp(); itemp; itemp=itemp->nextp()->castCaseItem()) {
 	    for (AstNode* condp = itemp->condsp(); condp; condp=condp->nextp()) {
-		condp->iterate(*this,WidthVP(width,mwidth,FINAL).p());
+		accept(condp, WidthVP(width,mwidth,FINAL).p());
 		widthCheck(nodep,"Case Item",condp,width,mwidth);
 	    }
 	}
@@ -1341,32 +1357,32 @@ private:
     }
     virtual void visit(AstNodeFor* nodep, AstNUser*) {
 	// TOP LEVEL NODE
-	nodep->initsp()->iterateAndNext(*this);
-	nodep->condp()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
-	if (!nodep->castGenFor()) nodep->bodysp()->iterateAndNext(*this);
-	nodep->incsp()->iterateAndNext(*this);
+	iterateAndNext(nodep->initsp());
+	iterateAndNext(nodep->condp(), WidthVP(1,1,BOTH).p());
+	if (!nodep->castGenFor()) iterateAndNext(nodep->bodysp());
+	iterateAndNext(nodep->incsp());
 	widthCheckReduce(nodep,"For Test Condition",nodep->condp());	// it's like an if() condition.
     }
     virtual void visit(AstRepeat* nodep, AstNUser*) {
-	nodep->countp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	nodep->bodysp()->iterateAndNext(*this);
+	iterateAndNext(nodep->countp(), WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->bodysp());
     }
     virtual void visit(AstWhile* nodep, AstNUser*) {
 	// TOP LEVEL NODE
-	nodep->precondsp()->iterateAndNext(*this);
-	nodep->condp()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
-	nodep->bodysp()->iterateAndNext(*this);
-	nodep->incsp()->iterateAndNext(*this);
+	iterateAndNext(nodep->precondsp());
+	iterateAndNext(nodep->condp(), WidthVP(1,1,BOTH).p());
+	iterateAndNext(nodep->bodysp());
+	iterateAndNext(nodep->incsp());
 	widthCheckReduce(nodep,"For Test Condition",nodep->condp());	// it's like an if() condition.
     }
     virtual void visit(AstNodeIf* nodep, AstNUser*) {
 	// TOP LEVEL NODE
 	//if (debug()) nodep->dumpTree(cout,"  IfPre: ");
 	if (!nodep->castGenIf()) {  // for m_paramsOnly
-	    nodep->ifsp()->iterateAndNext(*this);
-	    nodep->elsesp()->iterateAndNext(*this);
+	    iterateAndNext(nodep->ifsp());
+	    iterateAndNext(nodep->elsesp());
 	}
-	nodep->condp()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
+	iterateAndNext(nodep->condp(), WidthVP(1,1,BOTH).p());
 	spliceCvtCmpD0(nodep->condp());
 	widthCheckReduce(nodep,"If",nodep->condp());	// it's like an if() condition.
 	//if (debug()) nodep->dumpTree(cout,"  IfOut: ");
@@ -1376,10 +1392,10 @@ private:
 	//if (debug()) nodep->dumpTree(cout,"  AssignPre: ");
 	{
 	    //if (debug()) nodep->dumpTree(cout,"-    assin:  ");
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    if (!nodep->lhsp()->dtypep()) nodep->v3fatalSrc("How can LHS be untyped?");
 	    if (!nodep->lhsp()->dtypep()->widthSized()) nodep->v3fatalSrc("How can LHS be unsized?");
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(nodep->lhsp()->dtypep(),ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(nodep->lhsp()->dtypep(),ANYSIZE,0,PRELIM).p());
 	    //if (debug()) nodep->dumpTree(cout,"-    assign: ");
 	    if (!nodep->lhsp()->isDouble() && nodep->rhsp()->isDouble()) {
 		spliceCvtS(nodep->rhsp(), false);  // Round RHS
@@ -1390,7 +1406,7 @@ private:
 	    if (awidth==0) {
 		awidth = nodep->rhsp()->width();	// Parameters can propagate by unsized assignment
 	    }
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(nodep->lhsp()->dtypep(),awidth,awidth,FINAL).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(nodep->lhsp()->dtypep(),awidth,awidth,FINAL).p());
 	    nodep->dtypeFrom(nodep->lhsp());
 	    nodep->dtypeChgWidth(awidth,awidth);  // We know the assign will truncate, so rather
 	    // than using "width" and have the optimizer truncate the result, we do
@@ -1404,7 +1420,7 @@ private:
 	// Excludes NodeDisplay, see below
 	// TOP LEVEL NODE
 	// Just let all arguments seek their natural sizes
-	nodep->iterateChildren(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateChildren(nodep, WidthVP(ANYSIZE,0,BOTH).p());
 	//
 	UINFO(9,"  Display in "<<nodep->text()<<endl);
 	string dispout = "";
@@ -1440,107 +1456,107 @@ private:
     }
     virtual void visit(AstDisplay* nodep, AstNUser*) {
 	if (nodep->filep()) {
-	    nodep->filep()->iterateAndNext(*this,WidthVP(32,32,BOTH).p());
+	    iterateAndNext(nodep->filep(), WidthVP(32,32,BOTH).p());
 	    widthCheckFileDesc(nodep,nodep->filep());
 	}
 	// Just let all arguments seek their natural sizes
-	nodep->iterateChildren(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateChildren(nodep, WidthVP(ANYSIZE,0,BOTH).p());
     }
     virtual void visit(AstFOpen* nodep, AstNUser*) {
-	nodep->filep()->iterateAndNext(*this,WidthVP(32,32,BOTH).p());
-	nodep->filenamep()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	nodep->modep()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->filep(), WidthVP(32,32,BOTH).p());
+	iterateAndNext(nodep->filenamep(), WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->modep(), WidthVP(ANYSIZE,0,BOTH).p());
 	widthCheckFileDesc(nodep,nodep->filep());
     }
     virtual void visit(AstFClose* nodep, AstNUser*) {
-	nodep->filep()->iterateAndNext(*this,WidthVP(32,32,BOTH).p());
+	iterateAndNext(nodep->filep(), WidthVP(32,32,BOTH).p());
 	widthCheckFileDesc(nodep,nodep->filep());
     }
     virtual void visit(AstFEof* nodep, AstNUser*) {
-	nodep->filep()->iterateAndNext(*this,WidthVP(32,32,BOTH).p());
+	iterateAndNext(nodep->filep(), WidthVP(32,32,BOTH).p());
 	nodep->dtypeSetLogicSized(32,1,AstNumeric::SIGNED);  // Spec says integer return
 	widthCheckFileDesc(nodep,nodep->filep());
     }
     virtual void visit(AstFFlush* nodep, AstNUser*) {
 	if (nodep->filep()) {
-	    nodep->filep()->iterateAndNext(*this,WidthVP(32,32,BOTH).p());
+	    iterateAndNext(nodep->filep(), WidthVP(32,32,BOTH).p());
 	    widthCheckFileDesc(nodep,nodep->filep());
 	}
     }
     virtual void visit(AstFGetC* nodep, AstNUser* vup) {
-	nodep->filep()->iterateAndNext(*this,WidthVP(32,32,BOTH).p());
+	iterateAndNext(nodep->filep(), WidthVP(32,32,BOTH).p());
 	if (vup->c()->prelim()) {
 	    nodep->dtypeSetLogicSized(32,8,AstNumeric::SIGNED);  // Spec says integer return
 	}
 	widthCheckFileDesc(nodep,nodep->filep());
     }
     virtual void visit(AstFGetS* nodep, AstNUser* vup) {
-	nodep->filep()->iterateAndNext(*this,WidthVP(32,32,BOTH).p());
-	nodep->strgp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->filep(), WidthVP(32,32,BOTH).p());
+	iterateAndNext(nodep->strgp(), WidthVP(ANYSIZE,0,BOTH).p());
 	if (vup->c()->prelim()) {
 	    nodep->dtypeSetSigned32();  // Spec says integer return
 	}
 	widthCheckFileDesc(nodep,nodep->filep());
     }
     virtual void visit(AstFScanF* nodep, AstNUser* vup) {
-	nodep->filep()->iterateAndNext(*this,WidthVP(32,32,BOTH).p());
-	nodep->exprsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->filep(), WidthVP(32,32,BOTH).p());
+	iterateAndNext(nodep->exprsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	if (vup->c()->prelim()) {
 	    nodep->dtypeSetSigned32();  // Spec says integer return
 	}
 	widthCheckFileDesc(nodep,nodep->filep());
     }
     virtual void visit(AstSScanF* nodep, AstNUser* vup) {
-	nodep->fromp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	nodep->exprsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->fromp(), WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->exprsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	if (vup->c()->prelim()) {
 	    nodep->dtypeSetSigned32();  // Spec says integer return
 	}
     }
     virtual void visit(AstSysIgnore* nodep, AstNUser* vup) {
-	nodep->exprsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->exprsp(), WidthVP(ANYSIZE,0,BOTH).p());
     }
     virtual void visit(AstSystemF* nodep, AstNUser*) {
-	nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	nodep->dtypeSetSigned32();  // Spec says integer return
     }
     virtual void visit(AstSystemT* nodep, AstNUser*) {
-	nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
     }
     virtual void visit(AstReadMem* nodep, AstNUser*) {
-	nodep->filenamep()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	nodep->memp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->filenamep(), WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->memp(), WidthVP(ANYSIZE,0,BOTH).p());
 	if (!nodep->memp()->dtypep()->skipRefp()->castUnpackArrayDType()) {
 	    nodep->memp()->v3error("Unsupported: $readmem into other than unpacked array");
 	}
-	nodep->lsbp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	nodep->msbp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->lsbp(), WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->msbp(), WidthVP(ANYSIZE,0,BOTH).p());
     }
     virtual void visit(AstValuePlusArgs* nodep, AstNUser* vup) {
-	nodep->exprsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->exprsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	nodep->dtypeSetSigned32();  // Spec says integer return
     }
     virtual void visit(AstUCStmt* nodep, AstNUser*) {
 	// TOP LEVEL NODE
 	// Just let all arguments seek their natural sizes
-	nodep->iterateChildren(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateChildren(nodep, WidthVP(ANYSIZE,0,BOTH).p());
     }
     virtual void visit(AstPslCover* nodep, AstNUser*) {
 	// TOP LEVEL NODE
-	nodep->propp()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
-	nodep->stmtsp()->iterateChildren(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	iterateAndNext(nodep->propp(), WidthVP(1,1,BOTH).p());
+	iterateChildren(nodep->stmtsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	widthCheckReduce(nodep,"Property",nodep->propp());	// it's like an if() condition.
     }
     virtual void visit(AstPslAssert* nodep, AstNUser*) {
 	// TOP LEVEL NODE
-	nodep->propp()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
+	iterateAndNext(nodep->propp(), WidthVP(1,1,BOTH).p());
 	widthCheckReduce(nodep,"Property",nodep->propp());	// it's like an if() condition.
     }
     virtual void visit(AstVAssert* nodep, AstNUser*) {
 	// TOP LEVEL NODE
-	nodep->propp()->iterateAndNext(*this,WidthVP(1,1,BOTH).p());
-	nodep->passsp()->iterateAndNext(*this);
-	nodep->failsp()->iterateAndNext(*this);
+	iterateAndNext(nodep->propp(), WidthVP(1,1,BOTH).p());
+	iterateAndNext(nodep->passsp());
+	iterateAndNext(nodep->failsp());
 	widthCheckReduce(nodep,"Property",nodep->propp());	// it's like an if() condition.
     }
     virtual void visit(AstPin* nodep, AstNUser*) {
@@ -1548,18 +1564,18 @@ private:
 	// TOP LEVEL NODE
 	if (nodep->modVarp() && nodep->modVarp()->isGParam()) {
 	    // Widthing handled as special init() case
-	    nodep->iterateChildren(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateChildren(nodep, WidthVP(ANYSIZE,0,BOTH).p());
 	} else if (!m_paramsOnly) {
 	    if (nodep->modVarp()->width()==0) {
 		// Var hasn't been widthed, so make it so.
-		nodep->modVarp()->iterate(*this);
+		accept(nodep->modVarp());
 	    }
 	    if (!nodep->exprp()) { // No-connect
 		return;
 	    }
 	    // Very much like like an assignment, but which side is LH/RHS
 	    // depends on pin being a in/output/inout.
-	    nodep->exprp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->exprp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	    int pinwidth = nodep->modVarp()->width();
 	    int expwidth = nodep->exprp()->width();
 	    bool inputPin = nodep->modVarp()->isInput();
@@ -1608,7 +1624,7 @@ private:
 		    awidth = expwidth;
 		}
 	    }
-	    nodep->exprp()->iterateAndNext(*this,WidthVP(awidth,awidth,FINAL).p());
+	    iterateAndNext(nodep->exprp(), WidthVP(awidth,awidth,FINAL).p());
 	    if (!m_cellRangep) {
 		AstNodeDType* expDTypep = nodep->findLogicDType(pinwidth, pinwidth,
 								nodep->exprp()->dtypep()->numeric());
@@ -1628,11 +1644,11 @@ private:
 	    }
 	    if (nodep->rangep()) {
 		m_cellRangep = nodep->rangep();
-		nodep->rangep()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+		iterateAndNext(nodep->rangep(), WidthVP(ANYSIZE,0,BOTH).p());
 	    }
-	    nodep->pinsp()->iterateAndNext(*this);
+	    iterateAndNext(nodep->pinsp());
 	}
-	nodep->paramsp()->iterateAndNext(*this);
+	iterateAndNext(nodep->paramsp());
 	m_cellRangep = NULL;
     }
     virtual void visit(AstNodeFTask* nodep, AstNUser* vup) {
@@ -1647,7 +1663,10 @@ private:
 	}
 	// Function hasn't been widthed, so make it so.
 	nodep->doingWidth(true);  // Would use user1 etc, but V3Width called from too many places to spend a user
-	nodep->iterateChildren(*this);
+	AstNodeFTask* oldFTaskp = m_ftaskp;
+	m_ftaskp = nodep;
+	iterateChildren(nodep);
+	m_ftaskp = oldFTaskp;
 	if (nodep->fvarp()) {
 	    m_funcp = nodep->castFunc();
 	    if (!m_funcp) nodep->v3fatalSrc("FTask with function variable, but isn't a function");
@@ -1665,7 +1684,7 @@ private:
 	} else {
 	    if (nodep->lhsp()) {
 		// Function hasn't been widthed, so make it so.
-		nodep->iterateChildren(*this,WidthVP(ANYSIZE,0,BOTH).p());
+		iterateChildren(nodep, WidthVP(ANYSIZE,0,BOTH).p());
 		nodep->dtypeFrom(m_funcp->fvarp());
 	    }
 	}
@@ -1680,7 +1699,7 @@ private:
 	UINFO(5, "  FTASKREF "<<nodep<<endl);
 	if (!nodep->taskp()) nodep->v3fatalSrc("Unlinked");
 	if (nodep->didWidth()) return;
-	nodep->taskp()->iterate(*this);
+	accept(nodep->taskp());
 	//
 	// And do the arguments to the task/function too
 	for (int accept_mode=0; accept_mode<3; accept_mode++) {  // Avoid duplicate code; just do inner stuff several times
@@ -1727,7 +1746,7 @@ private:
 			    handle.relink(newp);
 			    pinp = newp;
 			}
-			pinp->accept(*this,WidthVP(portp->dtypep(),PRELIM).p());  pinp=NULL;
+			accept(pinp, WidthVP(portp->dtypep(),PRELIM).p());  pinp=NULL;
 		    } else if (accept_mode==1) {
 			// Change data types based on above accept completion
 			if (portp->isDouble()) {
@@ -1735,7 +1754,11 @@ private:
 			}
 		    } else if (accept_mode==2) {
 			// Do PRELIM again, because above accept may have exited early due to node replacement
-			pinp->accept(*this,WidthVP(portp->dtypep(),BOTH).p());
+			accept(pinp, WidthVP(portp->dtypep(),BOTH).p());
+			if (portp->isDpiOpenArray()) {
+			    widthCheckDpiOpenArray(portp, pinp);
+			    continue;
+			}
 			if ((portp->isOutput() || portp->isInout())
 			    && pinp->width() != portp->width()) {
 			    pinp->v3error("Unsupported: Function output argument '"<<portp->prettyName()<<"'"
@@ -1756,7 +1779,7 @@ private:
     }
     virtual void visit(AstInitial* nodep, AstNUser*) {
 	m_initialp = nodep;
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
 	m_initialp = NULL;
     }
     virtual void visit(AstNetlist* nodep, AstNUser*) {
@@ -1768,12 +1791,12 @@ private:
     // Default
     virtual void visit(AstNodeMath* nodep, AstNUser*) {
 	nodep->v3fatalSrc("Visit function missing? Widthed function missing for math node: "<<nodep);
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
     virtual void visit(AstNode* nodep, AstNUser* vup) {
 	// Default: Just iterate
 	if (vup) nodep->v3fatalSrc("Visit function missing? Widthed expectation for this node: "<<nodep);
-	nodep->iterateChildren(*this);
+	iterateChildren(nodep);
     }
 
     //----------------------------------------------------------------------
@@ -1783,7 +1806,7 @@ private:
 	// CALLER: AstBitsToRealD
 	// Real: Output real
 	if (vup->c()->prelim()) {  // First stage evaluation
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->lhsp());
 	    nodep->dtypeSetDouble();
 	    widthCheck(nodep,"LHS",nodep->lhsp(),64,64);
@@ -1793,7 +1816,7 @@ private:
 	// CALLER: AstIToRD
 	// Real: Output real
 	if (vup->c()->prelim()) {  // First stage evaluation
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtUS(nodep->lhsp());
 	    nodep->dtypeSetDouble();
 	    widthCheck(nodep,"LHS",nodep->lhsp(),32,32);
@@ -1803,7 +1826,7 @@ private:
 	// CALLER: RToI
 	// Real: LHS real
 	if (vup->c()->prelim()) {  // First stage evaluation
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtD(nodep->lhsp());
 	    nodep->dtypeSetSigned32();
 	}
@@ -1812,7 +1835,7 @@ private:
 	// CALLER: RealToBits
 	// Real: LHS real
 	if (vup->c()->prelim()) {  // First stage evaluation
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtD(nodep->lhsp());
 	    nodep->dtypeSetUInt64();
 	}
@@ -1828,7 +1851,7 @@ private:
 	// We finally set the width of our output
 	if (nodep->op2p()) nodep->v3fatalSrc("For unary ops only!");
 	if (vup->c()->prelim()) {
-	    nodep->op1p()->iterateAndNext(*this,WidthVP(1,0,BOTH).p());
+	    iterateAndNext(nodep->op1p(), WidthVP(1,0,BOTH).p());
 	    spliceCvtCmpD0(nodep->op1p());
 	}
 	nodep->dtypeSetLogicBool();
@@ -1840,8 +1863,8 @@ private:
 	// CALLER: LogAnd, LogOr, LogIf, LogIff
 	// Widths: 1 bit out, lhs 1 bit, rhs 1 bit
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(1,0,BOTH).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(1,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(1,0,BOTH).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(1,0,BOTH).p());
 	    spliceCvtCmpD0(nodep->lhsp());
 	    spliceCvtCmpD0(nodep->rhsp());
 	}
@@ -1857,7 +1880,7 @@ private:
 	// Widths: 1 bit out, Any width lhs
 	// Signed: Output unsigned, Lhs/Rhs/etc non-real
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	}
 	if (!realok) checkCvtUS(nodep->lhsp());
 	nodep->dtypeSetLogicBool();
@@ -1869,8 +1892,8 @@ private:
 	// Signed: if RHS&LHS signed, OPERATOR CHANGES to signed flavor
 	// Real: allowed on RHS, if RHS|LHS is real, both become real, and OPERATOR CHANGES
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	}
 	if (nodep->lhsp()->isDouble() || nodep->rhsp()->isDouble()) {
 	    spliceCvtD(nodep->lhsp());
@@ -1888,8 +1911,8 @@ private:
 	int ewidth = max(nodep->lhsp()->widthMin(), nodep->rhsp()->widthMin());
 	nodep->dtypeSetLogicBool();
 	if (vup->c()->final()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(width,ewidth,FINAL).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(width,ewidth,FINAL).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(width,ewidth,FINAL).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(width,ewidth,FINAL).p());
 	    widthCheck(nodep,"LHS",nodep->lhsp(),width,ewidth);
 	    widthCheck(nodep,"RHS",nodep->rhsp(),width,ewidth);
 	}
@@ -1902,8 +1925,8 @@ private:
 	// Real if and only if real_lhs set
 	if (!nodep->rhsp()) nodep->v3fatalSrc("For binary ops only!");
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	}
 	if (real_lhs) {
 	    checkCvtD(nodep->lhsp());
@@ -1916,8 +1939,8 @@ private:
 	int ewidth = max(nodep->lhsp()->widthMin(), nodep->rhsp()->widthMin());
 	nodep->dtypeSetLogicBool();
 	if (vup->c()->final()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(width,ewidth,FINAL).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(width,ewidth,FINAL).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(width,ewidth,FINAL).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(width,ewidth,FINAL).p());
 	    widthCheck(nodep,"LHS",nodep->lhsp(),width,ewidth);
 	    widthCheck(nodep,"RHS",nodep->rhsp(),width,ewidth);
 	}
@@ -1931,7 +1954,7 @@ private:
 	// "Interim results shall take the max of operands, including LHS of assignments"
 	if (nodep->op2p()) nodep->v3fatalSrc("For unary ops only!");
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	    if (!real_ok) checkCvtUS(nodep->lhsp());
 	}
 	if (real_ok && nodep->lhsp()->isDouble()) {
@@ -1950,7 +1973,7 @@ private:
 	nodep->dtypeFrom(nodep->lhsp());
 	nodep->dtypeChgWidth(width,ewidth);
 	if (vup->c()->final()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(width,ewidth,FINAL).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(width,ewidth,FINAL).p());
 	    widthCheck(nodep,"LHS",nodep->lhsp(),width,ewidth);
 	}
     }
@@ -1961,7 +1984,7 @@ private:
 	// It always comes exactly from LHS; ignores any upper operand
 	if (nodep->op2p()) nodep->v3fatalSrc("For unary ops only!");
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	    checkCvtUS(nodep->lhsp());
 	}
 	int width  = nodep->lhsp()->width();
@@ -1969,7 +1992,7 @@ private:
 	nodep->dtypeSetLogicSized(width,ewidth,rs_out);
 	if (vup->c()->final()) {
 	    // Final call, so make sure children check their sizes
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(width,ewidth,FINAL).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(width,ewidth,FINAL).p());
 	    widthCheck(nodep,"LHS",nodep->lhsp(),width,ewidth);
 	}
     }
@@ -1985,8 +2008,8 @@ private:
     }
     void shift_prelim(AstNodeBiop* nodep, AstNUser* vup)  {
 	if (vup->c()->prelim()) {
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    if (!nodep->dtypep()) nodep->dtypeFrom(nodep->lhsp());
 	    checkCvtUS(nodep->lhsp());
 	    checkCvtUS(nodep->rhsp());
@@ -2005,7 +2028,7 @@ private:
 		}
 	    }
 	    int width=nodep->width();  int ewidth=nodep->widthMin();
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(width,ewidth,FINAL).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(width,ewidth,FINAL).p());
 	    widthCheck(nodep,"LHS",nodep->lhsp(),width,ewidth);
 	    if (nodep->rhsp()->width()>32) {
 		AstConst* shiftp = nodep->rhsp()->castConst();
@@ -2034,8 +2057,8 @@ private:
 	// to be the same for our operations.
 	if (vup->c()->prelim()) {  // First stage evaluation
 	    // Determine expression widths only relying on what's in the subops
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	    checkCvtUS(nodep->lhsp());
 	    checkCvtUS(nodep->rhsp());
 	}
@@ -2046,8 +2069,8 @@ private:
 				   expSigned?AstNumeric::SIGNED : AstNumeric::UNSIGNED);
 	if (vup->c()->final()) {
 	    // Final call, so make sure children check their sizes
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(width,mwidth,FINAL).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(width,mwidth,FINAL).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(width,mwidth,FINAL).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(width,mwidth,FINAL).p());
 	    // Some warning suppressions
 	    bool lhsOk=false; bool rhsOk = false;
 	    if (nodep->castAdd() || nodep->castSub()) {
@@ -2076,8 +2099,8 @@ private:
 	//if (debug()>=9) { UINFO(0,"-rus "<<vup->c()<<endl); nodep->dumpTree(cout,"-rusin-"); }
 	if (vup->c()->prelim()) {  // First stage evaluation
 	    // Determine expression widths only relying on what's in the subops
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(ANYSIZE,0,PRELIM).p());
 	}
 	if (!real_ok) {
 	    checkCvtUS(nodep->lhsp());
@@ -2102,8 +2125,8 @@ private:
 	nodep->dtypeChgWidth(width,mwidth);
 	if (vup->c()->final()) {
 	    // Final call, so make sure children check their sizes
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(width,mwidth,FINAL).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(width,mwidth,FINAL).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(width,mwidth,FINAL).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(width,mwidth,FINAL).p());
 	    // Some warning suppressions
 	    bool lhsOk=false; bool rhsOk = false;
 	    if (nodep->castAdd() || nodep->castSub()) {
@@ -2122,8 +2145,8 @@ private:
     void visit_math_Or_LRr(AstNodeBiop* nodep, AstNUser* vup) {
 	// CALLER: AddD, MulD, ...
 	if (vup->c()->prelim()) {  // First stage evaluation
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
-	    nodep->rhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->rhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtD(nodep->lhsp());
 	    checkCvtD(nodep->rhsp());
 	    nodep->dtypeSetDouble();
@@ -2132,7 +2155,7 @@ private:
     void visit_math_Or_Lr(AstNodeUniop* nodep, AstNUser* vup) {
 	// CALLER: Negate, Ceil, Log, ...
 	if (vup->c()->prelim()) {  // First stage evaluation
-	    nodep->lhsp()->iterateAndNext(*this,WidthVP(ANYSIZE,0,BOTH).p());
+	    iterateAndNext(nodep->lhsp(), WidthVP(ANYSIZE,0,BOTH).p());
 	    checkCvtD(nodep->lhsp());
 	    nodep->dtypeSetDouble();
 	}
@@ -2315,6 +2338,22 @@ private:
 	}
     }
 
+    void widthCheckDpiOpenArray (AstVar* portp, AstNode* pinp) {
+	// Open arrays are passed as the caller's storage, so must connect to an array of identical elements
+	AstVarRef* varrefp = pinp->castVarRef();
+	AstUnpackArrayDType* adtypep = varrefp ? varrefp->varp()->dtypeSkipRefp()->castUnpackArrayDType() : NULL;
+	if (!adtypep) {
+	    pinp->v3error("Unsupported: Open array argument '"<<portp->prettyName()<<"'"
+			  <<" must be connected to an unpacked array variable");
+	} else if (adtypep->subDTypep()->skipRefp()->castNodeArrayDType()) {
+	    pinp->v3error("Unsupported: Open array argument '"<<portp->prettyName()<<"'"
+			  <<" connected to a multidimensional array");
+	} else if (adtypep->subDTypep()->width() != portp->width()) {
+	    pinp->v3error("Open array argument '"<<portp->prettyName()<<"'"
+			  <<" requires "<<portp->width()<<" bit elements,"
+			  <<" but connection's elements are "<<adtypep->subDTypep()->width()<<" bits.");
+	}
+    }
     void widthCheckPin (AstNode* nodep, AstNode* underp, AstNodeDType* expDTypep, bool inputPin) {
 	// Before calling this, iterate into underp with FINAL state, so numbers get resized appropriately
 	int expWidth = expDTypep->width();
@@ -2511,7 +2550,7 @@ private:
 	// or have a call outside of normal visitor land.
 	// or have a m_return type (but need to return if width called multiple times)
 	if (!nodep) parentp->v3fatalSrc("Null dtype when widthing dtype");
-	nodep->iterate(*this);
+	accept(nodep);
 	return nodep;
     }
 
@@ -2604,7 +2643,7 @@ private:
 	    initp->addInitsp(new AstConst(nodep->fileline(), AstConst::Signed32(),
 					  dimensionValue(nodep, attrType, i)));
 	}
-	varp->iterate(*this);  // May have already done $unit so must do this var
+	accept(varp);  // May have already done $unit so must do this var
 	return varp;
     }
 
@@ -2633,6 +2672,7 @@ public:
 	m_paramsOnly = paramsOnly;
 	m_cellRangep = NULL;
 	m_funcp = NULL;
+	m_ftaskp = NULL;
 	m_initialp = NULL;
 	m_attrp = NULL;
 	m_doGenerate = doGenerate;
@@ -76,6 +76,7 @@
 #include "V3Premit.h"
 #include "V3Scope.h"
 #include "V3Slice.h"
+#include "V3Sparse.h"
 #include "V3Split.h"
 #include "V3SplitAs.h"
 #include "V3Stats.h"
@@ -134,6 +135,10 @@ void V3Global::readFiles() {
 			 "Cannot find file containing library module: ");
     }
     //v3Global.rootp()->dumpTreeFile(v3Global.debugFilename("parse.tree"));
+    if (v3Global.opt.parseCache()) {
+	V3Stats::addStat("Parse cache, hits", V3PreShell::cacheHits());
+	V3Stats::addStat("Parse cache, misses", V3PreShell::cacheMisses());
+    }
     V3Error::abortIfErrors();
 
     if (!v3Global.opt.preprocOnly()) {
@@ -143,7 +148,14 @@ void V3Global::readFiles() {
 }
 
 void V3Global::dumpCheckGlobalTree(const string& filename, int newNumber, bool doDump) {
-    v3Global.rootp()->dumpTreeFile(v3Global.debugFilename(filename, newNumber), false, doDump);
+    // Each dump point ends a pass; the dump itself isn't timed.
+    // Passes such as const run repeatedly, so name each by step number as the dump file is
+    string dumpFilename = v3Global.debugFilename(filename, newNumber);
+    string passName = dumpFilename.substr(dumpFilename.rfind('/')+1
+					  + v3Global.opt.prefix().length()+1);  // Strip dir/prefix_
+    V3Stats::statsPassEnd(passName.substr(0, passName.rfind(".tree")));
+    v3Global.rootp()->dumpTreeFile(dumpFilename, false, doDump);
+    V3Stats::statsPassBegin();
 }
 
 //######################################################################
@@ -574,11 +586,16 @@ void process () {
 	// Note depth may insert something needing a cast, so this must be last.
 	V3Cast::castAll(v3Global.rootp());
 	V3Global::dumpCheckGlobalTree("cast.tree");
+
+	// Store large memories as pages allocated on use
+	V3Sparse::sparseAll(v3Global.rootp());
+	V3Global::dumpCheckGlobalTree("sparse.tree", 0, dumpMore);
     }
 
     V3Error::abortIfErrors();
 
     // Output the text
+    double emitStart = V3Stats::wallTime();
     if (!v3Global.opt.lintOnly()
 	&& !v3Global.opt.xmlOnly()) {
 	// emitcInlines is first, as it may set needHInlines which other emitters read
@@ -589,6 +606,12 @@ void process () {
     if (!v3Global.opt.xmlOnly()) { // Unfortunately we have some lint checks in emitc.
 	V3EmitC::emitc();
     }
+    if (v3Global.opt.stats()) {
+	V3Stats::addStat("Emission, wall time (ms)", (V3Stats::wallTime()-emitStart)*1000.0);
+	if (v3Global.opt.incremental()) {
+	    V3Stats::addStat("Emission, files unchanged", V3File::outputsReused());
+	}
+    }
     if (v3Global.opt.xmlOnly()
 	// Check XML when debugging to make sure no missing node types
 	|| (v3Global.opt.debugCheck() && !v3Global.opt.lintOnly())) {
@@ -596,6 +619,7 @@ void process () {
     }
 
     // Statistics
+    V3Stats::statsPassEnd("emit");
     if (v3Global.opt.stats()) {
 	V3Stats::statsFinalAll(v3Global.rootp());
 	V3Stats::statsReport();
@@ -671,7 +695,10 @@ int main(int argc, char** argv, char** env) {
     V3Options::unlinkRegexp(v3Global.opt.makeDir(), v3Global.opt.prefix()+"_*.txt");
 
     // Read first filename
+    V3Stats::statsPassBegin();
     v3Global.readFiles();
+    V3Stats::statsPassEnd("parse");
+    V3Stats::statsPassBegin();
 
     // Link, etc, if needed
     if (!v3Global.opt.preprocOnly()) {
@@ -679,7 +706,8 @@ int main(int argc, char** argv, char** env) {
     }
 
     // Final steps
-    V3Global::dumpCheckGlobalTree("final.tree",990);
+    // Statistics are already reported, so dump without ending another pass
+    v3Global.rootp()->dumpTreeFile(v3Global.debugFilename("final.tree",990));
     V3Error::abortIfWarnings();
 
     if (!v3Global.opt.lintOnly() && !v3Global.opt.cdc()
@@ -690,6 +718,10 @@ int main(int argc, char** argv, char** env) {
 	&& (v3Global.opt.skipIdentical() || v3Global.opt.makeDepend())) {
 	V3File::writeTimes(v3Global.opt.makeDir()+"/"+v3Global.opt.prefix()+"__verFiles.dat", argString);
     }
+    if (!v3Global.opt.lintOnly() && !v3Global.opt.cdc()
+	&& v3Global.opt.incremental()) {
+	V3File::writeHashes(v3Global.opt.makeDir()+"/"+v3Global.opt.prefix()+"__verHash.dat");
+    }
 
     // Final writing shouldn't throw warnings, but...
     V3Error::abortIfWarnings();
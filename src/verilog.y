@@ -86,8 +86,8 @@ public:
 
     // METHODS
     void argWrapList(AstNodeFTaskRef* nodep);
-    AstNodeDType* createArray(AstNodeDType* basep, AstRange* rangep, bool isPacked);
-    AstVar*  createVariable(FileLine* fileline, string name, AstRange* arrayp, AstNode* attrsp);
+    AstNodeDType* createArray(AstNodeDType* basep, AstNodeRange* rangep, bool isPacked);
+    AstVar*  createVariable(FileLine* fileline, string name, AstNodeRange* arrayp, AstNode* attrsp);
     AstNode* createSupplyExpr(FileLine* fileline, string name, int value);
     AstText* createTextQuoted(FileLine* fileline, string text) {
 	string newtext = deQuote(fileline, text);
@@ -490,6 +490,7 @@ class AstSenTree;
 %token<fl>		yVL_NO_INLINE_TASK	"/*verilator no_inline_task*/"
 %token<fl>		yVL_SC_BV		"/*verilator sc_bv*/"
 %token<fl>		yVL_SFORMAT		"/*verilator sformat*/"
+%token<fl>		yVL_SPARSE		"/*verilator sparse*/"
 %token<fl>		yVL_PARALLEL_CASE	"/*verilator parallel_case*/"
 %token<fl>		yVL_PUBLIC		"/*verilator public*/"
 %token<fl>		yVL_PUBLIC_FLAT		"/*verilator public_flat*/"
@@ -1432,21 +1433,21 @@ variable_declExpr<nodep>:		// IEEE: part of variable_decl_assignment - rhs of ex
 	//UNSUP	class_new				{ $$ = $1; }
 	;
 
-variable_dimensionListE<rangep>:	// IEEE: variable_dimension + empty
+variable_dimensionListE<noderangep>:	// IEEE: variable_dimension + empty
 		/*empty*/				{ $$ = NULL; }
 	|	variable_dimensionList			{ $$ = $1; }
 	;
 
-variable_dimensionList<rangep>:	// IEEE: variable_dimension + empty
+variable_dimensionList<noderangep>:	// IEEE: variable_dimension + empty
 		variable_dimension			{ $$ = $1; }
-	|	variable_dimensionList variable_dimension	{ $$ = $1->addNext($2)->castRange(); }
+	|	variable_dimensionList variable_dimension	{ $$ = $1->addNext($2)->castNodeRange(); }
 	;
 
-variable_dimension<rangep>:	// ==IEEE: variable_dimension
+variable_dimension<noderangep>:	// ==IEEE: variable_dimension
 	//			// IEEE: unsized_dimension
-	//UNSUP	'[' ']'					{ UNSUP }
+		'[' ']'					{ $$ = new AstUnsizedRange($1); }
 	//			// IEEE: unpacked_dimension
-		anyrange				{ $$ = $1; }
+	|	anyrange				{ $$ = $1; }
 	|	'[' constExpr ']'			{ $$ = new AstRange($1,new AstSub($1,$2, new AstConst($1,1)), new AstConst($1,0)); }
 	//			// IEEE: associative_dimension
 	//UNSUP	'[' data_type ']'			{ UNSUP }
@@ -1913,6 +1914,7 @@ sigAttr<nodep>:
 	|	yVL_ISOLATE_ASSIGNMENTS			{ $$ = new AstAttrOf($1,AstAttrType::VAR_ISOLATE_ASSIGNMENTS); }
 	|	yVL_SC_BV				{ $$ = new AstAttrOf($1,AstAttrType::VAR_SC_BV); }
 	|	yVL_SFORMAT				{ $$ = new AstAttrOf($1,AstAttrType::VAR_SFORMAT); }
+	|	yVL_SPARSE				{ $$ = new AstAttrOf($1,AstAttrType::VAR_SPARSE); }
 	;
 
 rangeListE<rangep>:		// IEEE: [{packed_dimension}]
@@ -3634,26 +3636,36 @@ AstNode* V3ParseGrammar::createSupplyExpr(FileLine* fileline, string name, int v
     return nodep;
 }
 
-AstNodeDType* V3ParseGrammar::createArray(AstNodeDType* basep, AstRange* rangep, bool isPacked) {
+AstNodeDType* V3ParseGrammar::createArray(AstNodeDType* basep, AstNodeRange* nrangep, bool isPacked) {
     // Split RANGE0-RANGE1-RANGE2 into ARRAYDTYPE0(ARRAYDTYPE1(ARRAYDTYPE2(BASICTYPE3),RANGE),RANGE)
     AstNodeDType* arrayp = basep;
-    if (rangep) { // Maybe no range - return unmodified base type
-	while (rangep->nextp()) rangep = rangep->nextp()->castRange();
-	while (rangep) {
-	    AstRange* prevp = rangep->backp()->castRange();
-	    if (prevp) rangep->unlinkFrBack();
-	    if (isPacked) {
+    if (nrangep) { // Maybe no range - return unmodified base type
+	while (nrangep->nextp()) nrangep = nrangep->nextp()->castNodeRange();
+	while (nrangep) {
+	    AstNodeRange* prevp = nrangep->backp()->castNodeRange();
+	    if (prevp) nrangep->unlinkFrBack();
+	    AstRange* rangep = nrangep->castRange();
+	    if (!rangep) {
+		if (!nrangep->castUnsizedRange()) nrangep->v3fatalSrc("Unknown range type");
+		if (isPacked) {
+		    nrangep->v3error("Unsized packed dimension");
+		} else if (prevp || arrayp != basep) {
+		    nrangep->v3error("Unsupported: Unsized array dimension with other unpacked dimensions");
+		}
+		arrayp = new AstUnsizedArrayDType(nrangep->fileline(), VFlagChildDType(), arrayp);
+		nrangep->deleteTree(); nrangep=NULL;
+	    } else if (isPacked) {
 	        arrayp = new AstPackArrayDType(rangep->fileline(), VFlagChildDType(), arrayp, rangep);
 	    } else {
 	        arrayp = new AstUnpackArrayDType(rangep->fileline(), VFlagChildDType(), arrayp, rangep);
 	    }
-	    rangep = prevp;
+	    nrangep = prevp;
 	}
     }
     return arrayp;
 }
 
-AstVar* V3ParseGrammar::createVariable(FileLine* fileline, string name, AstRange* arrayp, AstNode* attrsp) {
+AstVar* V3ParseGrammar::createVariable(FileLine* fileline, string name, AstNodeRange* arrayp, AstNode* attrsp) {
     AstNodeDType* dtypep = GRAMMARP->m_varDTypep;
     UINFO(5,"  creVar "<<name<<"  decl="<<GRAMMARP->m_varDecl<<"  io="<<GRAMMARP->m_varIO<<"  dt="<<(dtypep?"set":"")<<endl);
     if (GRAMMARP->m_varIO == AstVarType::UNKNOWN
@@ -0,0 +1,115 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2013-2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License.
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include "Vt_bench_display.h"
+#include "verilated.h"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <sys/time.h>
+
+// __FILE__ is too long
+#define FILENM "t_bench_display.cpp"
+
+unsigned int main_time = false;
+
+double sc_time_stamp () {
+    return main_time;
+}
+
+static double secs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+// The $sformat in t_bench_display.v, as a format string and as the
+// operations Verilator precompiles it into.  %d is %u as the values are unsigned.
+static const char* s_format = "[%0t] cyc=%11u addr=%x data=%08x state=%s";
+static const VerilatedFormatOp s_ops[] = {
+    {"[",1,'t',true,0,NULL},
+    {"] cyc=",6,'u',false,11,NULL},
+    {" addr=",6,'x',false,-1,NULL},
+    {" data=",6,'x',true,8,NULL},
+    {" state=",7,'s',false,-1,NULL},
+    {"",0,'\0',false,-1,NULL}
+};
+
+struct Values {
+    IData cyc;
+    IData addr;
+    IData data;
+    QData state;
+    explicit Values(int i) {
+	static const QData states[] = { VL_ULL(0x49444c45), VL_ULL(0x52454144), VL_ULL(0x5752495445), VL_ULL(0x574149545f414b) };
+	cyc = i;
+	addr = i * 0x9e3779b9U;
+	data = addr ^ 0x5a5a5a5aU;
+	state = states[i & 3];
+    }
+};
+
+int main(int argc, char **argv, char **env) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::debug(0);
+
+    int calls = 100000;
+    if (const char* argp = Verilated::commandArgsPlusMatch("calls+")) {
+	if (*argp) calls = atoi(argp+strlen("+calls+"));
+    }
+
+    VM_PREFIX* topp = new VM_PREFIX ("");  // Note null name - we're flattening it out
+
+    // The model's output, and both runtime paths, must agree
+    WData strLine[16];
+    WData opsLine[16];
+    for (int i=0; i<1000; i++) {
+	Values v (i);
+	main_time = i*10;
+	topp->cyc = v.cyc;  topp->addr = v.addr;  topp->data = v.data;  topp->state = v.state;
+	topp->clk = 0;
+	topp->eval();
+	topp->clk = 1;
+	topp->eval();
+	VL_SFORMAT_X(512, strLine, s_format, 64, VL_TIME_Q(), 32, v.cyc, 32, v.addr, 32, v.data, 64, v.state);
+	VL_SFORMAT_X(512, opsLine, s_ops, 64, VL_TIME_Q(), 32, v.cyc, 32, v.addr, 32, v.data, 64, v.state);
+	if (0!=memcmp(strLine, topp->line, sizeof(strLine))
+	    || 0!=memcmp(opsLine, topp->line, sizeof(opsLine))) {
+	    vl_fatal(FILENM,__LINE__,"main", "%Error: $sformat paths differ");
+	}
+    }
+
+    double start = secs();
+    for (int i=0; i<calls; i++) {
+	Values v (i);
+	VL_SFORMAT_X(512, strLine, s_format, 64, (QData)i, 32, v.cyc, 32, v.addr, 32, v.data, 64, v.state);
+    }
+    double str = secs() - start;
+    start = secs();
+    for (int i=0; i<calls; i++) {
+	Values v (i);
+	VL_SFORMAT_X(512, opsLine, s_ops, 64, (QData)i, 32, v.cyc, 32, v.addr, 32, v.data, 64, v.state);
+    }
+    double ops = secs() - start;
+
+    VL_PRINTF("-Info: $sformat: %d calls, format string %.0f ns/call, precompiled %.0f ns/call\n",
+	      calls, str*1e9/calls, ops*1e9/calls);
+
+    topp->final();
+    delete topp; topp=NULL;
+    VL_PRINTF("*-* All Finished *-*\n");
+    exit(0L);
+}
@@ -0,0 +1,25 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Outputs
+   line,
+   // Inputs
+   clk, cyc, addr, data, state
+   );
+
+   input clk;
+   input [31:0] cyc;
+   input [31:0] addr;
+   input [31:0] data;
+   input [63:0] state;
+   output reg [8*64-1:0] line;
+
+   // Must match the format t_bench_display.cpp times
+   always @ (posedge clk) begin
+      $sformat(line, "[%0t] cyc=%11d addr=%x data=%08x state=%s", $time, cyc, addr, data, state);
+   end
+
+endmodule
@@ -0,0 +1,54 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+# Preprocess a generated register file, with a `define per register and
+# UVM field-macro style expansions of each.  Use --benchmark to scale the
+# register count; the driver then times the preprocessor run.
+$Self->{regs} = $Self->{benchmark}||0;
+$Self->{regs} = 500 if $Self->{regs}<500;
+
+top_filename("$Self->{obj_dir}/$Self->{name}.v");
+
+{
+    my $fh = IO::File->new(">$Self->{top_filename}") or die "%Error: $! $Self->{top_filename},";
+    $fh->print("// Generated by t_bench_preproc.pl\n");
+    $fh->print("`define FIELD_FLAGS(COPY=UVM_COPY,CMP=UVM_COMPARE) COPY|CMP|UVM_PRINT\n");
+    $fh->print("`define UVM_FIELD(ARG,KIND,FLAG=`FIELD_FLAGS()) \\\n"
+	       ."  begin if (what__ == FLAG) `\"ARG`\"; m_``KIND``_``ARG = ARG; end\n");
+    $fh->print("`define REG_FIELDS(ARG,W=32) `UVM_FIELD(ARG,int) `UVM_FIELD(ARG``_shadow,int,`FIELD_FLAGS(,UVM_NOCOMPARE)) \\\n"
+	       ."  logic [W-1:0] ARG``_q;\n");
+    for (my $i=0; $i<$Self->{regs}; ++$i) {
+	$fh->print("`define REG_${i}_ADDR 'h".sprintf("%x",$i*4)."\n");
+    }
+    $fh->print("module t;\n");
+    for (my $i=0; $i<$Self->{regs}; ++$i) {
+	$fh->print("  `REG_FIELDS(reg_$i,".(8+$i%25).") localparam A$i = `REG_${i}_ADDR;\n");
+    }
+    $fh->print("endmodule\n");
+    $fh->close;
+}
+
+my $stdout_filename = "$Self->{obj_dir}/$Self->{name}__test.vpp";
+
+compile (
+    verilator_flags2 => ['-E'],
+    verilator_make_gcc=>0,
+    stdout_filename => $stdout_filename,
+    );
+
+my $last = $Self->{regs}-1;
+file_grep ($stdout_filename, qr/m_int_reg_${last}_shadow = reg_${last}_shadow;/);
+file_grep ($stdout_filename, qr/UVM_COPY\|UVM_NOCOMPARE\|UVM_PRINT/);
+file_grep ($stdout_filename, qr/logic \[32-1:0\] reg_24_q;/);
+file_grep ($stdout_filename, qr/localparam A$last = 'h@{[sprintf("%x",$last*4)]};/);
+
+ok(1);
+1;
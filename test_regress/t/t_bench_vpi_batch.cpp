@@ -0,0 +1,137 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2013-2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License.
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include "Vt_bench_vpi_batch.h"
+#include "verilated.h"
+
+#include "verilated_vpi.h"
+#include "verilated_vpi.cpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <sys/time.h>
+
+// __FILE__ is too long
+#define FILENM "t_bench_vpi_batch.cpp"
+
+#define SCOPES 64
+#define SIGS (SCOPES*5)
+
+unsigned int main_time = false;
+
+double sc_time_stamp () {
+    return main_time;
+}
+
+static double secs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+static vpiHandle handles[SIGS];
+static int words[SIGS];
+static int total_words = 0;
+static PLI_UINT32* single_bufp;
+static PLI_UINT32* batch_bufp;
+
+static void get_single() {
+    // Per-handle access, as a testbench would without the extension
+    PLI_UINT32* outp = single_bufp;
+    s_vpi_value v;
+    v.format = vpiVectorVal;
+    for (int n=0; n<SIGS; ++n) {
+	vpi_get_value(handles[n], &v);
+	for (int w=0; w<words[n]; ++w) *outp++ = v.value.vector[w].aval;
+    }
+}
+
+static void get_batch() {
+    int got = VerilatedVpi::getValues(SIGS, handles, batch_bufp);
+    if (got != total_words) vl_fatal(FILENM,__LINE__,"main", "%Error: getValues returned wrong size");
+}
+
+int main(int argc, char **argv, char **env) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::debug(0);
+
+    int cycles = 100;
+    if (const char* argp = Verilated::commandArgsPlusMatch("cycles+")) {
+	if (*argp) cycles = atoi(argp+strlen("+cycles+"));
+    }
+
+    VM_PREFIX* topp = new VM_PREFIX ("");  // Note null name - we're flattening it out
+
+    static const char* names[] = {"b7", "b16", "b32", "b61", "b100"};
+    for (int n=0; n<SIGS; ++n) {
+	char buf[100];
+	sprintf(buf, "t.gen[%d].s.%s", n/5, names[n%5]);
+	handles[n] = vpi_handle_by_name((PLI_BYTE8*)buf, NULL);
+	if (!handles[n]) vl_fatal(FILENM,__LINE__,"main", "%Error: Signal not found");
+	words[n] = VL_WORDS_I(vpi_get(vpiSize, handles[n]));
+	total_words += words[n];
+    }
+    single_bufp = new PLI_UINT32 [total_words];
+    batch_bufp = new PLI_UINT32 [total_words];
+
+    topp->clk = 0;
+    topp->eval();
+
+    double single_secs = 0;
+    double batch_secs = 0;
+    for (int cyc=0; cyc<cycles; ++cyc) {
+	topp->clk = !topp->clk;
+	topp->eval();
+	topp->clk = !topp->clk;
+	topp->eval();
+	main_time += 10;
+
+	double start = secs();
+	get_single();
+	single_secs += secs() - start;
+	start = secs();
+	get_batch();
+	batch_secs += secs() - start;
+	if (0 != memcmp(single_bufp, batch_bufp, total_words*sizeof(PLI_UINT32))) {
+	    vl_fatal(FILENM,__LINE__,"main", "%Error: getValues mismatches vpi_get_value");
+	}
+    }
+
+    // Put all ones, which must be masked to each signal's width
+    for (int i=0; i<total_words; ++i) batch_bufp[i] = ~0U;
+    if (VerilatedVpi::putValues(SIGS, handles, batch_bufp) != total_words) {
+	vl_fatal(FILENM,__LINE__,"main", "%Error: putValues returned wrong size");
+    }
+    get_single();
+    VerilatedVpi::getValues(SIGS, handles, batch_bufp);
+    if (0 != memcmp(single_bufp, batch_bufp, total_words*sizeof(PLI_UINT32))) {
+	vl_fatal(FILENM,__LINE__,"main", "%Error: putValues mismatches vpi_get_value");
+    }
+    if (single_bufp[0] != 0x7f  // b7
+	|| single_bufp[words[0]+words[1]+words[2]+words[3]+3] != 0xf) {  // b100 top word
+	vl_fatal(FILENM,__LINE__,"main", "%Error: putValues didn't mask");
+    }
+
+    VL_PRINTF("-Info: %d signals, %d cycles: vpi_get_value %.3f us/cycle, getValues %.3f us/cycle\n",
+	      SIGS, cycles, single_secs*1e6/cycles, batch_secs*1e6/cycles);
+
+    topp->final();
+    delete topp; topp=NULL;
+    delete [] single_bufp;
+    delete [] batch_bufp;
+    VL_PRINTF("*-* All Finished *-*\n");
+    exit(0L);
+}
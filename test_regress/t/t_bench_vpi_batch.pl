@@ -0,0 +1,27 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+$Self->{cycles} = $Self->{benchmark}||0;
+$Self->{cycles} = 100 if $Self->{cycles}<100;
+
+compile (
+	 make_top_shell => 0,
+	 make_main => 0,
+	 verilator_flags2 => ["--exe --no-l2name $Self->{t_dir}/t_bench_vpi_batch.cpp"],
+	 );
+
+execute (
+	 check_finished=>1,
+	 all_run_flags => ["+cycles+$Self->{cycles}"],
+	 );
+
+ok(1);
+1;
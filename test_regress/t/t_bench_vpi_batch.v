@@ -0,0 +1,49 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   reg [31:0] cyc /*verilator public_flat_rd*/;
+   initial cyc = 0;
+   always @(posedge clk) cyc <= cyc + 1;
+
+   genvar i;
+   generate
+      for (i=0; i<64; i=i+1) begin : gen
+	 sub s (.clk(clk), .seed(cyc + i));
+      end
+   endgenerate
+
+endmodule
+
+module sub (/*AUTOARG*/
+   // Inputs
+   clk, seed
+   );
+
+   input clk;
+   input [31:0] seed;
+
+   reg [6:0]   b7   /*verilator public_flat_rw @(posedge clk)*/;
+   reg [15:0]  b16  /*verilator public_flat_rw @(posedge clk)*/;
+   reg [31:0]  b32  /*verilator public_flat_rw @(posedge clk)*/;
+   reg [60:0]  b61  /*verilator public_flat_rw @(posedge clk)*/;
+   reg [99:0]  b100 /*verilator public_flat_rw @(posedge clk)*/;
+
+   // Blocking, as VPI writes to public_flat_rw signals are also blocking
+   always @(posedge clk) begin
+      b7 = seed[6:0];
+      b16 = seed[15:0] ^ 16'h5a5a;
+      b32 = seed * 32'd7;
+      b61 = {seed[28:0], seed};
+      b100 = {seed[3:0], seed, ~seed, seed};
+   end
+
+endmodule
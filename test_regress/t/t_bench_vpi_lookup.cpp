@@ -0,0 +1,95 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2013-2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License.
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include "Vt_bench_vpi_lookup.h"
+#include "verilated.h"
+
+#include "verilated_vpi.h"
+#include "verilated_vpi.cpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <sys/time.h>
+
+// __FILE__ is too long
+#define FILENM "t_bench_vpi_lookup.cpp"
+
+unsigned int main_time = false;
+
+double sc_time_stamp () {
+    return main_time;
+}
+
+static double secs() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec*1e-6;
+}
+
+static int lookups(int scopes, bool check) {
+    // Resolve every signal in the design by full name, once
+    int found = 0;
+    char buf[100];
+    char basename[20];
+    for (int s=0; s<scopes; s++) {
+	for (int n=0; n<16; n++) {
+	    sprintf(buf, "t.gen[%d].s.sig%d", s, n);
+	    vpiHandle vh = vpi_handle_by_name((PLI_BYTE8*)buf, NULL);
+	    if (vh) {
+		sprintf(basename, "sig%d", n);
+		if (check && 0!=strcmp(vpi_get_str(vpiName, vh), basename)) {
+		    vl_fatal(FILENM,__LINE__,"main", "%Error: Lookup returned wrong signal");
+		}
+		++found;
+		vpi_release_handle(vh);
+	    }
+	}
+    }
+    return found;
+}
+
+int main(int argc, char **argv, char **env) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::debug(0);
+
+    int scopes = 64;
+    if (const char* argp = Verilated::commandArgsPlusMatch("scopes+")) {
+	if (*argp) scopes = atoi(argp+strlen("+scopes+"));
+    }
+
+    VM_PREFIX* topp = new VM_PREFIX ("");  // Note null name - we're flattening it out
+    topp->eval();
+
+    // First pass resolves and checks; later passes measure repeated lookups
+    double start = secs();
+    int found = lookups(scopes, true);
+    double first = secs() - start;
+    if (found != scopes*16) {
+	vl_fatal(FILENM,__LINE__,"main", "%Error: Not all signals found by name");
+    }
+    const int passes = 4;
+    start = secs();
+    for (int i=0; i<passes; i++) lookups(scopes, false);
+    double repeat = (secs() - start)/passes;
+
+    VL_PRINTF("-Info: vpi_handle_by_name: %d signals, first pass %.3f s (%.0f/s), repeated %.3f s (%.0f/s)\n",
+	      found, first, found/(first>0?first:1e-9), repeat, found/(repeat>0?repeat:1e-9));
+
+    topp->final();
+    delete topp; topp=NULL;
+    VL_PRINTF("*-* All Finished *-*\n");
+    exit(0L);
+}
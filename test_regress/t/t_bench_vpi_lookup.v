@@ -0,0 +1,34 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t;
+
+   genvar i;
+   generate
+      for (i=0; i<`SCOPES; i=i+1) begin : gen
+	 sub s ();
+      end
+   endgenerate
+
+endmodule
+
+module sub;
+   reg [31:0] sig0  /*verilator public_flat_rw*/;
+   reg [31:0] sig1  /*verilator public_flat_rw*/;
+   reg [31:0] sig2  /*verilator public_flat_rw*/;
+   reg [31:0] sig3  /*verilator public_flat_rw*/;
+   reg [31:0] sig4  /*verilator public_flat_rw*/;
+   reg [31:0] sig5  /*verilator public_flat_rw*/;
+   reg [31:0] sig6  /*verilator public_flat_rw*/;
+   reg [31:0] sig7  /*verilator public_flat_rw*/;
+   reg [31:0] sig8  /*verilator public_flat_rw*/;
+   reg [31:0] sig9  /*verilator public_flat_rw*/;
+   reg [31:0] sig10 /*verilator public_flat_rw*/;
+   reg [31:0] sig11 /*verilator public_flat_rw*/;
+   reg [31:0] sig12 /*verilator public_flat_rw*/;
+   reg [31:0] sig13 /*verilator public_flat_rw*/;
+   reg [31:0] sig14 /*verilator public_flat_rw*/;
+   reg [31:0] sig15 /*verilator public_flat_rw*/;
+endmodule
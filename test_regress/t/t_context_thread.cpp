@@ -0,0 +1,141 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2013-2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License.
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include "Vt_context_thread.h"
+#include "verilated.h"
+
+#include <cstdio>
+#include <cstring>
+#include <pthread.h>
+#include <unistd.h>
+
+// __FILE__ is too long
+#define FILENM "t_context_thread.cpp"
+
+// Compiled with VL_TIME_CONTEXT, so $time comes from each VerilatedContext,
+// and VL_USER_FATAL, so destroying a context in use can be checked
+
+#define CHECK_RESULT(got, exp) \
+    if ((got) != (exp)) { \
+	printf("%%Error: %s:%d: GOT = %lu   EXP = %lu\n", \
+	       FILENM,__LINE__, (unsigned long)(got), (unsigned long)(exp)); \
+	errors++; \
+    }
+
+struct Sim {
+    VerilatedContext	context;
+    int			argc;	// Arguments of this context, if any
+    const char**	argv;
+    unsigned		limit;
+    unsigned		fd;
+    unsigned		tag;
+    bool		scopeOwn;	// Found its model's scope in its own context
+    vluint64_t		endTime;
+    Sim() : argc(0), argv(NULL), limit(0), fd(0), tag(0), scopeOwn(false), endTime(0) {}
+};
+
+static void* simRun(void* datap) {
+    Sim* simp = (Sim*)datap;
+    // Model is bound to the context current when it's constructed
+    Verilated::threadContextp(&simp->context);
+    if (simp->argc) Verilated::commandArgs(simp->argc, simp->argv);
+    // Each context has its own scopes, so both models may have the same name
+    Vt_context_thread* topp = new Vt_context_thread("top");
+    const VerilatedScope* scopep = Verilated::scopeFind("top.t");
+    simp->scopeOwn = scopep && scopep->contextp() == &simp->context;
+    topp->limit = simp->limit;
+    topp->clk = 0;
+    while (!simp->context.gotFinish() && simp->context.time() < 1000) {
+	topp->clk = !topp->clk;
+	topp->eval();
+	simp->context.time(simp->context.time() + 1);
+    }
+    simp->fd = topp->fd_out;
+    simp->tag = topp->tag_out;
+    simp->endTime = simp->context.time();
+    topp->final();
+    delete topp; topp = NULL;
+    return NULL;
+}
+
+//======================================================================
+// Destroying a context another thread has selected is fatal
+
+static pthread_mutex_t holdMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t holdCond = PTHREAD_COND_INITIALIZER;
+static bool holdReady = false;
+static int errors = 0;
+
+static void* holdRun(void* datap) {
+    Verilated::threadContextp((VerilatedContext*)datap);
+    pthread_mutex_lock(&holdMutex);
+    holdReady = true;
+    pthread_cond_broadcast(&holdCond);
+    while (1) pthread_cond_wait(&holdCond, &holdMutex);  // Keep it selected until exit
+    return NULL;
+}
+
+void vl_fatal(const char* filename, int linenum, const char* hier, const char* msg) {
+    if (0==strcmp(msg, "VerilatedContext destroyed while another thread still has it selected")
+	&& !errors) {
+	printf("*-* All Finished *-*\n");
+	fflush(stdout);
+	_exit(0);
+    }
+    printf("%%Error: %s:%d: %s\n", filename, linenum, msg);
+    fflush(stdout);
+    _exit(10);
+}
+
+//======================================================================
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+
+    Sim sims[2];
+    static const char* sim0Argv[] = {"sim0", "+tag+5"};
+    sims[0].argc = 2;  sims[0].argv = sim0Argv;
+    sims[0].limit = 10;
+    sims[1].limit = 40;	// Uses the default context's arguments
+    pthread_t threads[2];
+    for (int i=0; i<2; i++) pthread_create(&threads[i], NULL, &simRun, &sims[i]);
+    for (int i=0; i<2; i++) pthread_join(threads[i], NULL);
+
+    // Each $finish stopped only its own simulation
+    for (int i=0; i<2; i++) CHECK_RESULT(sims[i].context.gotFinish(), true);
+    CHECK_RESULT(sims[0].endTime < sims[1].endTime, true);
+    CHECK_RESULT(sims[1].endTime < 1000, true);
+    CHECK_RESULT(Verilated::gotFinish(), false);
+    // Each simulation numbers its own file descriptors
+    CHECK_RESULT(sims[0].fd, sims[1].fd);
+    // And has its own arguments and scopes
+    CHECK_RESULT(sims[0].tag, 5);
+    CHECK_RESULT(sims[1].tag, 9);
+    CHECK_RESULT(sims[0].scopeOwn, true);
+    CHECK_RESULT(sims[1].scopeOwn, true);
+    // Models are deleted, so no scopes remain in the thread's context
+    CHECK_RESULT(Verilated::scopeFind("top.t") == NULL, true);
+
+    // Finishes in vl_fatal above
+    VerilatedContext* holdp = new VerilatedContext;
+    pthread_t holdThread;
+    pthread_create(&holdThread, NULL, &holdRun, holdp);
+    pthread_mutex_lock(&holdMutex);
+    while (!holdReady) pthread_cond_wait(&holdCond, &holdMutex);
+    pthread_mutex_unlock(&holdMutex);
+    delete holdp;
+    printf("%%Error: Destroying a context still selected by another thread wasn't fatal\n");
+    return 10;
+}
@@ -0,0 +1,28 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+compile (
+	 make_top_shell => 0,
+	 make_main => 0,
+	 verilator_flags2 => ["-CFLAGS '-DVL_THREADED -DVL_TIME_CONTEXT -DVL_USER_FATAL' -LDFLAGS -pthread",
+			      "--exe --no-l2name $Self->{t_dir}/t_context_thread.cpp"],
+	 );
+
+execute (
+	 check_finished=>1,
+	 all_run_flags => ["+tag+9"],
+	 );
+
+file_grep ("$Self->{obj_dir}/t_context_thread_10.log", qr/cyc 9\n$/);
+file_grep ("$Self->{obj_dir}/t_context_thread_40.log", qr/cyc 39\n$/);
+
+ok(1);
+1;
@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Outputs
+   fd_out, tag_out,
+   // Inputs
+   clk, limit
+   );
+
+   input clk;
+   input [31:0] limit;
+   output [31:0] fd_out;
+   output [31:0] tag_out;
+
+   integer cyc /*verilator public_flat_rd*/ = 0;
+   integer tag = 0;
+   integer fd = 0;
+   reg [64*8:1] filename;
+
+   assign fd_out = fd;
+   assign tag_out = tag;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc == 0) begin
+	 $sformat(filename, "obj_dir/t_context_thread/t_context_thread_%0d.log", limit);
+	 fd = $fopen(filename, "w");
+	 // Each context has its own arguments
+	 if ($value$plusargs("tag+%d", tag) == 0) tag = -1;
+      end
+      else if (cyc < limit) begin
+	 $fwrite(fd, "cyc %0d\n", cyc);
+      end
+      else if (cyc == limit) begin
+	 $fclose(fd);
+	 $finish;
+      end
+   end
+endmodule
@@ -18,16 +18,34 @@ module t (/*AUTOARG*/
       logic b;
    } str_t;
 
+   typedef struct packed {
+      logic a;
+      logic b;
+   } pair_t;
+
    reg 	 toggle; initial toggle='0;
 
    str_t stoggle; initial stoggle='0;
+   // CHECK_COVER(-1,"top.v","stoggle.u.ua",2)
+   // CHECK_COVER(-2,"top.v","stoggle.b",2)
 
    const reg aconst = '0;
 
    reg [1:0][1:0] ptoggle; initial ptoggle=0;
+   // CHECK_COVER(-1,"top.v","ptoggle[0][0]",2)
+   // CHECK_COVER(-2,"top.v","ptoggle[0][1]",0)
+   // CHECK_COVER(-3,"top.v","ptoggle[1][0]",0)
 
    integer cyc; initial cyc=1;
    wire [7:0] cyc_copy = cyc[7:0];
+
+   // Same value, but buckets in a different bit order, so not joined
+   wire [1:0] cyc_pair = cyc[1:0];
+   // CHECK_COVER(-1,"top.v","cyc_pair[0]",11)
+   // CHECK_COVER(-2,"top.v","cyc_pair[1]",5)
+   pair_t cyc_str; always @* cyc_str = cyc[1:0];
+   // CHECK_COVER(-1,"top.v","cyc_str.a",5)
+   // CHECK_COVER(-2,"top.v","cyc_str.b",11)
    wire       toggle_up;
 
    alpha a1 (/*AUTOINST*/
@@ -56,6 +74,9 @@ module t (/*AUTOARG*/
 	     .toggle			(toggle));
 
    reg [1:0]  memory[121:110];
+   // CHECK_COVER(-1,"top.v","memory[110][0]",1)
+   // CHECK_COVER(-2,"top.v","memory[110][1]",0)
+   // CHECK_COVER(-3,"top.v","memory[111][0]",0)
 
    reg [1023:0] largeish;
    // CHECK_COVER_MISSING(-1)
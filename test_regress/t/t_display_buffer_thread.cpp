@@ -0,0 +1,66 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2013-2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License.
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include "Vt_display_buffer_thread.h"
+#include "verilated.h"
+
+#include <cstdio>
+#include <pthread.h>
+
+// Compiled with VL_DISPLAY_BUFFERING=VL_DISPLAY_LINE, so each context's
+// lines are written whole; t_display_buffer_thread.pl checks the log
+
+struct Sim {
+    VerilatedContext	context;
+    unsigned		id;
+    Sim() : id(0) {}
+};
+
+static void* simRun(void* datap) {
+    Sim* simp = (Sim*)datap;
+    Verilated::threadContextp(&simp->context);
+    Vt_display_buffer_thread* topp = new Vt_display_buffer_thread("top");
+    topp->id = simp->id;
+    topp->clk = 0;
+    while (!simp->context.gotFinish() && simp->context.time() < 1000) {
+	topp->clk = !topp->clk;
+	topp->eval();
+	simp->context.time(simp->context.time() + 1);
+    }
+    topp->final();
+    delete topp; topp = NULL;
+    return NULL;
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+
+    Sim sims[2];
+    pthread_t threads[2];
+    for (int i=0; i<2; i++) {
+	sims[i].id = i;
+	pthread_create(&threads[i], NULL, &simRun, &sims[i]);
+    }
+    for (int i=0; i<2; i++) pthread_join(threads[i], NULL);
+
+    for (int i=0; i<2; i++) {
+	if (!sims[i].context.gotFinish()) {
+	    printf("%%Error: Simulation %d didn't finish\n", i);
+	    return 10;
+	}
+    }
+    printf("*-* All Finished *-*\n");
+    return 0;
+}
@@ -0,0 +1,45 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+compile (
+	 make_top_shell => 0,
+	 make_main => 0,
+	 verilator_flags2 => ["-CFLAGS '-DVL_THREADED -DVL_TIME_CONTEXT -DVL_DISPLAY_BUFFERING=VL_DISPLAY_LINE' -LDFLAGS -pthread",
+			      "--exe $Self->{t_dir}/t_display_buffer_thread.cpp"],
+	 );
+
+execute (
+	 check_finished=>1,
+	 );
+
+# Both contexts' lines are whole and in order, including a $write of a NUL
+my $text = file_contents("$Self->{obj_dir}/vlt_sim.log");
+my $chars = "abcdefghijklmnopqrstuvwxyz0123456789" x 4;
+my @next = (0, 0);
+my @nul = (0, 0);
+foreach my $line (split /\n/, $text) {
+    next if $line !~ /\[ctx/;
+    if ($line =~ /^\[ctx ([01])\] line (\d+) \Q$chars\E$/ && $2 == $next[$1]) {
+	$next[$1]++;
+    } elsif ($line =~ /^\[ctx ([01])\] nul <\0> end$/) {
+	$nul[$1]++;
+    } else {
+	$Self->error("Split or out of order line: $line");
+	last;
+    }
+}
+foreach my $id (0, 1) {
+    $next[$id] == 200 or $Self->error("Context $id wrote $next[$id] of 200 lines");
+    $nul[$id] == 1 or $Self->error("Context $id's line with a NUL is missing");
+}
+
+ok(1);
+1;
@@ -0,0 +1,29 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk, id
+   );
+
+   input clk;
+   input [31:0] id;
+
+   integer cyc = 0;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc < 200) begin
+	 // Long enough that an unbuffered line may be split by the other thread
+	 $display("[ctx %0d] line %0d %s%s%s%s", id, cyc,
+		  "abcdefghijklmnopqrstuvwxyz0123456789", "abcdefghijklmnopqrstuvwxyz0123456789",
+		  "abcdefghijklmnopqrstuvwxyz0123456789", "abcdefghijklmnopqrstuvwxyz0123456789");
+      end
+      else begin
+	 $write("[ctx %0d] nul <%c> end\n", id, 8'h0);
+	 $finish;
+      end
+   end
+endmodule
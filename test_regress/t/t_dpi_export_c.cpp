@@ -26,7 +26,11 @@
 //======================================================================
 
 #if defined(VERILATOR)
-# include "Vt_dpi_export__Dpi.h"
+# ifdef T_DPI_EXPORT_STATIC
+#  include "Vt_dpi_export_static__Dpi.h"
+# else
+#  include "Vt_dpi_export__Dpi.h"
+# endif
 #elif defined(VCS)
 # include "../vc_hdrs.h"
 #elif defined(CADENCE)
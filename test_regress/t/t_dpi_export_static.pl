@@ -0,0 +1,27 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+top_filename("t/t_dpi_export.v");
+
+compile (
+	 v_flags2 => ["t/t_dpi_export_c.cpp"],
+	 verilator_flags2 => ["-Wall -Wno-DECLFILENAME -no-l2name --dpi-static-dispatch"],
+	 );
+
+if ($Self->{vlt}) {
+    # Exports declared in one instance call straight through
+    file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/__Vdpiexp_\w*dpix_int123\w*\(vlSymsp/);
+}
+
+execute (
+	 check_finished=>1,
+     );
+
+ok(1);
+1;
@@ -0,0 +1,47 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Copyright 2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+
+module t (/*AUTOARG*/);
+
+   // Open array arguments reference the caller's storage directly
+   import "DPI-C" function int dpii_sum_byte (input bit [7:0] a[]);
+   import "DPI-C" function void dpii_fill_int (output int a[], input int seed);
+   import "DPI-C" function void dpii_incr_wide (inout bit [69:0] a[]);
+   import "DPI-C" function int dpii_bounds (input int a[]);
+
+   bit [7:0]  b8 [0:9];
+   bit [7:0]  b8r [19:12];
+   int 	      i32 [3:0];
+   bit [69:0] w70 [1:2];
+
+   int        sum;
+   integer    i;
+
+   initial begin
+      for (i=0; i<10; i=i+1) b8[i] = i[7:0] + 8'd1;
+      for (i=12; i<20; i=i+1) b8r[i] = 8'd2;
+      sum = dpii_sum_byte(b8);
+      if (sum != 55) $stop;
+      sum = dpii_sum_byte(b8r);
+      if (sum != 16) $stop;
+
+      dpii_fill_int(i32, 100);
+      if (i32[0] != 100) $stop;
+      if (i32[3] != 103) $stop;
+      if (dpii_bounds(i32) != 'h1301) $stop;
+
+      w70[1] = {6'h3f, 64'hffffffff_ffffffff};
+      w70[2] = 70'h5;
+      dpii_incr_wide(w70);
+      if (w70[1] != 70'h0) $stop;
+      if (w70[2] != 70'h6) $stop;
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+
+endmodule
@@ -0,0 +1,20 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+compile (
+	 v_flags2 => ["--lint-only"],
+	 fails=>$Self->{v3},
+	 expect=>
+'%Error: t/t_dpi_open_bad.v:\d+: Unsupported: Unsized array dimension except on DPI import arguments: notdpi
+%Error: t/t_dpi_open_bad.v:\d+: Open array argument \'a\' requires 8 bit elements, but connection\'s elements are 16 bits.
+%Error: Exiting due to .*'
+	 );
+
+ok(1);
+1;
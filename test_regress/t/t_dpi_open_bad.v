@@ -0,0 +1,20 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// Copyright 2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+
+module t ();
+
+   bit [7:0] notdpi [];
+
+   import "DPI-C" function int dpii_sum_byte (input bit [7:0] a[]);
+
+   bit [15:0] b16 [0:3];
+
+   initial begin
+      if (dpii_sum_byte(b16) != 0) $stop;
+   end
+
+endmodule
@@ -0,0 +1,77 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2013-2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include <cstdio>
+#include <cstring>
+#include "svdpi.h"
+
+//======================================================================
+
+#if defined(VERILATOR)
+# include "Vt_dpi_open__Dpi.h"
+#elif defined(VCS)
+# include "../vc_hdrs.h"
+#elif defined(CADENCE)
+# define NEED_EXTERNS
+#else
+# error "Unknown simulator for DPI test"
+#endif
+
+#ifdef NEED_EXTERNS
+extern "C" {
+    extern int dpii_sum_byte (const svOpenArrayHandle a);
+    extern void dpii_fill_int (const svOpenArrayHandle a, int seed);
+    extern void dpii_incr_wide (const svOpenArrayHandle a);
+    extern int dpii_bounds (const svOpenArrayHandle a);
+}
+#endif
+
+//======================================================================
+
+int dpii_sum_byte (const svOpenArrayHandle a) {
+    // Walk the array's storage directly
+    int sum = 0;
+    for (int i=svLow(a,1); i<=svHigh(a,1); ++i) {
+	sum += *((unsigned char*)svGetArrElemPtr1(a, i));
+    }
+    return sum;
+}
+
+void dpii_fill_int (const svOpenArrayHandle a, int seed) {
+    int* datap = (int*)svGetArrayPtr(a);
+    if (svSizeOfArray(a) != 4*sizeof(int)) {
+	printf("%%Error: svSizeOfArray = %d\n", svSizeOfArray(a));
+	return;
+    }
+    for (int i=svLow(a,1); i<=svHigh(a,1); ++i) {
+	*((int*)svGetArrElemPtr1(a, i)) = seed + i;
+    }
+    if (datap != svGetArrElemPtr1(a, svLow(a,1))) printf("%%Error: svGetArrayPtr mismatch\n");
+}
+
+void dpii_incr_wide (const svOpenArrayHandle a) {
+    for (int i=svLow(a,1); i<=svHigh(a,1); ++i) {
+	svBitVecVal v[3];
+	svGetBitArrElem1VecVal(v, a, i);
+	// 70-bit increment
+	if (++v[0] == 0) if (++v[1] == 0) ++v[2];
+	svPutBitArrElem1VecVal(a, v, i);
+    }
+}
+
+int dpii_bounds (const svOpenArrayHandle a) {
+    return ((svDimensions(a) << 12) | (svLeft(a,1) << 8)
+	    | (svRight(a,1) << 4) | (svIncrement(a,1) & 0xf));
+}
@@ -0,0 +1,53 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+top_filename("t/t_inst_tree.v");
+
+my @v_flags2 = ('+define+NOUSE_INLINE', '+define+NOUSE_PUBLIC');
+my $serial_dir = "$Self->{obj_dir}_jobs1";
+
+if ($Self->{vlt}) {
+    # Reference output from a single job, into its own directory
+    mkdir $serial_dir;
+    my @cmdargs = $Self->compile_vlt_flags
+	(v_flags2 => \@v_flags2,
+	 verilator_flags => ["-cc", "-Mdir", $serial_dir, "-OD", "--debug-check"],
+	 verilator_flags2 => ["--build-jobs 1 --output-split 1 --trace"],
+	);
+    $Self->_run(logfile=>"${serial_dir}/vlt_compile.log",
+		cmd=>\@cmdargs);
+}
+
+compile (
+	 v_flags2 => \@v_flags2,
+	 verilator_flags2 => ["--build-jobs 4 --output-split 1 --trace --stats"],
+	 );
+
+if ($Self->{vlt}) {
+    file_grep ($Self->{stats}, qr/Emission, wall time \(ms\)\s+(\d+)/i);
+    file_grep ("$Self->{obj_dir}/V$Self->{name}_classes.mk", qr/V$Self->{name}__Trace__Slow/);
+
+    # Output must not depend on the number of jobs
+    my @files = map { s!.*/!!; $_ } glob("$serial_dir/*.cpp $serial_dir/*.h");
+    @files or $Self->error("No output files found in $serial_dir\n");
+    foreach my $file (@files) {
+	files_identical("$serial_dir/$file", "$Self->{obj_dir}/$file")
+	    or $Self->error("--build-jobs 4 output differs: $file\n");
+    }
+}
+
+execute (
+	 check_finished=>1,
+	 expect=>
+'\] (%m|.*v\.ps): Clocked
+',
+     );
+
+ok(1);
+1;
@@ -0,0 +1,46 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+my $serial_dir = "$Self->{obj_dir}_jobs1";
+
+if ($Self->{vlt}) {
+    # Reference output from a single job, into its own directory
+    mkdir $serial_dir;
+    my @cmdargs = $Self->compile_vlt_flags
+	(verilator_flags => ["-cc", "-Mdir", $serial_dir, "-OD", "--debug-check"],
+	 verilator_flags2 => ["--build-jobs 1 --stats"],
+	);
+    $Self->_run(logfile=>"${serial_dir}/vlt_compile.log",
+		cmd=>\@cmdargs);
+}
+
+compile (
+	 verilator_flags2 => ["--build-jobs 4 --stats"],
+	 );
+
+if ($Self->{vlt}) {
+    # Case, Localize, Premit and Expand run a job per module
+    file_grep ($Self->{stats}, qr/Optimizations, Cases parallelized\s+([1-9]\d*)/i);
+    file_grep ($Self->{stats}, qr/Optimizations, Cases complex\s+([1-9]\d*)/i);
+
+    # Output must not depend on the number of jobs
+    my @files = map { s!.*/!!; $_ } glob("$serial_dir/*.cpp $serial_dir/*.h");
+    @files or $Self->error("No output files found in $serial_dir\n");
+    foreach my $file (@files) {
+	files_identical("$serial_dir/$file", "$Self->{obj_dir}/$file")
+	    or $Self->error("--build-jobs 4 output differs: $file\n");
+    }
+}
+
+execute (
+	 check_finished=>1,
+     );
+
+ok(1);
+1;
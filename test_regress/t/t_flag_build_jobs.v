@@ -0,0 +1,107 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+   integer cyc=0;
+   reg [63:0] crc;
+   reg [63:0] sum;
+
+   wire [127:0] in = {crc, ~crc};
+   wire [7:0]	sel = crc[7:0];
+
+   wire [127:0] out0, out1, out2, out3;
+   wire [7:0]	code0, code1, code2, code3;
+
+   // Each parameter value is a module of its own, so a job of its own
+   sub #(.P(0)) s0 (.out(out0), .code(code0), .clk(clk), .in(in), .sel(sel));
+   sub #(.P(1)) s1 (.out(out1), .code(code1), .clk(clk), .in(in), .sel(sel));
+   sub #(.P(2)) s2 (.out(out2), .code(code2), .clk(clk), .in(in), .sel(sel));
+   sub #(.P(3)) s3 (.out(out3), .code(code3), .clk(clk), .in(in), .sel(sel));
+
+   // Aggregate outputs into a single result vector; s0.acc is read through
+   // another scope, so can't be made local to its module's function
+   wire [63:0] result = (out0[63:0] ^ out1[127:64] ^ out2[95:32] ^ out3[63:0]
+			 ^ {code0, code1, code2, code3, s0.acc});
+
+   // Test loop
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x result=%x\n",$time, cyc, crc, result);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      sum <= result ^ {sum[62:0],sum[63]^sum[2]^sum[0]};
+      if (cyc==0) begin
+	 // Setup
+	 crc <= 64'h5aef0c8d_d70a4497;
+	 sum <= 64'h0;
+      end
+      else if (cyc<10) begin
+	 sum <= 64'h0;
+      end
+      else if (cyc<90) begin
+      end
+      else if (cyc==99) begin
+	 $write("[%0t] cyc==%0d crc=%x sum=%x\n",$time, cyc, crc, sum);
+	 if (crc !== 64'hc77bb9b3784ea091) $stop;
+	 // What checksum will we end up with (above print should match)
+`define EXPECTED_SUM 64'ha659038bd0a03ccf
+	 if (sum !== `EXPECTED_SUM) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
+
+module sub (/*AUTOARG*/
+   // Outputs
+   out, code,
+   // Inputs
+   clk, in, sel
+   );
+   /*verilator no_inline_module*/
+   parameter P = 0;
+
+   input clk;
+   input [127:0] in;
+   input [7:0]	 sel;
+   output reg [127:0] out;
+   output reg [7:0]   code;
+
+   reg [31:0]	 acc;
+   reg [127:0]	 wtemp;
+
+   always @ (posedge clk) begin
+      // Wide temporaries and operators, for Premit and Expand
+      wtemp = (in << P) ^ {in[63:0], in[127:64]};
+      out <= wtemp + {in[31:0], in[127:32]};
+      acc <= acc + (in[31:0] ^ P);
+      // Fully covered case, made into a tree of ifs
+      case (sel[3:0] ^ P[3:0])
+	4'h0, 4'h8: code <= 8'h11;
+	4'h1: code <= 8'h23;
+	4'h2: code <= 8'h35;
+	4'h3: code <= 8'h47;
+	4'h4: code <= 8'h59;
+	4'h5, 4'hd: code <= 8'h6b;
+	4'h6: code <= 8'h7d;
+	default: code <= {sel[6:0], 1'b1};
+      endcase
+      // Case with wildcards, made into a chain of ifs
+      casez (sel)
+	8'b1???_0001: acc[7:0] <= 8'h01;
+	8'b01??_??10: acc[7:0] <= 8'h02;
+	8'b001?_?1??: acc[7:0] <= P;
+	default: ;
+      endcase
+   end
+
+endmodule
@@ -0,0 +1,41 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_flag_skipidentical.v");
+
+{
+    compile (
+	verilator_flags2 => ["--incremental"],
+	);
+
+    my $outfile = "$Self->{obj_dir}/V".$Self->{name}.".cpp";
+    my @oldstats = stat($outfile);
+    print "Old mtime=",$oldstats[9],"\n";
+    $oldstats[9] or $Self->error("No output file found: $outfile\n");
+    file_grep ("$Self->{obj_dir}/V$Self->{name}__verHash.dat", qr/V$Self->{name}\.cpp/);
+
+    sleep (1);  # Or else it might take < 1 second to compile and see no diff.
+
+    # Different command line, so not skipped as identical, but same output
+    compile (
+	verilator_flags2 => ["--incremental --stats -Wno-WIDTH"],
+	);
+
+    my @newstats = stat($outfile);
+    print "New mtime=",$newstats[9],"\n";
+
+    ($oldstats[9] == $newstats[9])
+	or $Self->error("--incremental rewrote an unchanged file\n");
+    file_grep ($Self->{stats}, qr/Emission, files unchanged\s+[1-9]/i);
+}
+
+ok(1);
+1;
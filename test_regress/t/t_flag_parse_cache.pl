@@ -0,0 +1,40 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_pp_lib.v");
+
+{
+    # Start from an empty cache; --no-skip-identical below as otherwise
+    # a rerun of an unchanged model wouldn't rewrite the statistics
+    unlink(glob("$Self->{obj_dir}/*__verParse_*.dat"));
+    compile (
+	v_flags2 => ['-v', 't/t_pp_lib_library.v'],
+	verilator_flags2 => ["--parse-cache --stats --no-skip-identical"],
+	);
+    # Kept under another name, as file_grep caches each file's contents
+    rename($Self->{stats}, "$Self->{obj_dir}/first__stats.txt");
+    file_grep ("$Self->{obj_dir}/first__stats.txt", qr/Parse cache, misses\s+[1-9]/i);
+
+    # Same command line, so the cached preprocessor output and the
+    # defines from t_pp_lib_inc.vh are used
+    compile (
+	v_flags2 => ['-v', 't/t_pp_lib_library.v'],
+	verilator_flags2 => ["--parse-cache --stats --no-skip-identical"],
+	);
+    file_grep ($Self->{stats}, qr/Parse cache, hits\s+[1-9]/i);
+
+    execute (
+	check_finished=>1,
+	);
+}
+
+ok(1);
+1;
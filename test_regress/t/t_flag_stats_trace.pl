@@ -0,0 +1,26 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_flag_skipidentical.v");
+
+compile (
+    verilator_flags2 => ["--stats-trace"],
+    );
+
+file_grep ($Self->{stats}, qr/Pass Statistics/);
+file_grep ($Self->{stats}, qr/^\s+\d+_linkparse\s+\d+\s+\d+/m);
+file_grep ($Self->{stats}, qr/^\s+\d+_const\s+\d+\s+\d+/m);
+file_grep ($Self->{stats}, qr/^\s+Total\s+\d+\s+\d+/m);
+file_grep ("$Self->{obj_dir}/V$Self->{name}__stats_trace.json", qr/"traceEvents"/);
+file_grep ("$Self->{obj_dir}/V$Self->{name}__stats_trace.json", qr/"name": "emit", "cat": "pass", "ph": "X"/);
+
+ok(1);
+1;
@@ -0,0 +1,30 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{verilated_randReset} = 1;
+
+compile (
+    verilator_flags2 => ["--stats"],
+    );
+
+if ($Self->{vlt}) {
+    file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/VL_RAND_RESET_ARRAY\(7,/);
+    file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/VL_RAND_RESET_ARRAY_W\(70,/);
+    file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/VL_RAND_RESET_RUN\(7, __Vresetps, 3\)/);
+    file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/VL_RAND_RESET_RUN\(48, __Vresetps, 2\)/);
+    file_grep ($Self->{stats}, qr/Reset, arrays in one call\s+(\d+)/i, 5);
+    file_grep ($Self->{stats}, qr/Reset, scalar runs in one call\s+(\d+)/i, 2);
+}
+
+execute (
+    check_finished=>1,
+    );
+
+ok(1);
+1;
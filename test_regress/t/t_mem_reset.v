@@ -0,0 +1,56 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc=0;
+
+   // Reset with verilated_randReset=1, so everything starts as all ones
+   reg [6:0]	m7  [3:0][1:0];
+   reg [15:0]	m16 [7:0];
+   reg [31:0]	m32 [2:0];
+   reg [47:0]	m48 [2:0];
+   reg [69:0]	m70 [2:0][1:0];
+   // Same width scalars next to each other are reset as a run
+   reg [6:0]	s7a, s7b, s7c;
+   reg [47:0]	s48a, s48b;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc==1) begin
+	 if (m7[3][1] !== 7'h7f) $stop;
+	 if (m7[0][0] !== 7'h7f) $stop;
+	 if (m16[7] !== 16'hffff) $stop;
+	 if (m32[1] !== 32'hffffffff) $stop;
+	 if (m48[2] !== 48'hffff_ffffffff) $stop;
+	 if (m70[2][1] !== 70'h3f_ffffffff_ffffffff) $stop;
+	 if (m70[0][0] !== 70'h3f_ffffffff_ffffffff) $stop;
+	 if (s7a !== 7'h7f || s7b !== 7'h7f || s7c !== 7'h7f) $stop;
+	 if (s48a !== 48'hffff_ffffffff || s48b !== 48'hffff_ffffffff) $stop;
+      end
+      else if (cyc==2) begin
+	 m7[cyc[1:0]][cyc[0]] <= 7'h0;
+	 m16[cyc[2:0]] <= 16'h0;
+	 m32[cyc[1:0]] <= 32'h0;
+	 m48[cyc[1:0]] <= 48'h0;
+	 m70[cyc[1:0]][cyc[0]] <= 70'h0;
+	 s7b <= 7'h0;
+	 s48a <= 48'h0;
+      end
+      else if (cyc==3) begin
+	 if (m7[2][0] !== 7'h0) $stop;
+	 if (m70[2][0] !== 70'h0) $stop;
+	 if (m70[2][1] !== 70'h3f_ffffffff_ffffffff) $stop;
+	 if (s7a !== 7'h7f || s7b !== 7'h0 || s7c !== 7'h7f) $stop;
+	 if (s48a !== 48'h0 || s48b !== 48'hffff_ffffffff) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,26 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+compile (
+    verilator_flags2 => ["--sparse-memory 256"],
+    );
+
+if ($Self->{vlt}) {
+    file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VL_SPARSE\(v__DOT__dram,67108864,/);
+    file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VL_SPARSEW\(v__DOT__hex,16,/);
+    # Reads mustn't allocate pages
+    file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.cpp", qr/v__DOT__dram\.read\(0x3ffffff\)/);
+}
+
+execute (
+    check_finished=>1,
+    );
+
+ok(1);
+1;
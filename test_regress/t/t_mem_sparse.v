@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   // 256MB if stored densely
+   reg [31:0]  dram [0:(1<<26)-1] /*verilator sparse*/;
+   // Sparse as over --sparse-memory
+   reg [175:0] hex [0:15];
+
+   integer     cyc=0;
+   reg [25:0]  addr;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      addr <= {cyc[9:0], 16'h0} ^ 26'h2aaaaaa;
+      if (cyc < 10) begin
+	 dram[addr] <= {6'h0, addr};
+      end
+      else if (cyc == 10) begin
+	 $readmemh("t/t_sys_readmem_h.mem", hex, 0);
+	 if (dram[26'h3ffffff] != 32'h0) $stop;
+      end
+      else if (cyc < 20) begin
+	 // Readback what cycles 0-9 wrote, addr is one cycle behind cyc
+	 if (cyc > 10 && dram[{cyc[9:0] - 10'd11, 16'h0} ^ 26'h2aaaaaa]
+	     != {6'h0, {cyc[9:0] - 10'd11, 16'h0} ^ 26'h2aaaaaa}) $stop;
+      end
+      else if (cyc == 20) begin
+	 if (hex['h04] != 176'h400437654321276543211765432107654321abcdef10) $stop;
+	 if (hex['h0c] != 176'h400c37654321276543211765432107654321abcdef13) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule
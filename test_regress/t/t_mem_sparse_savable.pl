@@ -0,0 +1,36 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_mem_sparse.v");
+
+compile (
+    v_flags2 => ["--savable --sparse-memory 256"],
+    save_time => 60,
+    );
+
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VL_SPARSE\(v__DOT__dram,67108864,/);
+
+# Save after some dram writes, before they're read back
+execute (
+    check_finished=>0,
+    all_run_flags => ['+save_time=60'],
+    );
+
+-r "$Self->{obj_dir}/saved.vltsv" or $Self->error("Saved.vltsv not created\n");
+
+# The readback checks the restored entries
+execute (
+    all_run_flags => ['+save_restore=1'],
+    check_finished=>1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,29 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_mem_sparse.v");
+
+compile (
+    verilator_flags2 => ["--trace --sparse-memory 256"],
+    );
+
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/VL_SPARSEW\(v__DOT__hex,16,/);
+
+execute (
+    check_finished=>1,
+    );
+
+# Same as the trace with hex stored densely
+vcd_identical ("$Self->{obj_dir}/simx.vcd",
+	       "t/$Self->{name}.out");
+
+ok(1);
+1;
@@ -0,0 +1,49 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+`undefineall
+
+// Pasting around arguments
+`define PASTE(a,b) a``b
+`define PFX(p) p``_sig
+`define SFX(s) sig_``s
+'`PASTE(foo,bar)'
+'`PFX(my)'
+'`SFX(q)'
+'`PASTE(`PFX(x),_1)'
+
+// Arguments with defaults
+`define DEF(a=1,b=(2+3),c=) {a,b,c}
+'`DEF()'
+'`DEF(,,)'
+'`DEF(7)'
+'`DEF(7,8)'
+'`DEF(,8,9)'
+
+// Nested expansion
+`define INNER(x) (x*2)
+`define MIDDLE(y) `INNER(y+1)
+`define OUTER(z,w=`INNER(3)) `MIDDLE(z) + w
+'`OUTER(4)'
+'`OUTER(4,5)'
+'`OUTER(`INNER(1),`MIDDLE(2))'
+
+// Argument names that are prefixes of body identifiers, and repeated uses
+`define REP(a,ab) a ab a_b ab``a a
+'`REP(X,Y)'
+
+// Redefinition and undef drop the earlier parse
+`define REDEF(a) first a
+'`REDEF(1)'
+`undef REDEF
+`define REDEF(a,b) second a b
+'`REDEF(1,2)'
+`ifdef REDEF 'defined' `endif
+
+// UVM field-macro style body
+`define FIELD(ARG,FLAG=UVM_ALL_ON,KIND=int,NAME="f") \
+  begin if (what == FLAG) `uvm_``KIND``_field(ARG, NAME) end
+'`FIELD(addr)'
+'`FIELD(data, UVM_NOCOPY, string)'
@@ -0,0 +1,27 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+top_filename("t/t_alw_split.v");
+
+compile (
+    verilator_flags2 => ["--stats"],
+    );
+
+if ($Self->{vlt}) {
+    file_grep ($Self->{stats}, qr/Node bytes, VAR\s+(\d+)/i);
+    file_grep ($Self->{stats}, qr/Node memory, arena bytes\s+(\d+)/i);
+    file_grep ($Self->{stats}, qr/Node memory, live bytes\s+(\d+)/i);
+}
+
+execute (
+    check_finished=>1,
+    );
+
+ok(1);
+1;
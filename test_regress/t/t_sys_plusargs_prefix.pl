@@ -0,0 +1,22 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+compile (
+	 );
+
+my $long = "L" x 299;
+execute (
+	 check_finished=>1,
+	 # Plusargs out of sorted order, so the earliest match is not the sorted first
+	 all_run_flags => ["+ZZ_FIRST +DUP=1 +DUP=2 +DUPLICATE=3 +ABLONG +AB=5",
+			   "+${long}X=1 +${long}L=77 notplus"],
+     );
+
+ok(1);
+1;
@@ -0,0 +1,44 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t;
+
+   integer p_i;
+   reg [16*8:1] p_str;
+
+   initial begin
+      // Empty prefix matches the first plusarg
+      if ($test$plusargs("")!==1) $stop;
+      if ($value$plusargs("%s", p_str)!==1) $stop;
+      if (p_str !== "ZZ_FIRST") $stop;
+
+      // Duplicates; earlier argument wins
+      if ($value$plusargs("DUP=%d", p_i)!==1) $stop;
+      if (p_i !== 1) $stop;
+      if ($value$plusargs("DUP%s", p_str)!==1) $stop;
+      if (p_str !== "=1") $stop;
+      if ($value$plusargs("DUPL%s", p_str)!==1) $stop;
+      if (p_str !== "ICATE=3") $stop;
+      if ($value$plusargs("AB%s", p_str)!==1) $stop;
+      if (p_str !== "LONG") $stop;
+      if ($value$plusargs("AB=%d", p_i)!==1) $stop;
+      if (p_i !== 5) $stop;
+      if ($test$plusargs("DUPX")!==0) $stop;
+      if ($test$plusargs("A")!==1) $stop;
+      if ($test$plusargs("ZZ_FIRST_")!==0) $stop;
+      if ($test$plusargs("notplus")!==0) $stop;
+
+      // Prefixes longer than 256 characters
+      if ($test$plusargs("LLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLL")!==1) $stop;
+      if ($value$plusargs("LLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLL%s", p_str)!==1) $stop;
+      if (p_str !== "X=1") $stop;
+      if ($value$plusargs("LLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLL=%d", p_i)!==1) $stop;
+      if (p_i !== 77) $stop;
+      if ($test$plusargs("LLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLLL")!==0) $stop;
+
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
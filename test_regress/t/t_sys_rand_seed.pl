@@ -0,0 +1,39 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2013 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+$Self->{verilated_randReset} = 2;
+
+compile (
+    );
+
+sub run_seed {
+    my $seed = shift;
+    execute (
+	check_finished=>1,
+	all_run_flags => ["+verilator+seed+$seed"],
+	);
+    # Not file_contents, which caches the first run's log
+    my $fh = IO::File->new("<$Self->{run_log_filename}") or die "%Error: $! $Self->{run_log_filename},";
+    my $out = join("", grep { /^(Reset|Random) = / } $fh->getlines());
+    $fh->close();
+    $out ne "" or $Self->error("No random values printed\n");
+    return $out;
+}
+
+my $out5 = run_seed(5);
+my $out5b = run_seed(5);
+my $out6 = run_seed(6);
+
+$out5 eq $out5b or $Self->error("Same seed gave different values:\n$out5$out5b");
+$out5 ne $out6 or $Self->error("Different seeds gave the same values:\n$out5");
+
+ok(1);
+1;
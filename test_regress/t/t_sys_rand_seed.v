@@ -0,0 +1,17 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t;
+
+   // Randomized by Verilated::randReset(2)
+   reg [63:0] resetval;
+
+   initial begin
+      $write("Reset = %x\n", resetval);
+      $write("Random = %x %x %x %x\n", $random, $random, $random, $random);
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,36 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2003-2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License.
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include "Vt_sys_readmem_threaded.h"
+#include "verilated.h"
+
+double sc_time_stamp() { return 0; }
+
+// Compiled with VL_USER_FATAL; report the error and carry on, so the model
+// can check nothing after a $readmem file's error was loaded
+void vl_fatal(const char* filename, int linenum, const char* hier, const char* msg) {
+    if (0 && hier) {}
+    VL_PRINTF("%%Error: %s:%d: %s\n", filename, linenum, msg);
+}
+
+int main(int argc, char** argv, char** env) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::debug(1);  // For the -vltReadmem messages
+    Vt_sys_readmem_threaded* topp = new Vt_sys_readmem_threaded("top");
+    while (!Verilated::gotFinish()) topp->eval();
+    topp->final();
+    delete topp; topp=NULL;
+    return 0;
+}
@@ -0,0 +1,56 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+# Files well over the (lowered) size parsed per thread, so $readmem splits
+# them into ranges; the values must match t_sys_readmem_threaded.v
+sub value { my $i = shift; my $x = shift; return sprintf("%08x\n", (($i * 0x9e3779b9) ^ $x) & 0xffffffff); }
+{
+    # Separate @ addressed blocks, so loaded in parallel
+    my $text = "// Parallel\n\@0\n";
+    $text .= value($_, 0) foreach (0..4095);
+    $text .= "\@1800\n";
+    $text .= value($_, 0) foreach (0x1800..8191);
+    write_wholefile("$Self->{obj_dir}/t_sys_readmem_threaded_a.mem", $text);
+}
+{
+    # Later block rewrites an earlier range's addresses, so loaded serially
+    my $text = "\@0\n";
+    $text .= value($_, 0x11111111) foreach (0..5999);
+    $text .= "\@0\n";
+    $text .= value($_, 0x22222222) foreach (0..1999);
+    write_wholefile("$Self->{obj_dir}/t_sys_readmem_threaded_b.mem", $text);
+}
+{
+    # Error on line 3002; nothing after it may be loaded
+    my $text = "\@0\n";
+    $text .= value($_, 0x33333333) foreach (0..2999);
+    $text .= "zz\n";
+    $text .= value($_, 0x33333333) foreach (3000..5999);
+    write_wholefile("$Self->{obj_dir}/t_sys_readmem_threaded_c.mem", $text);
+}
+
+compile (
+	 make_top_shell => 0,
+	 make_main => 0,
+	 verilator_flags2 => ["-CFLAGS '-DVL_THREADED -DVL_DEBUG -DVL_USER_FATAL"
+			      ." -DVL_READMEM_CHUNK_BYTES=4096 -DVL_READMEM_CHUNKS_MAX=4' -LDFLAGS -pthread",
+			      "--exe $Self->{t_dir}/t_sys_readmem_threaded.cpp"],
+	 );
+
+execute (
+	 check_finished=>1,
+	 );
+
+file_grep ($Self->{run_log_filename}, qr/-vltReadmem: \S+_a\.mem loaded as 4 ranges/);
+file_grep ($Self->{run_log_filename}, qr/%Error: \S+_c\.mem:3002: \$readmem file syntax error/);
+
+ok(1);
+1;
@@ -0,0 +1,39 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2003 by Wilson Snyder.
+
+module t;
+   reg [31:0] mem [0:8191];
+   integer    i;
+   integer    errors;
+
+   function [31:0] value (input integer i, input [31:0] x);
+      value = (i * 32'h9e3779b9) ^ x;
+   endfunction
+
+   task check (input integer i, input [31:0] exp);
+      if (mem[i] !== exp) begin
+	 $write("%%Error: mem[%0d] = %x, expected %x\n", i, mem[i], exp);
+	 errors = errors + 1;
+      end
+   endtask
+
+   initial begin
+      errors = 0;
+      for (i=0; i<8192; i=i+1) mem[i] = 32'hdeadbeef;
+      $readmemh("obj_dir/t_sys_readmem_threaded/t_sys_readmem_threaded_a.mem", mem);
+      for (i=0; i<8192; i=i+1) check(i, (i<4096 || i>=32'h1800) ? value(i,0) : 32'hdeadbeef);
+
+      $readmemh("obj_dir/t_sys_readmem_threaded/t_sys_readmem_threaded_b.mem", mem);
+      for (i=0; i<6000; i=i+1) check(i, value(i, (i<2000) ? 32'h22222222 : 32'h11111111));
+
+      // Reports the error, but t_sys_readmem_threaded.cpp's vl_fatal returns
+      $readmemh("obj_dir/t_sys_readmem_threaded/t_sys_readmem_threaded_c.mem", mem);
+      for (i=0; i<6000; i=i+1) check(i, value(i, (i<3000) ? 32'h33333333 : 32'h11111111));
+
+      if (errors != 0) $stop;
+      $write("*-* All Finished *-*\n");
+      $finish;
+   end
+endmodule
@@ -0,0 +1,135 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+//
+// Copyright 2013-2013 by Wilson Snyder. This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License.
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+
+#include "Vt_vpi_time_cb.h"
+#include "verilated.h"
+
+#include "verilated_vpi.h"
+#include "verilated_vpi.cpp"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+
+// __FILE__ is too long
+#define FILENM "t_vpi_time_cb.cpp"
+
+#define CALLBACKS 1000
+#define CLK_HALF 50
+
+QData main_time = 0;
+int errors = 0;
+int fired = 0;
+int reregistered = 0;
+long last_id = -1;
+QData last_time = 0;
+vpiHandle handles[CALLBACKS];
+
+double sc_time_stamp () {
+    return main_time;
+}
+
+#define CHECK_RESULT(got, exp) \
+    if ((got) != (exp)) { \
+	VL_PRINTF("%%Error: %s:%d: GOT = %d   EXP = %d\n", \
+		  FILENM,__LINE__, (int)(got), (int)(exp)); \
+	++errors; \
+    }
+
+static QData delay_of(long id) {
+    // Scrambled, with many callbacks sharing the same time
+    return (id*7919) % 997 + 1;
+}
+
+PLI_INT32 time_cb(p_cb_data cb_data);
+
+static vpiHandle register_at(QData delay, long id) {
+    t_cb_data cb_data;
+    s_vpi_time t;
+    memset(&cb_data, 0, sizeof(cb_data));
+    t.type = vpiSimTime;
+    t.high = (PLI_UINT32)(delay>>32);
+    t.low = (PLI_UINT32)(delay);
+    cb_data.reason = cbAfterDelay;
+    cb_data.cb_rtn = time_cb;
+    cb_data.time = &t;
+    cb_data.user_data = (PLI_BYTE8*)id;
+    return vpi_register_cb(&cb_data);
+}
+
+PLI_INT32 time_cb(p_cb_data cb_data) {
+    long id = (long)cb_data->user_data;
+    ++fired;
+    if (id < 0) {  // Re-registering callback
+	CHECK_RESULT(main_time, 100*(-id));
+	if (id > -5) register_at(100, id-1);
+	++reregistered;
+	return 0;
+    }
+    CHECK_RESULT(main_time, delay_of(id));
+    // In time order, then registration order
+    if (main_time == last_time) {
+	if (id <= last_id) { VL_PRINTF("%%Error: %s:%d: out of order %ld after %ld\n", FILENM, __LINE__, id, last_id); ++errors; }
+    }
+    last_time = main_time; last_id = id;
+    // Removing a pending callback from within a callback
+    if (id == 0) vpi_remove_cb(handles[2]);
+    // Removing an already called callback is harmless
+    if (id == 3) vpi_remove_cb(handles[3]);
+    return 0;
+}
+
+int main(int argc, char **argv, char **env) {
+    Verilated::commandArgs(argc, argv);
+    Verilated::debug(0);
+
+    VM_PREFIX* topp = new VM_PREFIX ("");  // Note null name - we're flattening it out
+
+    for (long id=0; id<CALLBACKS; ++id) {
+	handles[id] = register_at(delay_of(id), id);
+    }
+    register_at(100, -1);
+    // Removing before called
+    vpi_remove_cb(handles[4]);
+    CHECK_RESULT(VerilatedVpi::cbNextDeadline(), 1);
+
+    topp->clk = 0;
+    topp->eval();
+
+    QData next_edge = CLK_HALF;
+    while (VerilatedVpi::cbNextDeadline() != ~VL_ULL(0)) {
+	// Skip idle time, stopping at clock edges and callback deadlines
+	QData deadline = VerilatedVpi::cbNextDeadline();
+	if (deadline < next_edge) {
+	    main_time = deadline;
+	} else {
+	    main_time = next_edge;
+	    next_edge += CLK_HALF;
+	    topp->clk = !topp->clk;
+	    topp->eval();
+	}
+	VerilatedVpi::callTimedCbs();
+    }
+
+    // Two removed, and five re-registering
+    CHECK_RESULT(fired, CALLBACKS - 2 + 5);
+    CHECK_RESULT(reregistered, 5);
+
+    topp->final();
+    delete topp; topp=NULL;
+    if (errors) vl_fatal(FILENM,__LINE__,"main", "%Error: Test failed");
+    VL_PRINTF("*-* All Finished *-*\n");
+    exit(0L);
+}
@@ -0,0 +1,21 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2013 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   reg [31:0] count /*verilator public_flat_rd */;
+
+   initial count = 0;
+
+   always @(posedge clk) begin
+      count <= count + 1;
+   end
+
+endmodule
@@ -49,6 +49,8 @@ unsigned int main_time = false;
 unsigned int callback_count = false;
 unsigned int callback_count_half = false;
 unsigned int callback_count_quad = false;
+unsigned int callback_count_once = false;
+vpiHandle callback_once_h = NULL;
 unsigned int callback_count_strs = false;
 unsigned int callback_count_strs_max = 500;
 
@@ -172,6 +174,13 @@ int _value_callback_quad(p_cb_data cb_data) {
     return 0;
 }
 
+int _value_callback_once(p_cb_data cb_data) {
+    // Remove itself while callValueCbs is running; its watch is then freed
+    callback_count_once++;
+    CHECK_RESULT_NZ(vpi_remove_cb(callback_once_h));
+    return 0;
+}
+
 int _mon_check_value_callbacks() {
     vpiHandle vh1 = VPI_HANDLE("count");
     CHECK_RESULT_NZ(vh1);
@@ -199,6 +208,10 @@ int _mon_check_value_callbacks() {
     vh = vpi_register_cb(&cb_data);
     CHECK_RESULT_NZ(vh);
 
+    cb_data.cb_rtn = _value_callback_once;
+    callback_once_h = vpi_register_cb(&cb_data);
+    CHECK_RESULT_NZ(callback_once_h);
+
     vh1 = VPI_HANDLE("quads");
     CHECK_RESULT_NZ(vh1);
 
@@ -685,6 +698,7 @@ int main(int argc, char **argv, char **env) {
     CHECK_RESULT(callback_count, 501);
     CHECK_RESULT(callback_count_half, 250);
     CHECK_RESULT(callback_count_quad, 2);
+    CHECK_RESULT(callback_count_once, 1);
     CHECK_RESULT(callback_count_strs, callback_count_strs_max);
     if (!Verilated::gotFinish()) {
 	vl_fatal(FILENM,__LINE__,"main", "%Error: Timeout; never got a $finish");